@@ -17,6 +17,7 @@
 
 #include "Defaults.hpp"
 #include "FixedArray.hpp"
+#include "HeapProfiler.hpp"
 
 namespace kstd {
     /**
@@ -39,19 +40,35 @@ namespace kstd {
         ~Allocator() noexcept = default;
 
         [[nodiscard]] auto allocate(const usize count) noexcept -> T* {
-            return static_cast<T*>(::mi_malloc_aligned(size * count, alignment));
+            auto* memory = static_cast<T*>(::mi_malloc_aligned(size * count, alignment));
+            profiler::heap::on_allocate(memory, size * count);
+            return memory;
         }
 
         [[nodiscard]] auto reallocate(T* value, [[maybe_unused]] const usize old_count, const usize count) noexcept -> T* {
-            return static_cast<T*>(::mi_realloc_aligned(value, size * count, alignment));
+            // The old block has to leave the side table before another thread can get its address back
+            profiler::heap::on_free(value);
+            auto* memory = static_cast<T*>(::mi_realloc_aligned(value, size * count, alignment));
+            profiler::heap::on_allocate(memory, size * count);
+            return memory;
         }
 
         auto free(T* memory) noexcept -> void {
             if(memory == nullptr) {
                 return;
             }
+            profiler::heap::on_free(memory);
             ::mi_free(memory);
         }
+
+        /**
+         * @param memory A block previously returned by allocate or reallocate.
+         * @return The number of elements which actually fit into the given block,
+         * which may be more than were requested.
+         */
+        [[nodiscard]] auto get_usable_size(T* memory) const noexcept -> usize {
+            return ::mi_usable_size(memory) / size;
+        }
     };
 
     namespace concepts {
@@ -62,6 +79,8 @@ namespace kstd {
          *	- A().reallocate(A::value_type*, usize, usize)  : A function for reallocating memory blocks and leaving them uninitialized
          *	- A().free(A::value_type*)					    : A function for deallocating objects
          * When the type specified in the allocator is void, the size of each element shall be 1 and it should have the default alignment.
+         * Optionally, A().get_usable_size(A::value_type*) may report how many elements really fit into a block,
+         * which growable containers use to claim allocator slack.
          */
         template<typename T, typename TValueType>
         concept Allocator = requires(T value, usize size) {
@@ -27,6 +27,7 @@ namespace kstd {
         using iterator = T*;
         using const_iterator = const T*;
         using slice_type = Slice<T>;
+        using mut_slice_type = SliceMut<T>;
 
     private:
         using self_type = Array<T, TAllocator>;
@@ -47,8 +48,9 @@ namespace kstd {
             // Re-allocate the memory
             auto* new_data = _allocator.allocate(count);
             // Move-reconstruct the old elements
-            for(usize i = 0; i < _size; ++i) {
+            for(usize i = 0; i < retained_count; ++i) {
                 new(&new_data[i]) T(kstd::move(_data[i]));
+                _data[i].~T();
             }
             _allocator.free(_data);// Free old data
             _data = new_data;      // Swap data pointers
@@ -64,12 +66,14 @@ namespace kstd {
         }
 
     public:
+        /**
+         * Creates an empty array without allocating, memory is only acquired by the first insertion.
+         */
         Array() noexcept
             : _allocator()
             , _size(0)
-            , _capacity(1)
-            , _data(_allocator.allocate(_capacity)) {
-            new(_data) T();
+            , _capacity(0)
+            , _data(nullptr) {
         }
 
         Array(const usize size, const T& default_value = {}) noexcept
@@ -86,8 +90,10 @@ namespace kstd {
             : _allocator()
             , _size(other._size)
             , _capacity(other._capacity)
-            , _data(_allocator.allocate(_capacity)) {
-            memcpy(_data, other._data, _size * sizeof(T));
+            , _data(_capacity == 0 ? nullptr : _allocator.allocate(_capacity)) {
+            for(usize i = 0; i < _size; ++i) {
+                new(&_data[i]) T(other._data[i]);
+            }
         }
 
         Array(self_type&& other) noexcept
@@ -96,6 +102,8 @@ namespace kstd {
             , _capacity(other._capacity)
             , _data(other._data) {
             other._data = nullptr;
+            other._size = 0;
+            other._capacity = 0;
         }
 
         Array(const slice_type& slice) noexcept
@@ -119,22 +127,43 @@ namespace kstd {
             return {_data, _size};
         }
 
+        [[nodiscard]] operator mut_slice_type() noexcept {
+            return {_data, _size};
+        }
+
         auto operator=(const self_type& other) noexcept -> self_type& {
             if(&other == this) {
                 return *this;
             }
-            const auto size = other._size;
-            resize(size);
-            memcpy(_data, other._data, size * sizeof(T));
+            for(usize i = 0; i < _size; ++i) {
+                _data[i].~T();
+            }
+            _size = 0;
+            reserve(other._size);
+            for(usize i = 0; i < other._size; ++i) {
+                new(&_data[i]) T(other._data[i]);
+            }
+            _size = other._size;
             return *this;
         }
 
         auto operator=(self_type&& other) noexcept -> self_type& {
+            if(&other == this) {
+                return *this;
+            }
+            if(_data != nullptr) {
+                for(usize i = 0; i < _size; ++i) {
+                    _data[i].~T();
+                }
+                _allocator.free(_data);
+            }
             _allocator = move(other._allocator);
             _data = other._data;
             _size = other._size;
             _capacity = other._capacity;
             other._data = nullptr;
+            other._size = 0;
+            other._capacity = 0;
             return *this;
         }
 
@@ -185,6 +214,14 @@ namespace kstd {
             return _data + _size;
         }
 
+        [[nodiscard]] auto begin() const noexcept -> const_iterator {
+            return _data;
+        }
+
+        [[nodiscard]] auto end() const noexcept -> const_iterator {
+            return _data + _size;
+        }
+
         [[nodiscard]] auto cbegin() const noexcept -> const_iterator {
             return _data;
         }
@@ -194,11 +231,31 @@ namespace kstd {
         }
 
         auto resize(const usize size) noexcept -> void {
-            resize_internal(size);
-            // Default init new elements
-            const auto num_new_elements = size - _capacity;
-            for(usize i = 0; i < num_new_elements; ++i) {
-                new(&_data[_capacity + i]) T();// Default initialize newly added elements
+            // Only reallocate when growing past the capacity, shrinking keeps the memory for later
+            if(size > _capacity) {
+                resize_internal(size);
+            }
+            for(usize i = size; i < _size; ++i) {
+                _data[i].~T();
+            }
+            for(usize i = _size; i < size; ++i) {
+                new(&_data[i]) T();// Default initialize newly added elements
+            }
+            _size = size;
+        }
+
+        /**
+         * Resizes the array without constructing the newly added elements,
+         * which hold indeterminate values until they are written.
+         */
+        auto resize_uninitialized(const usize size) noexcept -> void
+            requires(is_trivially_default_constructible<T>)
+        {
+            if(size > _capacity) {
+                resize_internal(size);
+            }
+            for(usize i = size; i < _size; ++i) {
+                _data[i].~T();
             }
             _size = size;
         }
@@ -210,14 +267,25 @@ namespace kstd {
             resize_internal(size);
         }
 
+        /**
+         * Reserves room for at least the given number of elements, at least doubling the
+         * capacity when it has to grow, so repeated appends only reallocate logarithmically often.
+         */
+        auto reserve_amortized(const usize size) noexcept -> void {
+            if(size <= _capacity) {
+                return;
+            }
+            resize_internal(max(size, _capacity * 2));
+        }
+
         auto push_back(const T& value) noexcept -> void {
             reserve(_size + 1);
-            _data[_size++] = value;
+            new(&_data[_size++]) T(value);
         }
 
         auto push_back(T&& value) noexcept -> void {
             reserve(_size + 1);
-            _data[_size++] = forward<T>(value);
+            new(&_data[_size++]) T(forward<T>(value));
         }
 
         template<concepts::AssignableAs<T>... TArgs>
@@ -233,6 +301,16 @@ namespace kstd {
             _data[_size--].~T();
         }
 
+        /**
+         * Destroys all elements while keeping the allocated capacity.
+         */
+        auto clear() noexcept -> void {
+            for(usize i = 0; i < _size; ++i) {
+                _data[i].~T();
+            }
+            _size = 0;
+        }
+
         auto erase(iterator iter) noexcept -> void {
         }
 
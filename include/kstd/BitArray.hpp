@@ -0,0 +1,300 @@
+// Copyright 2024 Karma Krafts & associates
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "Allocator.hpp"
+#include "Bits.hpp"
+#include "Panic.hpp"
+#include "Slice.hpp"
+#include "System.hpp"
+#include "Types.hpp"
+#include "Utility.hpp"
+
+namespace kstd {
+    /**
+     * A dynamically sized set of bits, packed into 64-bit words.
+     * Bits past the current size are always kept zero, so word-wise
+     * operations never have to mask the last word.
+     *
+     * @tparam TAllocator The allocator used for the word storage.
+     */
+    template<concepts::Allocator<u64> TAllocator = Allocator<u64>>
+    struct BasicBitArray final {
+        using allocator_type = TAllocator;
+        using word_type = u64;
+        using slice_type = Slice<word_type>;
+
+    private:
+        using self_type = BasicBitArray<TAllocator>;
+
+        TAllocator _allocator;
+        usize _size;
+        usize _capacity;
+        word_type* _data;
+
+        [[nodiscard]] auto get_word_count() const noexcept -> usize {
+            return bits::get_word_count(_size);
+        }
+
+        auto reallocate_internal(const usize word_capacity) noexcept -> void {
+            _data = _allocator.reallocate(_data, _capacity, word_capacity);
+            _capacity = word_capacity;
+        }
+
+        auto clear_tail() noexcept -> void {
+            if(_size == 0) {
+                return;
+            }
+            _data[get_word_count() - 1] &= bits::get_tail_mask(_size);
+        }
+
+        template<typename TOp>
+        auto apply(const self_type& other) noexcept -> void {
+            if(other._size != _size) {
+                panic("Bit array size mismatch");
+            }
+            bits::apply_words<TOp>(_data, other._data, get_word_count());
+        }
+
+    public:
+        BasicBitArray() noexcept
+            : _allocator()
+            , _size(0)
+            , _capacity(0)
+            , _data(nullptr) {
+        }
+
+        explicit BasicBitArray(const usize size, const bool value = false) noexcept
+            : _allocator()
+            , _size(size)
+            , _capacity(bits::get_word_count(size))
+            , _data(_allocator.allocate(_capacity)) {
+            memset(_data, value ? 0xFF : 0x00, _capacity * sizeof(word_type));
+            clear_tail();
+        }
+
+        BasicBitArray(const self_type& other) noexcept
+            : _allocator()
+            , _size(other._size)
+            , _capacity(other.get_word_count())
+            , _data(_allocator.allocate(_capacity)) {
+            memcpy(_data, other._data, _capacity * sizeof(word_type));
+        }
+
+        BasicBitArray(self_type&& other) noexcept
+            : _allocator(move(other._allocator))
+            , _size(other._size)
+            , _capacity(other._capacity)
+            , _data(other._data) {
+            other._size = 0;
+            other._capacity = 0;
+            other._data = nullptr;
+        }
+
+        ~BasicBitArray() noexcept {
+            _allocator.free(_data);
+        }
+
+        auto operator=(const self_type& other) noexcept -> self_type& {
+            if(&other == this) {
+                return *this;
+            }
+            const auto word_count = other.get_word_count();
+            if(word_count > _capacity) {
+                reallocate_internal(word_count);
+            }
+            memcpy(_data, other._data, word_count * sizeof(word_type));
+            _size = other._size;
+            return *this;
+        }
+
+        auto operator=(self_type&& other) noexcept -> self_type& {
+            if(&other == this) {
+                return *this;
+            }
+            _allocator.free(_data);
+            _allocator = move(other._allocator);
+            _size = other._size;
+            _capacity = other._capacity;
+            _data = other._data;
+            other._size = 0;
+            other._capacity = 0;
+            other._data = nullptr;
+            return *this;
+        }
+
+        [[nodiscard]] operator slice_type() const noexcept {
+            return {_data, get_word_count()};
+        }
+
+        [[nodiscard]] auto size() const noexcept -> usize {
+            return _size;
+        }
+
+        [[nodiscard]] auto data() noexcept -> word_type* {
+            return _data;
+        }
+
+        [[nodiscard]] auto data() const noexcept -> const word_type* {
+            return _data;
+        }
+
+        auto reserve(const usize size) noexcept -> void {
+            const auto word_count = bits::get_word_count(size);
+            if(word_count <= _capacity) {
+                return;
+            }
+            reallocate_internal(word_count);
+        }
+
+        auto resize(const usize size, const bool value = false) noexcept -> void {
+            const auto old_size = _size;
+            const auto old_word_count = get_word_count();
+            reserve(size);
+            const auto word_count = bits::get_word_count(size);
+            if(size > old_size) {
+                if(value && old_size % bits::word_bits != 0) {
+                    _data[old_word_count - 1] |= ~bits::get_tail_mask(old_size);
+                }
+                memset(_data + old_word_count, value ? 0xFF : 0x00, (word_count - old_word_count) * sizeof(word_type));
+            }
+            _size = size;
+            clear_tail();
+        }
+
+        auto push_back(const bool value) noexcept -> void {
+            if(_size == _capacity * bits::word_bits) {
+                reallocate_internal(max<usize>(_capacity << 1, 1));
+            }
+            const auto index = _size++;
+            if(index % bits::word_bits == 0) {
+                _data[index / bits::word_bits] = 0;
+            }
+            set(index, value);
+        }
+
+        auto set(const usize index) noexcept -> void {
+            _data[index / bits::word_bits] |= word_type {1} << (index % bits::word_bits);
+        }
+
+        auto set(const usize index, const bool value) noexcept -> void {
+            const auto mask = word_type {1} << (index % bits::word_bits);
+            auto& word = _data[index / bits::word_bits];
+            word = (word & ~mask) | (-static_cast<word_type>(value) & mask);
+        }
+
+        auto reset(const usize index) noexcept -> void {
+            _data[index / bits::word_bits] &= ~(word_type {1} << (index % bits::word_bits));
+        }
+
+        auto flip(const usize index) noexcept -> void {
+            _data[index / bits::word_bits] ^= word_type {1} << (index % bits::word_bits);
+        }
+
+        [[nodiscard]] auto test(const usize index) const noexcept -> bool {
+            return ((_data[index / bits::word_bits] >> (index % bits::word_bits)) & 1) != 0;
+        }
+
+        [[nodiscard]] auto at(const usize index) const noexcept -> bool {
+            if(index >= _size) {
+                panic("Bit array index out of bounds");
+            }
+            return test(index);
+        }
+
+        [[nodiscard]] auto operator[](const usize index) const noexcept -> bool {
+            return test(index);
+        }
+
+        auto set_all() noexcept -> void {
+            memset(_data, 0xFF, get_word_count() * sizeof(word_type));
+            clear_tail();
+        }
+
+        auto reset_all() noexcept -> void {
+            memset(_data, 0x00, get_word_count() * sizeof(word_type));
+        }
+
+        auto flip_all() noexcept -> void {
+            const auto word_count = get_word_count();
+            for(usize i = 0; i < word_count; ++i) {
+                _data[i] = ~_data[i];
+            }
+            clear_tail();
+        }
+
+        [[nodiscard]] auto count() const noexcept -> usize {
+            return bits::count_ones(_data, get_word_count());
+        }
+
+        [[nodiscard]] auto any() const noexcept -> bool {
+            return find_first_set() != _size;
+        }
+
+        [[nodiscard]] auto none() const noexcept -> bool {
+            return !any();
+        }
+
+        /**
+         * @return The index of the first set bit, or size() if no bit is set.
+         */
+        [[nodiscard]] auto find_first_set() const noexcept -> usize {
+            return find_next_set(0);
+        }
+
+        /**
+         * @param index The index of the first bit to consider.
+         * @return The index of the first set bit at or after index, or size() if there is none.
+         */
+        [[nodiscard]] auto find_next_set(const usize index) const noexcept -> usize {
+            return min(bits::find_next_set(_data, get_word_count(), index), _size);
+        }
+
+        [[nodiscard]] auto get_set_bits() const noexcept -> bits::SetBitRange {
+            return {_data, get_word_count()};
+        }
+
+        auto operator&=(const self_type& other) noexcept -> self_type& {
+            apply<bits::AndOp>(other);
+            return *this;
+        }
+
+        auto operator|=(const self_type& other) noexcept -> self_type& {
+            apply<bits::OrOp>(other);
+            return *this;
+        }
+
+        auto operator^=(const self_type& other) noexcept -> self_type& {
+            apply<bits::XorOp>(other);
+            return *this;
+        }
+
+        auto and_not(const self_type& other) noexcept -> self_type& {
+            apply<bits::AndNotOp>(other);
+            return *this;
+        }
+
+        [[nodiscard]] auto operator==(const self_type& other) const noexcept -> bool {
+            if(&other == this) {
+                return true;
+            }
+            if(other._size != _size) {
+                return false;
+            }
+            return memcmp(_data, other._data, get_word_count() * sizeof(word_type)) == 0;
+        }
+    };
+
+    using BitArray = BasicBitArray<>;
+}// namespace kstd
\ No newline at end of file
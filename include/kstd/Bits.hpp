@@ -0,0 +1,266 @@
+// Copyright 2024 Karma Krafts & associates
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+// NOLINTBEGIN
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+#ifdef KSTD_COMPILER_MSVC
+#include <intrin.h>
+#endif
+// NOLINTEND
+
+#include "Concepts.hpp"
+#include "Defaults.hpp"
+#include "Types.hpp"
+
+namespace kstd::bits {
+    static constexpr usize word_bits = sizeof(u64) << 3;
+
+    [[nodiscard]] constexpr auto get_word_count(const usize num_bits) noexcept -> usize {
+        return (num_bits + word_bits - 1) / word_bits;
+    }
+
+    [[nodiscard]] constexpr auto get_tail_mask(const usize num_bits) noexcept -> u64 {
+        const auto remainder = num_bits % word_bits;
+        return remainder == 0 ? ~u64 {0} : (u64 {1} << remainder) - 1;
+    }
+
+    template<concepts::Unsigned T>
+    [[nodiscard]] constexpr auto count_ones(const T value) noexcept -> usize {
+#ifdef KSTD_COMPILER_MSVC
+        return static_cast<usize>(__popcnt64(static_cast<u64>(value)));
+#else
+        return static_cast<usize>(__builtin_popcountll(static_cast<unsigned long long>(value)));
+#endif
+    }
+
+    /**
+     * @param value The value to scan, must not be zero.
+     * @return The number of trailing zero bits in the given value.
+     */
+    template<concepts::Unsigned T>
+    [[nodiscard]] constexpr auto count_trailing_zeros(const T value) noexcept -> usize {
+#ifdef KSTD_COMPILER_MSVC
+        unsigned long index;
+        _BitScanForward64(&index, static_cast<u64>(value));
+        return static_cast<usize>(index);
+#else
+        return static_cast<usize>(__builtin_ctzll(static_cast<unsigned long long>(value)));
+#endif
+    }
+
+    /**
+     * @param value The value to scan, must not be zero.
+     * @return The number of leading zero bits in the given value, relative to the width of T.
+     */
+    template<concepts::Unsigned T>
+    [[nodiscard]] constexpr auto count_leading_zeros(const T value) noexcept -> usize {
+        constexpr usize padding = (sizeof(u64) - sizeof(T)) << 3;
+#ifdef KSTD_COMPILER_MSVC
+        unsigned long index;
+        _BitScanReverse64(&index, static_cast<u64>(value));
+        return static_cast<usize>(63 - index) - padding;
+#else
+        return static_cast<usize>(__builtin_clzll(static_cast<unsigned long long>(value))) - padding;
+#endif
+    }
+
+    // Word-wise bulk operations, vectorized where the target supports it
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64)
+#define KSTD_BITS_VECTORIZED
+#endif
+
+#if defined(__AVX2__)
+    using vector_type = __m256i;
+
+    [[nodiscard]] inline auto load_vector(const u64* address) noexcept -> vector_type {
+        return _mm256_loadu_si256(reinterpret_cast<const vector_type*>(address));
+    }
+
+    inline auto store_vector(u64* address, const vector_type value) noexcept -> void {
+        _mm256_storeu_si256(reinterpret_cast<vector_type*>(address), value);
+    }
+#elif defined(KSTD_BITS_VECTORIZED)
+    using vector_type = __m128i;
+
+    [[nodiscard]] inline auto load_vector(const u64* address) noexcept -> vector_type {
+        return _mm_loadu_si128(reinterpret_cast<const vector_type*>(address));
+    }
+
+    inline auto store_vector(u64* address, const vector_type value) noexcept -> void {
+        _mm_storeu_si128(reinterpret_cast<vector_type*>(address), value);
+    }
+#endif
+
+    struct AndOp final {
+#if defined(__AVX2__)
+        [[nodiscard]] static auto apply(const vector_type lhs, const vector_type rhs) noexcept -> vector_type {
+            return _mm256_and_si256(lhs, rhs);
+        }
+#elif defined(KSTD_BITS_VECTORIZED)
+        [[nodiscard]] static auto apply(const vector_type lhs, const vector_type rhs) noexcept -> vector_type {
+            return _mm_and_si128(lhs, rhs);
+        }
+#endif
+        [[nodiscard]] static constexpr auto apply(const u64 lhs, const u64 rhs) noexcept -> u64 {
+            return lhs & rhs;
+        }
+    };
+
+    struct OrOp final {
+#if defined(__AVX2__)
+        [[nodiscard]] static auto apply(const vector_type lhs, const vector_type rhs) noexcept -> vector_type {
+            return _mm256_or_si256(lhs, rhs);
+        }
+#elif defined(KSTD_BITS_VECTORIZED)
+        [[nodiscard]] static auto apply(const vector_type lhs, const vector_type rhs) noexcept -> vector_type {
+            return _mm_or_si128(lhs, rhs);
+        }
+#endif
+        [[nodiscard]] static constexpr auto apply(const u64 lhs, const u64 rhs) noexcept -> u64 {
+            return lhs | rhs;
+        }
+    };
+
+    struct XorOp final {
+#if defined(__AVX2__)
+        [[nodiscard]] static auto apply(const vector_type lhs, const vector_type rhs) noexcept -> vector_type {
+            return _mm256_xor_si256(lhs, rhs);
+        }
+#elif defined(KSTD_BITS_VECTORIZED)
+        [[nodiscard]] static auto apply(const vector_type lhs, const vector_type rhs) noexcept -> vector_type {
+            return _mm_xor_si128(lhs, rhs);
+        }
+#endif
+        [[nodiscard]] static constexpr auto apply(const u64 lhs, const u64 rhs) noexcept -> u64 {
+            return lhs ^ rhs;
+        }
+    };
+
+    struct AndNotOp final {
+#if defined(__AVX2__)
+        [[nodiscard]] static auto apply(const vector_type lhs, const vector_type rhs) noexcept -> vector_type {
+            return _mm256_andnot_si256(rhs, lhs);// Computes ~rhs & lhs
+        }
+#elif defined(KSTD_BITS_VECTORIZED)
+        [[nodiscard]] static auto apply(const vector_type lhs, const vector_type rhs) noexcept -> vector_type {
+            return _mm_andnot_si128(rhs, lhs);// Computes ~rhs & lhs
+        }
+#endif
+        [[nodiscard]] static constexpr auto apply(const u64 lhs, const u64 rhs) noexcept -> u64 {
+            return lhs & ~rhs;
+        }
+    };
+
+    /**
+     * Combines every word of dst with the word of src at the same index. Both may be the same
+     * array, as in a &= a, since every word is read before the word at its index is written.
+     */
+    template<typename TOp>
+    auto apply_words(u64* dst, const u64* src, const usize count) noexcept -> void {
+        usize index = 0;
+#ifdef KSTD_BITS_VECTORIZED
+        constexpr usize lanes = sizeof(vector_type) / sizeof(u64);
+        for(; index + lanes <= count; index += lanes) {
+            store_vector(dst + index, TOp::apply(load_vector(dst + index), load_vector(src + index)));
+        }
+#endif
+        for(; index < count; ++index) {
+            dst[index] = TOp::apply(dst[index], src[index]);
+        }
+    }
+
+    [[nodiscard]] inline auto count_ones(const u64* words, const usize count) noexcept -> usize {
+        usize result = 0;
+        for(usize i = 0; i < count; ++i) {
+            result += count_ones(words[i]);
+        }
+        return result;
+    }
+
+    /**
+     * @param words The words to search in.
+     * @param count The number of words to search in.
+     * @param start The index of the first bit to consider.
+     * @return The index of the first set bit at or after start, or count * word_bits if there is none.
+     */
+    [[nodiscard]] inline auto find_next_set(const u64* words, const usize count, const usize start) noexcept -> usize {
+        auto word_index = start / word_bits;
+        if(word_index >= count) {
+            return count * word_bits;
+        }
+        // Mask off all bits below the start index in the first word
+        auto word = words[word_index] & (~u64 {0} << (start % word_bits));
+        while(word == 0) {
+            if(++word_index == count) {
+                return count * word_bits;
+            }
+            word = words[word_index];
+        }
+        return word_index * word_bits + count_trailing_zeros(word);
+    }
+
+    class SetBitIterator final {
+        const u64* _words;
+        usize _count;
+        usize _index;
+
+    public:
+        SetBitIterator(const u64* words, const usize count, const usize index) noexcept
+            : _words(words)
+            , _count(count)
+            , _index(index) {
+        }
+
+        KSTD_DEFAULT_MOVE_COPY(SetBitIterator, SetBitIterator)
+        ~SetBitIterator() noexcept = default;
+
+        [[nodiscard]] auto operator==(const SetBitIterator& other) const noexcept -> bool {
+            return _index == other._index;
+        }
+
+        auto operator++() noexcept -> SetBitIterator& {
+            _index = find_next_set(_words, _count, _index + 1);
+            return *this;
+        }
+
+        [[nodiscard]] auto operator*() const noexcept -> usize {
+            return _index;
+        }
+    };
+
+    class SetBitRange final {
+        const u64* _words;
+        usize _count;
+
+    public:
+        SetBitRange(const u64* words, const usize count) noexcept
+            : _words(words)
+            , _count(count) {
+        }
+
+        KSTD_DEFAULT_MOVE_COPY(SetBitRange, SetBitRange)
+        ~SetBitRange() noexcept = default;
+
+        [[nodiscard]] auto begin() const noexcept -> SetBitIterator {
+            return {_words, _count, find_next_set(_words, _count, 0)};
+        }
+
+        [[nodiscard]] auto end() const noexcept -> SetBitIterator {
+            return {_words, _count, _count * word_bits};
+        }
+    };
+}// namespace kstd::bits
\ No newline at end of file
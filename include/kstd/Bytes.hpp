@@ -0,0 +1,527 @@
+// Copyright 2024 Karma Krafts & associates
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include "Allocator.hpp"
+#include "Atomic.hpp"
+#include "Concepts.hpp"
+#include "Defaults.hpp"
+#include "Math.hpp"
+#include "Panic.hpp"
+#include "Slice.hpp"
+#include "StringView.hpp"
+#include "System.hpp"
+#include "Types.hpp"
+#include "Utility.hpp"
+
+namespace kstd {
+    template<concepts::Allocator<u8> TAllocator>
+    struct BasicBytesMut;
+
+    namespace bytes {
+        /**
+         * Placed in front of the payload of every shared byte buffer.
+         * The allocator lives here so a buffer can be freed by whichever owner releases it last.
+         * Byte allocators only guarantee byte alignment, so every allocation reserves room to
+         * align the header, which remembers how far it was moved into the allocation.
+         */
+        template<typename TAllocator>
+        struct Header final {
+            Atomic<usize> ref_count;
+            usize capacity;
+            u8 offset;
+            KSTD_NO_UNIQUE_ADDRESS TAllocator allocator;
+
+            [[nodiscard]] auto get_data() noexcept -> u8* {
+                return reinterpret_cast<u8*>(this + 1);
+            }
+
+            [[nodiscard]] auto get_memory() noexcept -> u8* {
+                return reinterpret_cast<u8*>(this) - offset;
+            }
+        };
+
+        template<typename TAllocator>
+        [[nodiscard]] constexpr auto get_allocation_size(const usize capacity) noexcept -> usize {
+            return sizeof(Header<TAllocator>) + alignof(Header<TAllocator>) - 1 + capacity;
+        }
+
+        template<typename TAllocator>
+        [[nodiscard]] auto get_header_offset(const u8* memory) noexcept -> u8 {
+            constexpr auto alignment = alignof(Header<TAllocator>);
+            return static_cast<u8>((alignment - (reinterpret_cast<usize>(memory) & (alignment - 1))) & (alignment - 1));
+        }
+
+        template<typename TAllocator>
+        [[nodiscard]] auto allocate(TAllocator allocator, const usize capacity) noexcept -> Header<TAllocator>* {
+            auto* memory = allocator.allocate(get_allocation_size<TAllocator>(capacity));
+            if(memory == nullptr) {
+                panic("Could not allocate byte buffer");
+            }
+            const auto offset = get_header_offset<TAllocator>(memory);
+            return new(memory + offset) Header<TAllocator> {1, capacity, offset, move(allocator)};
+        }
+
+        /**
+         * Grows an unshared buffer, keeping its header and the first size bytes of its payload.
+         */
+        template<typename TAllocator>
+        [[nodiscard]] auto reallocate(TAllocator& allocator, Header<TAllocator>* header, const usize capacity, const usize size) noexcept
+            -> Header<TAllocator>* {
+            const auto old_offset = header->offset;
+            auto* memory = allocator.reallocate(header->get_memory(), get_allocation_size<TAllocator>(header->capacity),
+                                                get_allocation_size<TAllocator>(capacity));
+            if(memory == nullptr) {
+                panic("Could not reallocate byte buffer");
+            }
+            // The header is trivially relocatable, so it can move if the new allocation is aligned differently
+            const auto offset = get_header_offset<TAllocator>(memory);
+            if(offset != old_offset) {
+                memmove(memory + offset, memory + old_offset, sizeof(Header<TAllocator>) + size);
+            }
+            header = reinterpret_cast<Header<TAllocator>*>(memory + offset);
+            header->offset = offset;
+            header->capacity = capacity;
+            return header;
+        }
+
+        template<typename TAllocator>
+        auto free(Header<TAllocator>* header) noexcept -> void {
+            auto allocator = move(header->allocator);
+            auto* memory = header->get_memory();
+            header->~Header();
+            allocator.free(memory);
+        }
+    }// namespace bytes
+
+    /**
+     * An immutable, atomically reference counted byte buffer. Copies and sub-slices
+     * share the underlying allocation, so one payload can be handed to any number of
+     * consumers, even on other threads, without copying it.
+     *
+     * @tparam TAllocator The allocator used for the backing store.
+     */
+    template<concepts::Allocator<u8> TAllocator = Allocator<u8>>
+    struct BasicBytes final {
+        using value_type = u8;
+        using allocator_type = TAllocator;
+        using const_iterator = const u8*;
+        using slice_type = Slice<u8>;
+
+    private:
+        using self_type = BasicBytes<TAllocator>;
+        using header_type = bytes::Header<TAllocator>;
+
+        friend struct BasicBytesMut<TAllocator>;
+
+        header_type* _header;// Null for empty and static buffers
+        const u8* _data;
+        usize _size;
+
+        BasicBytes(header_type* header, const u8* data, const usize size) noexcept
+            : _header(header)
+            , _data(data)
+            , _size(size) {
+        }
+
+        auto acquire() const noexcept -> void {
+            if(_header != nullptr) {
+                _header->ref_count.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        auto release() noexcept -> void {
+            if(_header != nullptr && _header->ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                bytes::free(_header);
+            }
+            _header = nullptr;
+        }
+
+    public:
+        BasicBytes() noexcept
+            : _header(nullptr)
+            , _data(nullptr)
+            , _size(0) {
+        }
+
+        BasicBytes(const self_type& other) noexcept
+            : _header(other._header)
+            , _data(other._data)
+            , _size(other._size) {
+            acquire();
+        }
+
+        BasicBytes(self_type&& other) noexcept
+            : _header(other._header)
+            , _data(other._data)
+            , _size(other._size) {
+            other._header = nullptr;
+            other._data = nullptr;
+            other._size = 0;
+        }
+
+        ~BasicBytes() noexcept {
+            release();
+        }
+
+        auto operator=(const self_type& other) noexcept -> self_type& {
+            if(this == &other) {
+                return *this;
+            }
+            other.acquire();
+            release();
+            _header = other._header;
+            _data = other._data;
+            _size = other._size;
+            return *this;
+        }
+
+        auto operator=(self_type&& other) noexcept -> self_type& {
+            if(this == &other) {
+                return *this;
+            }
+            release();
+            _header = other._header;
+            _data = other._data;
+            _size = other._size;
+            other._header = nullptr;
+            other._data = nullptr;
+            other._size = 0;
+            return *this;
+        }
+
+        /**
+         * Copies the given bytes into a new shared buffer.
+         */
+        [[nodiscard]] static auto copy_from(const u8* data, const usize size, TAllocator allocator = {}) noexcept -> self_type {
+            if(size == 0) {
+                return {};
+            }
+            auto* header = bytes::allocate(move(allocator), size);
+            memcpy(header->get_data(), data, size);
+            return {header, header->get_data(), size};
+        }
+
+        [[nodiscard]] static auto copy_from(const slice_type& slice, TAllocator allocator = {}) noexcept -> self_type {
+            return copy_from(slice.data(), slice.size(), move(allocator));
+        }
+
+        [[nodiscard]] static auto copy_from(const StringView& view, TAllocator allocator = {}) noexcept -> self_type {
+            return copy_from(reinterpret_cast<const u8*>(view.data()), view.length(), move(allocator));
+        }
+
+        /**
+         * Wraps memory which outlives every copy of the result, like a string literal.
+         * Nothing is allocated or reference counted.
+         */
+        [[nodiscard]] static auto from_static(const u8* data, const usize size) noexcept -> self_type {
+            return {nullptr, data, size};
+        }
+
+        [[nodiscard]] static auto from_static(const StringView& view) noexcept -> self_type {
+            return {nullptr, reinterpret_cast<const u8*>(view.data()), view.length()};
+        }
+
+        /**
+         * @param start The index of the first byte of the sub-range.
+         * @param end The index after the last byte of the sub-range.
+         * @return A view over the given sub-range which shares the allocation of this buffer.
+         */
+        [[nodiscard]] auto slice(const usize start, const usize end) const noexcept -> self_type {
+            if(start > end || end > _size) {
+                panic("Bytes slice out of bounds");
+            }
+            if(start == end) {
+                return {};
+            }
+            acquire();
+            return {_header, _data + start, end - start};
+        }
+
+        [[nodiscard]] auto slice(const usize start) const noexcept -> self_type {
+            return slice(start, _size);
+        }
+
+        [[nodiscard]] auto data() const noexcept -> const u8* {
+            return _data;
+        }
+
+        [[nodiscard]] auto size() const noexcept -> usize {
+            return _size;
+        }
+
+        [[nodiscard]] auto is_empty() const noexcept -> bool {
+            return _size == 0;
+        }
+
+        [[nodiscard]] auto begin() const noexcept -> const_iterator {
+            return _data;
+        }
+
+        [[nodiscard]] auto end() const noexcept -> const_iterator {
+            return _data + _size;
+        }
+
+        [[nodiscard]] auto operator[](const usize index) const noexcept -> u8 {
+            return _data[index];
+        }
+
+        [[nodiscard]] auto at(const usize index) const noexcept -> u8 {
+            if(index >= _size) {
+                panic("Bytes index out of bounds");
+            }
+            return _data[index];
+        }
+
+        /**
+         * @return The number of buffers sharing the allocation, or 0 for empty and static buffers.
+         */
+        [[nodiscard]] auto get_ref_count() const noexcept -> usize {
+            return _header == nullptr ? 0 : _header->ref_count.load(std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] auto as_slice() const noexcept -> slice_type {
+            return {_data, _size};
+        }
+
+        [[nodiscard]] auto as_string_view() const noexcept -> StringView {
+            return {reinterpret_cast<const char*>(_data), _size};
+        }
+
+        [[nodiscard]] operator slice_type() const noexcept {
+            return as_slice();
+        }
+
+        [[nodiscard]] auto operator==(const self_type& other) const noexcept -> bool {
+            if(_size != other._size) {
+                return false;
+            }
+            return _data == other._data || _size == 0 || memcmp(_data, other._data, _size) == 0;
+        }
+
+        [[nodiscard]] auto operator!=(const self_type& other) const noexcept -> bool {
+            return !(*this == other);
+        }
+    };
+
+    /**
+     * A uniquely owned, growable byte buffer for assembling a payload which is then
+     * frozen into an immutable Bytes instance without copying.
+     *
+     * @tparam TAllocator The allocator used for the backing store.
+     */
+    template<concepts::Allocator<u8> TAllocator = Allocator<u8>>
+    struct BasicBytesMut final {
+        using value_type = u8;
+        using allocator_type = TAllocator;
+        using iterator = u8*;
+        using const_iterator = const u8*;
+        using frozen_type = BasicBytes<TAllocator>;
+
+        static constexpr usize min_capacity = 64;
+
+    private:
+        using self_type = BasicBytesMut<TAllocator>;
+        using header_type = bytes::Header<TAllocator>;
+
+        KSTD_NO_UNIQUE_ADDRESS TAllocator _allocator;
+        header_type* _header;
+        usize _size;
+
+        auto grow(const usize required) noexcept -> void {
+            const auto new_capacity = max(max(required, capacity() << 1), min_capacity);
+            if(_header == nullptr) {
+                _header = bytes::allocate(_allocator, new_capacity);
+                return;
+            }
+            // The buffer is not shared until it is frozen
+            _header = bytes::reallocate(_allocator, _header, new_capacity, _size);
+        }
+
+    public:
+        explicit BasicBytesMut(TAllocator allocator = {}) noexcept
+            : _allocator(move(allocator))
+            , _header(nullptr)
+            , _size(0) {
+        }
+
+        explicit BasicBytesMut(const usize capacity, TAllocator allocator = {}) noexcept
+            : BasicBytesMut(move(allocator)) {
+            reserve(capacity);
+        }
+
+        KSTD_NO_COPY(BasicBytesMut, self_type)
+
+        BasicBytesMut(self_type&& other) noexcept
+            : _allocator(move(other._allocator))
+            , _header(other._header)
+            , _size(other._size) {
+            other._header = nullptr;
+            other._size = 0;
+        }
+
+        ~BasicBytesMut() noexcept {
+            if(_header != nullptr) {
+                bytes::free(_header);
+            }
+        }
+
+        auto operator=(self_type&& other) noexcept -> self_type& {
+            if(this == &other) {
+                return *this;
+            }
+            if(_header != nullptr) {
+                bytes::free(_header);
+            }
+            _allocator = move(other._allocator);
+            _header = other._header;
+            _size = other._size;
+            other._header = nullptr;
+            other._size = 0;
+            return *this;
+        }
+
+        auto reserve(const usize capacity) noexcept -> void {
+            if(capacity > this->capacity()) {
+                grow(capacity);
+            }
+        }
+
+        auto push_back(const u8 value) noexcept -> void {
+            if(_size == capacity()) {
+                grow(_size + 1);
+            }
+            _header->get_data()[_size++] = value;
+        }
+
+        auto append(const u8* data, const usize size) noexcept -> void {
+            if(size == 0) {
+                return;
+            }
+            const auto address = reinterpret_cast<usize>(data);
+            const auto begin = reinterpret_cast<usize>(this->data());
+            if(_size != 0 && address >= begin && address < begin + _size) {
+                // The source is part of this buffer, growing may move it
+                const auto offset = address - begin;
+                reserve(_size + size);
+                memmove(_header->get_data() + _size, _header->get_data() + offset, size);
+            }
+            else {
+                reserve(_size + size);
+                memcpy(_header->get_data() + _size, data, size);
+            }
+            _size += size;
+        }
+
+        auto append(const Slice<u8>& slice) noexcept -> void {
+            append(slice.data(), slice.size());
+        }
+
+        auto append(const StringView& view) noexcept -> void {
+            append(reinterpret_cast<const u8*>(view.data()), view.length());
+        }
+
+        /**
+         * Makes room for count bytes and returns where to write them,
+         * the bytes only become part of the buffer once they are committed.
+         */
+        [[nodiscard]] auto acquire(const usize count) noexcept -> u8* {
+            reserve(_size + count);
+            return _header->get_data() + _size;
+        }
+
+        /**
+         * Appends count bytes which were written to the pointer returned by the last call to acquire.
+         */
+        auto commit(const usize count) noexcept -> void {
+            if(_size + count > capacity()) {
+                panic("Committed more bytes than were acquired");
+            }
+            _size += count;
+        }
+
+        auto clear() noexcept -> void {
+            _size = 0;
+        }
+
+        [[nodiscard]] auto data() noexcept -> u8* {
+            return _header == nullptr ? nullptr : _header->get_data();
+        }
+
+        [[nodiscard]] auto data() const noexcept -> const u8* {
+            return _header == nullptr ? nullptr : _header->get_data();
+        }
+
+        [[nodiscard]] auto size() const noexcept -> usize {
+            return _size;
+        }
+
+        [[nodiscard]] auto capacity() const noexcept -> usize {
+            return _header == nullptr ? 0 : _header->capacity;
+        }
+
+        [[nodiscard]] auto is_empty() const noexcept -> bool {
+            return _size == 0;
+        }
+
+        [[nodiscard]] auto begin() noexcept -> iterator {
+            return data();
+        }
+
+        [[nodiscard]] auto end() noexcept -> iterator {
+            return data() + _size;
+        }
+
+        [[nodiscard]] auto begin() const noexcept -> const_iterator {
+            return data();
+        }
+
+        [[nodiscard]] auto end() const noexcept -> const_iterator {
+            return data() + _size;
+        }
+
+        [[nodiscard]] auto operator[](const usize index) noexcept -> u8& {
+            return _header->get_data()[index];
+        }
+
+        [[nodiscard]] auto operator[](const usize index) const noexcept -> u8 {
+            return _header->get_data()[index];
+        }
+
+        [[nodiscard]] auto as_slice() const noexcept -> Slice<u8> {
+            return {data(), _size};
+        }
+
+        [[nodiscard]] auto as_string_view() const noexcept -> StringView {
+            return {reinterpret_cast<const char*>(data()), _size};
+        }
+
+        /**
+         * Hands the allocation over to an immutable buffer without copying, this buffer is left empty.
+         */
+        [[nodiscard]] auto freeze() noexcept -> frozen_type {
+            if(_size == 0) {
+                return {};
+            }
+            frozen_type result(_header, _header->get_data(), _size);
+            _header = nullptr;
+            _size = 0;
+            return result;
+        }
+    };
+
+    using Bytes = BasicBytes<>;
+    using BytesMut = BasicBytesMut<>;
+}// namespace kstd
\ No newline at end of file
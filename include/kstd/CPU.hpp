@@ -0,0 +1,42 @@
+// Copyright 2024 Karma Krafts & associates
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include "Types.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define KSTD_CPU_X86_FAMILY
+#endif
+
+namespace kstd::cpu {
+    /**
+     * The instruction set extensions of the executing CPU which kstd selects kernels by.
+     * AVX-based features are only reported if the OS saves the wide registers.
+     */
+    struct Features final {
+        bool has_sse2;
+        bool has_ssse3;
+        bool has_sse41;
+        bool has_sse42;
+        bool has_popcnt;
+        bool has_avx2;
+        bool has_bmi2;
+    };
+
+    /**
+     * @return The features of the executing CPU, detected once on first use.
+     */
+    [[nodiscard]] auto get_features() noexcept -> const Features&;
+}// namespace kstd::cpu
\ No newline at end of file
@@ -0,0 +1,64 @@
+// Copyright 2024 Karma Krafts & associates
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include "Types.hpp"
+
+namespace kstd::crash {
+    /**
+     * The maximum number of frames recorded in a single report.
+     */
+    constexpr usize max_frames = 128;
+
+    /**
+     * Installs handlers for fatal signals (SIGSEGV, SIGBUS, SIGILL, SIGFPE and SIGABRT on Unix,
+     * unhandled exceptions on Windows) which write a crash report to the given file descriptor.
+     * All memory the handlers need is allocated here, including the alternate signal stack of the
+     * calling thread, so reporting works even after the heap was corrupted or the stack overflowed.
+     *
+     * A report only contains raw return addresses and, where available, the executable mappings of
+     * the process. Symbolization is left to an offline step, for example through addr2line, so
+     * a dying process never parses debug information.
+     *
+     * @param fd The file descriptor reports are written to, which has to stay open.
+     * @return True if all handlers were installed.
+     */
+    auto install(i32 fd = 2) noexcept -> bool;
+
+    /**
+     * Opens or creates the given file for appending and installs the handlers writing to it.
+     */
+    auto install(const char* path) noexcept -> bool;
+
+    /**
+     * Allocates the alternate signal stack for the calling thread. Every thread which should be able
+     * to report a stack overflow has to call this once, install does so for the calling thread.
+     */
+    auto install_thread() noexcept -> bool;
+
+    /**
+     * Restores the handlers which were active before install.
+     */
+    auto uninstall() noexcept -> void;
+
+    /**
+     * Writes a report for the calling thread to the report file descriptor, or to stderr if the
+     * handlers were never installed. This neither allocates nor takes locks, so it may be called
+     * from signal handlers.
+     *
+     * @param reason A null-terminated description of what went wrong.
+     */
+    auto write_report(const char* reason) noexcept -> void;
+}// namespace kstd::crash
\ No newline at end of file
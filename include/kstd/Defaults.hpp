@@ -78,3 +78,22 @@
 #define KSTD_NO_MOVE_COPY(n, t, ...) \
     KSTD_NO_MOVE(n, t, __VA_ARGS__)  \
     KSTD_NO_COPY(n, t, __VA_ARGS__)
+
+
+/**
+ * Allows an empty member (like a stateless allocator) to occupy no storage.
+ */
+#ifdef KSTD_COMPILER_MSVC
+#define KSTD_NO_UNIQUE_ADDRESS [[msvc::no_unique_address]]
+#else
+#define KSTD_NO_UNIQUE_ADDRESS [[no_unique_address]]
+#endif
+
+/**
+ * Keeps a cold function out of its callers, so it is not specialized for what they know about its arguments.
+ */
+#ifdef KSTD_COMPILER_MSVC
+#define KSTD_NOINLINE __declspec(noinline)
+#else
+#define KSTD_NOINLINE [[gnu::noinline]]
+#endif
\ No newline at end of file
@@ -25,6 +25,7 @@ namespace kstd {
     struct FixedArray final {
         using element_type = T;
         using slice_type = Slice<element_type>;
+        using mut_slice_type = SliceMut<element_type>;
         static constexpr usize buffer_size = TSize;
 
     private:
@@ -52,6 +53,10 @@ namespace kstd {
             return {_data, buffer_size};
         }
 
+        operator mut_slice_type() noexcept {
+            return {_data, buffer_size};
+        }
+
         template<typename... TArgs>
         constexpr auto insert_all(TArgs&&... values) noexcept -> void {
             insert_all_impl<TArgs...>(0, forward<TArgs>(values)...);
@@ -0,0 +1,179 @@
+// Copyright 2024 Karma Krafts & associates
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "Bits.hpp"
+#include "Defaults.hpp"
+#include "FixedArray.hpp"
+#include "Math.hpp"
+#include "Slice.hpp"
+#include "Types.hpp"
+
+namespace kstd {
+    /**
+     * A set of TSize bits, packed into an inline array of 64-bit words.
+     * Bits past TSize are always kept zero.
+     *
+     * @tparam TSize The number of bits in the set.
+     */
+    template<usize TSize>
+    struct FixedBitArray final {
+        using word_type = u64;
+        using slice_type = Slice<word_type>;
+
+        static constexpr usize bit_count = TSize;
+        static constexpr usize word_count = bits::get_word_count(TSize);
+
+    private:
+        using self_type = FixedBitArray<TSize>;
+
+        FixedArray<word_type, word_count> _words;
+
+        constexpr auto clear_tail() noexcept -> void {
+            if constexpr(word_count > 0) {
+                _words[word_count - 1] &= bits::get_tail_mask(bit_count);
+            }
+        }
+
+    public:
+        constexpr FixedBitArray() noexcept
+            : _words() {
+        }
+
+        KSTD_DEFAULT_MOVE_COPY(FixedBitArray, self_type, constexpr)
+        ~FixedBitArray() noexcept = default;
+
+        [[nodiscard]] operator slice_type() const noexcept {
+            return _words;
+        }
+
+        [[nodiscard]] constexpr auto size() const noexcept -> usize {
+            return bit_count;
+        }
+
+        [[nodiscard]] auto data() noexcept -> word_type* {
+            return _words.data();
+        }
+
+        [[nodiscard]] auto data() const noexcept -> const word_type* {
+            return _words.data();
+        }
+
+        constexpr auto set(const usize index) noexcept -> void {
+            _words[index / bits::word_bits] |= word_type {1} << (index % bits::word_bits);
+        }
+
+        constexpr auto set(const usize index, const bool value) noexcept -> void {
+            const auto mask = word_type {1} << (index % bits::word_bits);
+            auto& word = _words[index / bits::word_bits];
+            word = (word & ~mask) | (-static_cast<word_type>(value) & mask);
+        }
+
+        constexpr auto reset(const usize index) noexcept -> void {
+            _words[index / bits::word_bits] &= ~(word_type {1} << (index % bits::word_bits));
+        }
+
+        constexpr auto flip(const usize index) noexcept -> void {
+            _words[index / bits::word_bits] ^= word_type {1} << (index % bits::word_bits);
+        }
+
+        [[nodiscard]] constexpr auto test(const usize index) const noexcept -> bool {
+            return ((_words[index / bits::word_bits] >> (index % bits::word_bits)) & 1) != 0;
+        }
+
+        [[nodiscard]] constexpr auto operator[](const usize index) const noexcept -> bool {
+            return test(index);
+        }
+
+        constexpr auto set_all() noexcept -> void {
+            for(usize i = 0; i < word_count; ++i) {
+                _words[i] = ~word_type {0};
+            }
+            clear_tail();
+        }
+
+        constexpr auto reset_all() noexcept -> void {
+            for(usize i = 0; i < word_count; ++i) {
+                _words[i] = 0;
+            }
+        }
+
+        constexpr auto flip_all() noexcept -> void {
+            for(usize i = 0; i < word_count; ++i) {
+                _words[i] = ~_words[i];
+            }
+            clear_tail();
+        }
+
+        [[nodiscard]] auto count() const noexcept -> usize {
+            return bits::count_ones(_words.data(), word_count);
+        }
+
+        [[nodiscard]] auto any() const noexcept -> bool {
+            return find_first_set() != bit_count;
+        }
+
+        [[nodiscard]] auto none() const noexcept -> bool {
+            return !any();
+        }
+
+        /**
+         * @return The index of the first set bit, or size() if no bit is set.
+         */
+        [[nodiscard]] auto find_first_set() const noexcept -> usize {
+            return find_next_set(0);
+        }
+
+        /**
+         * @param index The index of the first bit to consider.
+         * @return The index of the first set bit at or after index, or size() if there is none.
+         */
+        [[nodiscard]] auto find_next_set(const usize index) const noexcept -> usize {
+            return min(bits::find_next_set(_words.data(), word_count, index), bit_count);
+        }
+
+        [[nodiscard]] auto get_set_bits() const noexcept -> bits::SetBitRange {
+            return {_words.data(), word_count};
+        }
+
+        auto operator&=(const self_type& other) noexcept -> self_type& {
+            bits::apply_words<bits::AndOp>(_words.data(), other._words.data(), word_count);
+            return *this;
+        }
+
+        auto operator|=(const self_type& other) noexcept -> self_type& {
+            bits::apply_words<bits::OrOp>(_words.data(), other._words.data(), word_count);
+            return *this;
+        }
+
+        auto operator^=(const self_type& other) noexcept -> self_type& {
+            bits::apply_words<bits::XorOp>(_words.data(), other._words.data(), word_count);
+            return *this;
+        }
+
+        auto and_not(const self_type& other) noexcept -> self_type& {
+            bits::apply_words<bits::AndNotOp>(_words.data(), other._words.data(), word_count);
+            return *this;
+        }
+
+        [[nodiscard]] constexpr auto operator==(const self_type& other) const noexcept -> bool {
+            for(usize i = 0; i < word_count; ++i) {
+                if(_words[i] != other._words[i]) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+}// namespace kstd
\ No newline at end of file
@@ -0,0 +1,103 @@
+// Copyright 2024 Karma Krafts & associates
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "Defaults.hpp"
+#include "FixedArray.hpp"
+#include "MdSlice.hpp"
+#include "Slice.hpp"
+#include "Types.hpp"
+
+namespace kstd {
+    /**
+     * An inline, row-major multi-dimensional array with compile-time extents.
+     * Since all strides are known at compile time, indexing folds into constants.
+     *
+     * @tparam T The type of the elements.
+     * @tparam TExtents The extent of every dimension.
+     */
+    template<typename T, usize... TExtents>
+    struct FixedMdArray final {
+        using element_type = T;
+        using slice_type = MdSlice<T, sizeof...(TExtents), RowMajor>;
+        using const_slice_type = MdSlice<const T, sizeof...(TExtents), RowMajor>;
+        using extents_type = FixedArray<usize, sizeof...(TExtents)>;
+
+        static constexpr usize rank = sizeof...(TExtents);
+        static constexpr usize buffer_size = (TExtents * ...);
+
+        static_assert(rank > 0, "FixedMdArray requires at least one dimension");
+
+    private:
+        FixedArray<T, buffer_size> _data;
+
+        [[nodiscard]] static constexpr auto get_extents() noexcept -> extents_type {
+            extents_type extents {};
+            extents.insert_all(TExtents...);
+            return extents;
+        }
+
+        template<usize TDimension = 0, typename THead, typename... TTail>
+        [[nodiscard]] static constexpr auto get_offset(const usize offset, const THead head, const TTail... tail) noexcept -> usize {
+            const auto result = offset * get_extents()[TDimension] + static_cast<usize>(head);
+            if constexpr(sizeof...(TTail) > 0) {
+                return get_offset<TDimension + 1>(result, tail...);
+            }
+            else {
+                return result;
+            }
+        }
+
+    public:
+        constexpr FixedMdArray() noexcept = default;
+        KSTD_DEFAULT_MOVE_COPY(FixedMdArray, FixedMdArray, constexpr)
+        ~FixedMdArray() noexcept = default;
+
+        [[nodiscard]] operator slice_type() noexcept {
+            return {_data.data(), get_extents()};
+        }
+
+        [[nodiscard]] operator const_slice_type() const noexcept {
+            return {_data.data(), get_extents()};
+        }
+
+        [[nodiscard]] auto data() noexcept -> T* {
+            return _data.data();
+        }
+
+        [[nodiscard]] auto data() const noexcept -> const T* {
+            return _data.data();
+        }
+
+        [[nodiscard]] constexpr auto size() const noexcept -> usize {
+            return buffer_size;
+        }
+
+        [[nodiscard]] static constexpr auto get_extent(const usize dimension) noexcept -> usize {
+            return get_extents()[dimension];
+        }
+
+        template<concepts::Integer... TIndices>
+        requires(sizeof...(TIndices) == rank)
+        [[nodiscard]] constexpr auto operator()(const TIndices... indices) noexcept -> T& {
+            return _data[get_offset(0, indices...)];
+        }
+
+        template<concepts::Integer... TIndices>
+        requires(sizeof...(TIndices) == rank)
+        [[nodiscard]] constexpr auto operator()(const TIndices... indices) const noexcept -> const T& {
+            return _data[get_offset(0, indices...)];
+        }
+    };
+}// namespace kstd
\ No newline at end of file
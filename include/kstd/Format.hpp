@@ -0,0 +1,298 @@
+// Copyright 2024 Karma Krafts & associates
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+// NOLINTBEGIN
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+// NOLINTEND
+
+#include "Array.hpp"
+#include "Math.hpp"
+#include "Meta.hpp"
+#include "Slice.hpp"
+#include "SourceLocation.hpp"
+#include "StackTrace.hpp"
+#include "String.hpp"
+#include "StringBuilder.hpp"
+#include "StringView.hpp"
+#include "Types.hpp"
+#include "Utility.hpp"
+
+namespace kstd {
+    namespace formatting {
+        /**
+         * An fmt output buffer which writes straight into the spare capacity of a growable
+         * kstd container, appending to its current contents.
+         *
+         * @tparam TContainer A container of chars with data, size, capacity and resize.
+         */
+        template<typename TContainer>
+        class ContainerBuffer final : public fmt::detail::buffer<char> {
+            TContainer& _container;
+            usize _offset;
+
+            auto grow(const usize capacity) -> void override {
+                // Grow geometrically, fmt only asks for what the current write needs
+                _container.resize_uninitialized(max(_offset + capacity, _container.size() << 1));
+                set(_container.data() + _offset, _container.size() - _offset);
+            }
+
+        public:
+            explicit ContainerBuffer(TContainer& container) noexcept
+                : fmt::detail::buffer<char>()
+                , _container(container)
+                , _offset(container.size()) {
+                _container.resize_uninitialized(max(_offset, _container.capacity()));
+                set(_container.data() + _offset, _container.size() - _offset);
+            }
+
+            KSTD_NO_MOVE_COPY(ContainerBuffer, ContainerBuffer)
+            ~ContainerBuffer() noexcept = default;
+
+            /**
+             * Trims the container to the written characters.
+             *
+             * @return The number of characters written through this buffer.
+             */
+            auto finish() noexcept -> usize {
+                const auto written = size();
+                _container.resize_uninitialized(_offset + written);
+                return written;
+            }
+        };
+
+        /**
+         * An fmt output buffer which writes straight into the chunks of a string builder.
+         * Whenever a chunk is full, the written part is committed and the next chunk is acquired.
+         *
+         * @tparam TAllocator The allocator of the string builder.
+         */
+        template<typename TAllocator>
+        class BuilderBuffer final : public fmt::detail::buffer<char> {
+            using builder_type = BasicStringBuilder<char, TAllocator>;
+
+            builder_type& _builder;
+            usize _written;
+
+            auto flush() noexcept -> void {
+                _builder.commit(size());
+                _written += size();
+                clear();
+            }
+
+            auto grow(const usize capacity) -> void override {
+                const auto required = capacity - size();
+                flush();
+                auto* data = _builder.acquire(min(required, builder_type::min_chunk_size));
+                set(data, _builder.get_available());
+            }
+
+        public:
+            explicit BuilderBuffer(builder_type& builder) noexcept
+                : fmt::detail::buffer<char>()
+                , _builder(builder)
+                , _written(0) {
+                auto* data = _builder.acquire(1);
+                set(data, _builder.get_available());
+            }
+
+            KSTD_NO_MOVE_COPY(BuilderBuffer, BuilderBuffer)
+            ~BuilderBuffer() noexcept = default;
+
+            /**
+             * Commits the remaining characters to the builder.
+             *
+             * @return The number of characters written through this buffer.
+             */
+            auto finish() noexcept -> usize {
+                flush();
+                return _written;
+            }
+        };
+
+        /**
+         * Formats a sequence as [a, b, c], applying the format specification to every element.
+         */
+        template<typename T>
+        struct SequenceFormatter {
+        private:
+            fmt::formatter<remove_const<T>, char> _element_formatter {};
+
+        public:
+            constexpr auto parse(fmt::format_parse_context& context) -> fmt::format_parse_context::iterator {
+                return _element_formatter.parse(context);
+            }
+
+            template<typename TIterator>
+            auto format_sequence(TIterator begin, const TIterator end, fmt::format_context& context) const
+                -> fmt::format_context::iterator {
+                auto out = context.out();
+                *out++ = '[';
+                for(auto current = begin; current != end; ++current) {
+                    if(current != begin) {
+                        *out++ = ',';
+                        *out++ = ' ';
+                    }
+                    context.advance_to(out);
+                    out = _element_formatter.format(*current, context);
+                }
+                *out++ = ']';
+                return out;
+            }
+        };
+
+        /**
+         * Base for formatters which take no format specification.
+         */
+        struct PlainFormatter {
+            constexpr auto parse(fmt::format_parse_context& context) -> fmt::format_parse_context::iterator {
+                const auto* current = context.begin();
+                if(current != context.end() && *current != '}') {
+                    fmt::detail::throw_format_error("Invalid format specification");
+                }
+                return current;
+            }
+        };
+    }// namespace formatting
+
+    /**
+     * Appends formatted text to the given array without any intermediate string.
+     *
+     * @return The number of appended characters.
+     */
+    template<typename TAllocator, typename... TArgs>
+    auto format_to(Array<char, TAllocator>& out, fmt::format_string<TArgs...> format, TArgs&&... args) -> usize {
+        formatting::ContainerBuffer<Array<char, TAllocator>> buffer(out);
+        fmt::vformat_to(fmt::appender(buffer), format.get(), fmt::make_format_args(args...));
+        return buffer.finish();
+    }
+
+    /**
+     * Appends formatted text to the given string without any intermediate string.
+     *
+     * @return The number of appended characters.
+     */
+    template<typename TAllocator, typename... TArgs>
+    auto format_to(BasicString<char, TAllocator>& out, fmt::format_string<TArgs...> format, TArgs&&... args) -> usize {
+        formatting::ContainerBuffer<BasicString<char, TAllocator>> buffer(out);
+        fmt::vformat_to(fmt::appender(buffer), format.get(), fmt::make_format_args(args...));
+        return buffer.finish();
+    }
+
+    /**
+     * Appends formatted text to the chunks of the given string builder, which never moves what was already written.
+     *
+     * @return The number of appended characters.
+     */
+    template<typename TAllocator, typename... TArgs>
+    auto format_into(BasicStringBuilder<char, TAllocator>& out, fmt::format_string<TArgs...> format, TArgs&&... args) -> usize {
+        formatting::BuilderBuffer<TAllocator> buffer(out);
+        fmt::vformat_to(fmt::appender(buffer), format.get(), fmt::make_format_args(args...));
+        return buffer.finish();
+    }
+
+    /**
+     * @return A new string holding the formatted text.
+     */
+    template<typename... TArgs>
+    [[nodiscard]] auto format(fmt::format_string<TArgs...> format, TArgs&&... args) -> String {
+        String result {};
+        format_to(result, format, forward<TArgs>(args)...);
+        return result;
+    }
+}// namespace kstd
+
+// Sequences get their own formatters below, keep fmt's generic range support out of the way
+template<typename T, typename TAllocator>
+struct fmt::is_range<kstd::Array<T, TAllocator>, char> : std::false_type {};
+
+template<typename T>
+struct fmt::is_range<kstd::Slice<T>, char> : std::false_type {};
+
+template<typename TAllocator>
+struct fmt::is_range<kstd::BasicString<char, TAllocator>, char> : std::false_type {};
+
+template<>
+struct fmt::is_range<kstd::StringView, char> : std::false_type {};
+
+template<>
+struct fmt::formatter<kstd::StringView, char> : fmt::formatter<fmt::string_view, char> {
+    auto format(const kstd::StringView& value, fmt::format_context& context) const -> fmt::format_context::iterator {
+        return fmt::formatter<fmt::string_view, char>::format({value.data(), value.length()}, context);
+    }
+};
+
+template<typename TAllocator>
+struct fmt::formatter<kstd::BasicString<char, TAllocator>, char> : fmt::formatter<fmt::string_view, char> {
+    auto format(const kstd::BasicString<char, TAllocator>& value, fmt::format_context& context) const -> fmt::format_context::iterator {
+        return fmt::formatter<fmt::string_view, char>::format({value.data(), value.size()}, context);
+    }
+};
+
+template<typename T, typename TAllocator>
+struct fmt::formatter<kstd::Array<T, TAllocator>, char> : kstd::formatting::SequenceFormatter<T> {
+    auto format(const kstd::Array<T, TAllocator>& value, fmt::format_context& context) const -> fmt::format_context::iterator {
+        return this->format_sequence(value.begin(), value.end(), context);
+    }
+};
+
+template<typename T>
+struct fmt::formatter<kstd::Slice<T>, char> : kstd::formatting::SequenceFormatter<T> {
+    auto format(const kstd::Slice<T>& value, fmt::format_context& context) const -> fmt::format_context::iterator {
+        return this->format_sequence(value.begin(), value.end(), context);
+    }
+};
+
+template<>
+struct fmt::formatter<kstd::SourceLocation, char> : kstd::formatting::PlainFormatter {
+    auto format(const kstd::SourceLocation& value, fmt::format_context& context) const -> fmt::format_context::iterator {
+        return fmt::format_to(context.out(), "{}:{}:{}", value.get_file(), value.get_line(), value.get_column());
+    }
+};
+
+template<>
+struct fmt::formatter<kstd::StackTraceElement, char> : kstd::formatting::PlainFormatter {
+    auto format(const kstd::StackTraceElement& value, fmt::format_context& context) const -> fmt::format_context::iterator {
+        const auto function_name = value.get_function_name();
+        auto out = fmt::format_to(context.out(), "{} in {}", value.get_address(),
+                                  function_name.is_empty() ? kstd::StringView("??", 2) : function_name);
+        if(!value.get_file_name().is_empty()) {
+            return fmt::format_to(out, " at {}:{}:{}", value.get_file_name(), value.get_line(), value.get_column());
+        }
+        if(!value.get_binary().is_empty()) {
+            return fmt::format_to(out, " from {}", value.get_binary());
+        }
+        return out;
+    }
+};
+
+template<>
+struct fmt::formatter<kstd::StackTrace, char> : kstd::formatting::PlainFormatter {
+    auto format(const kstd::StackTrace& value, fmt::format_context& context) const -> fmt::format_context::iterator {
+        auto out = context.out();
+        auto is_first = true;
+        for(kstd::usize i = 0; i < value.get_depth(); ++i) {
+            for(const auto& element : value.get_elements(i)) {
+                if(!is_first) {
+                    *out++ = '\n';
+                }
+                is_first = false;
+                out = fmt::format_to(out, "#{} {}{}", i, element.is_inlined() ? "[inlined] " : "", element);
+            }
+        }
+        return out;
+    }
+};
\ No newline at end of file
@@ -0,0 +1,100 @@
+// Copyright 2024 Karma Krafts & associates
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include "Concepts.hpp"
+#include "Types.hpp"
+
+namespace kstd {
+    namespace hash {
+        static constexpr u64 default_seed = 0xA0761D6478BD642FULL;
+        static constexpr u64 secret = 0xE7037ED1A0B428DBULL;
+        static constexpr u64 seed_secret = 0x8EBC6AF09C88C6E3ULL;
+
+        /**
+         * Multiplies both values into a 128-bit product and folds its halves together.
+         */
+        [[nodiscard]] constexpr auto mix(const u64 lhs, const u64 rhs) noexcept -> u64 {
+#if defined(KSTD_COMPILER_MSVC)
+            // Portable 64x64 -> 128 multiplication, MSVC has no 128-bit integer type
+            const auto lhs_low = lhs & 0xFFFFFFFFULL;
+            const auto lhs_high = lhs >> 32;
+            const auto rhs_low = rhs & 0xFFFFFFFFULL;
+            const auto rhs_high = rhs >> 32;
+            const auto low_low = lhs_low * rhs_low;
+            const auto high_low = lhs_high * rhs_low;
+            const auto low_high = lhs_low * rhs_high;
+            const auto high_high = lhs_high * rhs_high;
+            const auto cross = (low_low >> 32) + (high_low & 0xFFFFFFFFULL) + low_high;
+            const auto high = high_high + (high_low >> 32) + (cross >> 32);
+            const auto low = (cross << 32) | (low_low & 0xFFFFFFFFULL);
+            return high ^ low;
+#else
+            const auto product = static_cast<unsigned __int128>(lhs) * static_cast<unsigned __int128>(rhs);
+            return static_cast<u64>(product >> 64) ^ static_cast<u64>(product);
+#endif
+        }
+
+        /**
+         * Reads up to 8 bytes starting at the given byte offset as a little-endian integer.
+         * Assembling the value from single elements keeps this usable in constant expressions,
+         * optimizing compilers fold it into a single load.
+         */
+        template<concepts::Integer T>
+        [[nodiscard]] constexpr auto read_bytes(const T* data, const usize offset, const usize count) noexcept -> u64 {
+            u64 result = 0;
+            for(usize i = 0; i < count; ++i) {
+                const auto byte_index = offset + i;
+                const auto element = static_cast<u64>(data[byte_index / sizeof(T)]);
+                const auto byte = (element >> ((byte_index % sizeof(T)) << 3)) & 0xFF;
+                result |= byte << (i << 3);
+            }
+            return result;
+        }
+    }// namespace hash
+
+    /**
+     * Hashes a sequence of integers, consuming 16 bytes per round.
+     * The result is not stable across library versions and must not be persisted.
+     *
+     * @tparam T The integer type of the elements.
+     * @param data A pointer to the first element.
+     * @param size The number of elements to hash.
+     * @param seed An optional seed to derive independent hash functions.
+     * @return The 64-bit hash of the given elements.
+     */
+    template<concepts::Integer T>
+    [[nodiscard]] constexpr auto hash_elements(const T* data, const usize size, const u64 seed = hash::default_seed) noexcept -> u64 {
+        const auto byte_count = size * sizeof(T);
+        auto state = seed ^ hash::mix(seed ^ hash::secret, hash::seed_secret);
+        usize offset = 0;
+        for(; offset + 16 < byte_count; offset += 16) {
+            const auto lhs = hash::read_bytes(data, offset, 8);
+            const auto rhs = hash::read_bytes(data, offset + 8, 8);
+            state = hash::mix(lhs ^ hash::secret, rhs ^ state);
+        }
+        const auto remaining = byte_count - offset;
+        const auto lhs = hash::read_bytes(data, offset, remaining < 8 ? remaining : 8);
+        const auto rhs = remaining > 8 ? hash::read_bytes(data, offset + 8, remaining - 8) : 0;
+        return hash::mix(hash::secret ^ byte_count, hash::mix(lhs ^ hash::secret, rhs ^ state));
+    }
+
+    /**
+     * Combines a hash with another value, for hashing composite keys.
+     */
+    [[nodiscard]] constexpr auto hash_combine(const u64 hash, const u64 value) noexcept -> u64 {
+        return hash::mix(hash ^ hash::secret, value ^ hash::default_seed);
+    }
+}// namespace kstd
\ No newline at end of file
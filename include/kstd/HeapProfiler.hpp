@@ -0,0 +1,100 @@
+// Copyright 2024 Karma Krafts & associates
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include "Atomic.hpp"
+#include "Types.hpp"
+
+namespace kstd::profiler::heap {
+    /**
+     * The default mean number of bytes between two samples.
+     */
+    constexpr usize default_interval = 512 * 1024;
+
+    enum class ProfileKind : u8 {
+        LIVE,     // The estimated bytes of all sampled allocations which were not freed yet
+        ALLOCATED,// The estimated bytes of all sampled allocations since sampling was enabled
+    };
+
+    /**
+     * Whether allocations are sampled. This is only read by the hooks below, so that
+     * allocating and freeing costs one predictable branch while sampling is disabled.
+     */
+    extern Atomic<bool> is_sampling;
+
+    /**
+     * Starts sampling allocations made through kstd::Allocator and, with KSTD_GLOBAL_MIMALLOC,
+     * the global new and delete operators. Like tcmalloc, every thread samples once per
+     * exponentially distributed number of bytes with the given mean, so large allocations are
+     * more likely to be sampled and every sample is weighted by the inverse of its probability.
+     *
+     * Each sample records the stack of the allocation, and samples stay in a side table until
+     * they are freed. Enabling sampling again after it was disabled discards the previous samples.
+     *
+     * @param interval The mean number of bytes between two samples.
+     * @return True if sampling is enabled, false if it is unsupported.
+     */
+    auto enable(usize interval = default_interval) noexcept -> bool;
+
+    /**
+     * Stops sampling. Frees are no longer tracked either, so the live profile is only
+     * accurate for the time sampling was enabled.
+     */
+    auto disable() noexcept -> void;
+
+    [[nodiscard]] inline auto is_enabled() noexcept -> bool {
+        return is_sampling.load(std::memory_order_relaxed);
+    }
+
+    auto record_allocation(void* memory, usize size) noexcept -> void;
+
+    auto record_free(void* memory) noexcept -> void;
+
+    /**
+     * Allocator hook, called with every block right after it was allocated.
+     */
+    inline auto on_allocate(void* memory, const usize size) noexcept -> void {
+        if(is_sampling.load(std::memory_order_relaxed)) [[unlikely]] {
+            record_allocation(memory, size);
+        }
+    }
+
+    /**
+     * Allocator hook, called with every block right before it is freed.
+     */
+    inline auto on_free(void* memory) noexcept -> void {
+        if(is_sampling.load(std::memory_order_relaxed)) [[unlikely]] {
+            record_free(memory);
+        }
+    }
+
+    /**
+     * @return The estimated number of bytes of the given profile.
+     */
+    [[nodiscard]] auto get_bytes(ProfileKind kind) noexcept -> usize;
+
+    /**
+     * Writes the given profile as folded stacks with the estimated bytes per stack.
+     */
+    auto write_folded(const char* path, ProfileKind kind) noexcept -> bool;
+
+    /**
+     * Writes both profiles as an uncompressed pprof profile with alloc_objects, alloc_space,
+     * inuse_objects and inuse_space values, which is the layout pprof expects from heap profiles.
+     * The duration of the profile is the time since sampling was enabled, which turns the
+     * allocated values into allocation rates.
+     */
+    auto write_pprof(const char* path) noexcept -> bool;
+}// namespace kstd::profiler::heap
\ No newline at end of file
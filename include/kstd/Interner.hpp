@@ -0,0 +1,441 @@
+// Copyright 2024 Karma Krafts & associates
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+// NOLINTBEGIN
+#include <mutex>
+// NOLINTEND
+
+#include "Allocator.hpp"
+#include "Atomic.hpp"
+#include "Concepts.hpp"
+#include "Defaults.hpp"
+#include "Hash.hpp"
+#include "Memory.hpp"
+#include "Meta.hpp"
+#include "Panic.hpp"
+#include "StableArray.hpp"
+#include "StringView.hpp"
+#include "Types.hpp"
+
+namespace kstd {
+    /**
+     * The header of an interned string inside the arena of an interner.
+     * The null-terminated characters follow directly after the header.
+     */
+    struct InternedEntry final {
+        u64 hash;
+        u32 id;
+        u32 length;
+
+        [[nodiscard]] auto data() const noexcept -> const char* {
+            return reinterpret_cast<const char*>(this + 1);
+        }
+    };
+
+    namespace interner {
+        struct EmptyEntry final {
+            InternedEntry header;
+            char terminator;
+        };
+
+        /**
+         * Every interner maps the empty string to this entry, so default-constructed
+         * handles compare equal to interned empty strings across all interners.
+         */
+        inline constexpr EmptyEntry empty_entry {{hash_elements<char>(nullptr, 0), 0, 0}, '\0'};
+    }// namespace interner
+
+    /**
+     * A handle to a string owned by an interner. Handles of the same interner
+     * are equal if and only if their strings are equal, so comparing them is a
+     * single pointer comparison. The handle stays valid as long as its interner.
+     */
+    struct InternedString final {
+    private:
+        const InternedEntry* _entry;
+
+    public:
+        InternedString() noexcept
+            : _entry(&interner::empty_entry.header) {
+        }
+
+        explicit InternedString(const InternedEntry* entry) noexcept
+            : _entry(entry) {
+        }
+
+        KSTD_DEFAULT_MOVE_COPY(InternedString, InternedString)
+        ~InternedString() noexcept = default;
+
+        [[nodiscard]] operator StringView() const noexcept {
+            return get_view();
+        }
+
+        [[nodiscard]] auto get_view() const noexcept -> StringView {
+            return {_entry->data(), _entry->length};
+        }
+
+        [[nodiscard]] auto get_id() const noexcept -> u32 {
+            return _entry->id;
+        }
+
+        [[nodiscard]] auto get_hash() const noexcept -> u64 {
+            return _entry->hash;
+        }
+
+        [[nodiscard]] auto data() const noexcept -> const char* {
+            return _entry->data();
+        }
+
+        [[nodiscard]] auto c_str() const noexcept -> const char* {
+            return _entry->data();
+        }
+
+        [[nodiscard]] auto length() const noexcept -> usize {
+            return _entry->length;
+        }
+
+        [[nodiscard]] auto is_empty() const noexcept -> bool {
+            return _entry->length == 0;
+        }
+
+        [[nodiscard]] auto operator==(const InternedString& other) const noexcept -> bool {
+            return _entry == other._entry;
+        }
+
+        [[nodiscard]] auto operator!=(const InternedString& other) const noexcept -> bool {
+            return _entry != other._entry;
+        }
+    };
+
+    /**
+     * Deduplicates strings into an append-only arena and hands out InternedString handles.
+     * Strings are never removed, all handles stay valid until the interner is destroyed.
+     *
+     * The concurrent variant serializes insertions with a mutex, while looking up strings
+     * which are already interned never takes the lock: hash table slots are published with
+     * release stores, and tables replaced by a rehash are kept alive until destruction so
+     * readers which still probe them are never left with dangling memory.
+     *
+     * @tparam TIsConcurrent True if the interner may be shared between threads.
+     * @tparam TAllocator The allocator used for the arena and the hash table.
+     */
+    template<bool TIsConcurrent, concepts::Allocator<u8> TAllocator = Allocator<u8>>
+    struct BasicInterner final {
+        using allocator_type = TAllocator;
+
+        static constexpr bool is_concurrent = TIsConcurrent;
+        static constexpr usize chunk_size = 64 * 1024;
+        static constexpr usize initial_table_capacity = 64;
+
+    private:
+        using self_type = BasicInterner<TIsConcurrent, TAllocator>;
+
+        struct NullMutex final {
+            auto lock() noexcept -> void {
+            }
+
+            auto unlock() noexcept -> void {
+            }
+        };
+
+        using mutex_type = conditional<TIsConcurrent, std::mutex, NullMutex>;
+        using slot_type = Atomic<const InternedEntry*>;
+
+        // Byte allocators only guarantee byte alignment, so chunk and table headers are placed at an
+        // aligned offset into their allocation and remember that offset to free the allocation again
+        struct Chunk final {
+            Chunk* previous;
+            u8 offset;
+
+            [[nodiscard]] auto get_data() noexcept -> u8* {
+                return reinterpret_cast<u8*>(this + 1);
+            }
+
+            [[nodiscard]] auto get_memory() noexcept -> u8* {
+                return reinterpret_cast<u8*>(this) - offset;
+            }
+        };
+
+        struct Table final {
+            Table* previous;
+            usize capacity;
+            u8 offset;
+
+            [[nodiscard]] auto get_memory() noexcept -> u8* {
+                return reinterpret_cast<u8*>(this) - offset;
+            }
+
+            [[nodiscard]] auto get_slots() noexcept -> slot_type* {
+                return reinterpret_cast<slot_type*>(this + 1);
+            }
+
+            [[nodiscard]] auto get_slots() const noexcept -> const slot_type* {
+                return reinterpret_cast<const slot_type*>(this + 1);
+            }
+        };
+
+        TAllocator _allocator;
+        mutable mutex_type _mutex;
+        Atomic<Table*> _table;
+        Atomic<usize> _count;
+        Chunk* _chunk;
+        u8* _chunk_position;
+        u8* _chunk_end;
+        usize _memory_usage;
+        StableArray<const InternedEntry*> _entries;
+
+        [[nodiscard]] static auto get_entry_size(const usize length) noexcept -> usize {
+            // Keep every header 8-byte aligned
+            return (sizeof(InternedEntry) + length + 1 + alignof(InternedEntry) - 1) & ~(alignof(InternedEntry) - 1);
+        }
+
+        template<typename THeader>
+        [[nodiscard]] auto allocate_aligned(const usize size) noexcept -> THeader* {
+            static_assert(alignof(THeader) % alignof(InternedEntry) == 0 && sizeof(THeader) % alignof(InternedEntry) == 0);
+            const auto allocation_size = size + alignof(THeader) - 1;
+            auto* memory = _allocator.allocate(allocation_size);
+            if(memory == nullptr) {
+                panic("Could not allocate interner memory");
+            }
+            auto* header = reinterpret_cast<THeader*>(align(memory, alignof(THeader)));
+            header->offset = static_cast<u8>(reinterpret_cast<u8*>(header) - memory);
+            _memory_usage += allocation_size;
+            return header;
+        }
+
+        [[nodiscard]] auto allocate_chunk(const usize size) noexcept -> Chunk* {
+            return allocate_aligned<Chunk>(sizeof(Chunk) + size);
+        }
+
+        [[nodiscard]] auto allocate_entry(const usize size) noexcept -> u8* {
+            if(size > chunk_size >> 2) {
+                // Oversized strings get a dedicated chunk, so the current chunk keeps its free space
+                auto* chunk = allocate_chunk(size);
+                if(_chunk == nullptr) {
+                    chunk->previous = nullptr;
+                    _chunk = chunk;
+                }
+                else {
+                    chunk->previous = _chunk->previous;
+                    _chunk->previous = chunk;
+                }
+                return chunk->get_data();
+            }
+            if(static_cast<usize>(_chunk_end - _chunk_position) < size) {
+                auto* chunk = allocate_chunk(chunk_size);
+                chunk->previous = _chunk;
+                _chunk = chunk;
+                _chunk_position = chunk->get_data();
+                _chunk_end = _chunk_position + chunk_size;
+            }
+            auto* result = _chunk_position;
+            _chunk_position += size;
+            return result;
+        }
+
+        [[nodiscard]] auto allocate_table(const usize capacity) noexcept -> Table* {
+            auto* table = allocate_aligned<Table>(sizeof(Table) + capacity * sizeof(slot_type));
+            table->previous = nullptr;
+            table->capacity = capacity;
+            auto* slots = table->get_slots();
+            for(usize i = 0; i < capacity; ++i) {
+                new(&slots[i]) slot_type(nullptr);
+            }
+            return table;
+        }
+
+        static auto insert_slot(Table* table, const InternedEntry* entry) noexcept -> void {
+            auto* slots = table->get_slots();
+            const auto mask = table->capacity - 1;
+            auto index = static_cast<usize>(entry->hash) & mask;
+            while(slots[index].load(std::memory_order_relaxed) != nullptr) {
+                index = (index + 1) & mask;
+            }
+            slots[index].store(entry, std::memory_order_release);
+        }
+
+        auto rehash(Table* table) noexcept -> Table* {
+            auto* new_table = allocate_table(table == nullptr ? initial_table_capacity : table->capacity << 1);
+            if(table != nullptr) {
+                auto* slots = table->get_slots();
+                for(usize i = 0; i < table->capacity; ++i) {
+                    const auto* entry = slots[i].load(std::memory_order_relaxed);
+                    if(entry != nullptr) {
+                        insert_slot(new_table, entry);
+                    }
+                }
+                if constexpr(TIsConcurrent) {
+                    new_table->previous = table;
+                }
+                else {
+                    _allocator.free(table->get_memory());
+                }
+            }
+            _table.store(new_table, std::memory_order_release);
+            return new_table;
+        }
+
+        [[nodiscard]] static auto find_entry(const Table* table, const StringView& value, const u64 hash) noexcept
+            -> const InternedEntry* {
+            if(table == nullptr) {
+                return nullptr;
+            }
+            const auto* slots = table->get_slots();
+            const auto mask = table->capacity - 1;
+            auto index = static_cast<usize>(hash) & mask;
+            while(true) {
+                const auto* entry = slots[index].load(std::memory_order_acquire);
+                if(entry == nullptr) {
+                    return nullptr;
+                }
+                if(entry->hash == hash && entry->length == value.length() &&
+                   memcmp(entry->data(), value.data(), value.length()) == 0) {
+                    return entry;
+                }
+                index = (index + 1) & mask;
+            }
+        }
+
+        auto destroy() noexcept -> void {
+            auto* table = _table.load(std::memory_order_relaxed);
+            while(table != nullptr) {
+                auto* previous = table->previous;
+                _allocator.free(table->get_memory());
+                table = previous;
+            }
+            while(_chunk != nullptr) {
+                auto* previous = _chunk->previous;
+                _allocator.free(_chunk->get_memory());
+                _chunk = previous;
+            }
+        }
+
+    public:
+        BasicInterner() noexcept
+            : _allocator()
+            , _mutex()
+            , _table(nullptr)
+            , _count(1)
+            , _chunk(nullptr)
+            , _chunk_position(nullptr)
+            , _chunk_end(nullptr)
+            , _memory_usage(0)
+            , _entries() {
+            _entries.push_back(&interner::empty_entry.header);
+        }
+
+        // Handles point into the arena, so an interner stays where it was created
+        KSTD_NO_MOVE_COPY(BasicInterner, self_type)
+
+        ~BasicInterner() noexcept {
+            destroy();
+        }
+
+        /**
+         * Looks up a string without inserting it. Never blocks.
+         *
+         * @param value The string to look up.
+         * @param result Receives the handle if the string was found.
+         * @return True if the string has been interned before.
+         */
+        [[nodiscard]] auto find(const StringView& value, InternedString& result) const noexcept -> bool {
+            if(value.length() == 0) {
+                result = InternedString();
+                return true;
+            }
+            const auto hash = hash_elements(value.data(), value.length());
+            const auto* entry = find_entry(_table.load(std::memory_order_acquire), value, hash);
+            if(entry == nullptr) {
+                return false;
+            }
+            result = InternedString(entry);
+            return true;
+        }
+
+        /**
+         * @param value The string to intern, it is copied into the arena if it is not interned yet.
+         * @return The unique handle for the given string.
+         */
+        [[nodiscard]] auto intern(const StringView& value) noexcept -> InternedString {
+            const auto length = value.length();
+            if(length == 0) {
+                return {};
+            }
+            if(length > static_cast<usize>(static_cast<u32>(-1))) {
+                panic("String is too long to be interned");
+            }
+            const auto hash = hash_elements(value.data(), length);
+            if(const auto* entry = find_entry(_table.load(std::memory_order_acquire), value, hash)) {
+                return InternedString(entry);
+            }
+
+            const std::lock_guard guard(_mutex);
+            // Another thread may have inserted the string in the meantime
+            auto* table = _table.load(std::memory_order_relaxed);
+            if(const auto* entry = find_entry(table, value, hash)) {
+                return InternedString(entry);
+            }
+            const auto count = _count.load(std::memory_order_relaxed);
+            if(count == static_cast<usize>(static_cast<u32>(-1))) {
+                panic("Interner exceeded the maximum number of strings");
+            }
+            // Keep the load factor below one half
+            if(table == nullptr || (count << 1) >= table->capacity) {
+                table = rehash(table);
+            }
+
+            auto* memory = allocate_entry(get_entry_size(length));
+            auto* entry = new(memory) InternedEntry {hash, static_cast<u32>(count), static_cast<u32>(length)};
+            auto* data = reinterpret_cast<char*>(entry + 1);
+            memcpy(data, value.data(), length);
+            data[length] = '\0';
+
+            _entries.push_back(entry);
+            insert_slot(table, entry);
+            _count.store(count + 1, std::memory_order_release);
+            return InternedString(entry);
+        }
+
+        /**
+         * @param id The id of a handle previously returned by this interner.
+         * @return The handle with the given id.
+         */
+        [[nodiscard]] auto resolve(const u32 id) const noexcept -> InternedString {
+            if(id >= _count.load(std::memory_order_acquire)) {
+                panic("Interned string id out of bounds");
+            }
+            return InternedString(_entries[id]);
+        }
+
+        /**
+         * @return The number of unique strings, including the empty string.
+         */
+        [[nodiscard]] auto size() const noexcept -> usize {
+            return _count.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @return The number of bytes allocated for the arena.
+         */
+        [[nodiscard]] auto get_memory_usage() const noexcept -> usize {
+            const std::lock_guard guard(_mutex);
+            return _memory_usage;
+        }
+    };
+
+    using Interner = BasicInterner<false>;
+    using ConcurrentInterner = BasicInterner<true>;
+}// namespace kstd
\ No newline at end of file
@@ -0,0 +1,345 @@
+// Copyright 2024 Karma Krafts & associates
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "Concepts.hpp"
+#include "Defaults.hpp"
+#include "FixedArray.hpp"
+#include "Panic.hpp"
+#include "Slice.hpp"
+#include "Types.hpp"
+
+namespace kstd {
+    /**
+     * A mapping from multi-dimensional indices to element offsets,
+     * using an explicit stride for every dimension.
+     *
+     * @tparam TRank The number of dimensions.
+     */
+    template<usize TRank>
+    class StridedMapping {
+    public:
+        using extents_type = FixedArray<usize, TRank>;
+
+    protected:
+        extents_type _extents;
+        extents_type _strides;
+
+    public:
+        StridedMapping(const extents_type& extents, const extents_type& strides) noexcept
+            : _extents(extents)
+            , _strides(strides) {
+        }
+
+        KSTD_DEFAULT_MOVE_COPY(StridedMapping, StridedMapping)
+        ~StridedMapping() noexcept = default;
+
+        [[nodiscard]] auto operator()(const extents_type& indices) const noexcept -> usize {
+            usize offset = 0;
+            for(usize i = 0; i < TRank; ++i) {
+                offset += indices[i] * _strides[i];
+            }
+            return offset;
+        }
+
+        [[nodiscard]] auto get_extents() const noexcept -> const extents_type& {
+            return _extents;
+        }
+
+        [[nodiscard]] auto get_strides() const noexcept -> const extents_type& {
+            return _strides;
+        }
+
+        [[nodiscard]] auto get_extent(const usize dimension) const noexcept -> usize {
+            return _extents[dimension];
+        }
+
+        [[nodiscard]] auto get_stride(const usize dimension) const noexcept -> usize {
+            return _strides[dimension];
+        }
+
+        /**
+         * @return The number of elements the underlying buffer must hold to cover every index.
+         */
+        [[nodiscard]] auto get_required_size() const noexcept -> usize {
+            usize size = 1;
+            for(usize i = 0; i < TRank; ++i) {
+                if(_extents[i] == 0) {
+                    return 0;
+                }
+                size += (_extents[i] - 1) * _strides[i];
+            }
+            return size;
+        }
+    };
+
+    /**
+     * The last dimension is contiguous in memory, like C arrays.
+     */
+    struct RowMajor final {
+        static constexpr bool has_strides = true;
+        static constexpr bool has_contiguous_rows = true;
+        static constexpr bool is_tiled = false;
+
+        template<usize TRank>
+        class Mapping final : public StridedMapping<TRank> {
+            using extents_type = typename StridedMapping<TRank>::extents_type;
+
+            [[nodiscard]] static auto get_default_strides(const extents_type& extents) noexcept -> extents_type {
+                extents_type strides {};
+                usize stride = 1;
+                for(usize i = TRank; i > 0; --i) {
+                    strides[i - 1] = stride;
+                    stride *= extents[i - 1];
+                }
+                return strides;
+            }
+
+        public:
+            explicit Mapping(const extents_type& extents) noexcept
+                : StridedMapping<TRank>(extents, get_default_strides(extents)) {
+            }
+        };
+    };
+
+    /**
+     * The first dimension is contiguous in memory, like Fortran arrays.
+     */
+    struct ColumnMajor final {
+        static constexpr bool has_strides = true;
+        static constexpr bool has_contiguous_rows = false;
+        static constexpr bool is_tiled = false;
+
+        template<usize TRank>
+        class Mapping final : public StridedMapping<TRank> {
+            using extents_type = typename StridedMapping<TRank>::extents_type;
+
+            [[nodiscard]] static auto get_default_strides(const extents_type& extents) noexcept -> extents_type {
+                extents_type strides {};
+                usize stride = 1;
+                for(usize i = 0; i < TRank; ++i) {
+                    strides[i] = stride;
+                    stride *= extents[i];
+                }
+                return strides;
+            }
+
+        public:
+            explicit Mapping(const extents_type& extents) noexcept
+                : StridedMapping<TRank>(extents, get_default_strides(extents)) {
+            }
+        };
+    };
+
+    /**
+     * Every dimension has an arbitrary stride, this is the result of taking a sub-view.
+     */
+    struct Strided final {
+        static constexpr bool has_strides = true;
+        static constexpr bool has_contiguous_rows = false;
+        static constexpr bool is_tiled = false;
+
+        template<usize TRank>
+        using Mapping = StridedMapping<TRank>;
+    };
+
+    /**
+     * A two-dimensional blocked layout. Tiles of TTileRows x TTileColumns elements
+     * are stored contiguously in row-major order, and so are the tiles themselves.
+     * The extents are padded up to a multiple of the tile size.
+     *
+     * @tparam TTileRows The number of rows per tile.
+     * @tparam TTileColumns The number of columns per tile.
+     */
+    template<usize TTileRows, usize TTileColumns>
+    struct Tiled final {
+        static constexpr bool has_strides = false;
+        static constexpr bool has_contiguous_rows = false;
+        static constexpr bool is_tiled = true;
+        static constexpr usize tile_rows = TTileRows;
+        static constexpr usize tile_columns = TTileColumns;
+        static constexpr usize tile_size = TTileRows * TTileColumns;
+
+        static_assert(TTileRows > 0 && TTileColumns > 0, "Tile size must not be zero");
+
+        template<usize TRank>
+        class Mapping final {
+            static_assert(TRank == 2, "Tiled layouts are only supported for two dimensions");
+
+        public:
+            using extents_type = FixedArray<usize, TRank>;
+
+        private:
+            extents_type _extents;
+            usize _tiles_per_row;
+
+        public:
+            explicit Mapping(const extents_type& extents) noexcept
+                : _extents(extents)
+                , _tiles_per_row((extents[1] + TTileColumns - 1) / TTileColumns) {
+            }
+
+            KSTD_DEFAULT_MOVE_COPY(Mapping, Mapping)
+            ~Mapping() noexcept = default;
+
+            [[nodiscard]] auto operator()(const extents_type& indices) const noexcept -> usize {
+                const auto row = indices[0];
+                const auto column = indices[1];
+                const auto tile_offset = get_tile_offset(row / TTileRows, column / TTileColumns);
+                return tile_offset + (row % TTileRows) * TTileColumns + (column % TTileColumns);
+            }
+
+            [[nodiscard]] auto get_tile_offset(const usize tile_row, const usize tile_column) const noexcept -> usize {
+                return (tile_row * _tiles_per_row + tile_column) * tile_size;
+            }
+
+            [[nodiscard]] auto get_extents() const noexcept -> const extents_type& {
+                return _extents;
+            }
+
+            [[nodiscard]] auto get_extent(const usize dimension) const noexcept -> usize {
+                return _extents[dimension];
+            }
+
+            [[nodiscard]] auto get_tile_count(const usize dimension) const noexcept -> usize {
+                return dimension == 0 ? (_extents[0] + TTileRows - 1) / TTileRows : _tiles_per_row;
+            }
+
+            [[nodiscard]] auto get_required_size() const noexcept -> usize {
+                return get_tile_count(0) * _tiles_per_row * tile_size;
+            }
+        };
+    };
+
+    /**
+     * A non-owning multi-dimensional view over a buffer.
+     *
+     * @tparam T The type of the viewed elements, use a const-qualified type for read-only views.
+     * @tparam TRank The number of dimensions.
+     * @tparam TLayout The layout policy which maps indices to offsets.
+     */
+    template<typename T, usize TRank, typename TLayout = RowMajor>
+    struct MdSlice final {
+        using value_type = T;
+        using layout_type = TLayout;
+        using mapping_type = typename TLayout::template Mapping<TRank>;
+        using extents_type = FixedArray<usize, TRank>;
+
+        static constexpr usize rank = TRank;
+
+        static_assert(TRank > 0, "MdSlice requires at least one dimension");
+
+    private:
+        T* _data;
+        mapping_type _mapping;
+
+        template<typename... TIndices>
+        [[nodiscard]] static auto make_indices(const TIndices... indices) noexcept -> extents_type {
+            extents_type result {};
+            result.insert_all(static_cast<usize>(indices)...);
+            return result;
+        }
+
+    public:
+        MdSlice(T* data, const mapping_type& mapping) noexcept
+            : _data(data)
+            , _mapping(mapping) {
+        }
+
+        MdSlice(T* data, const extents_type& extents) noexcept
+        requires(!is_same<TLayout, Strided>)
+            : _data(data)
+            , _mapping(extents) {
+        }
+
+        KSTD_DEFAULT_MOVE_COPY(MdSlice, MdSlice)
+        ~MdSlice() noexcept = default;
+
+        [[nodiscard]] auto data() const noexcept -> T* {
+            return _data;
+        }
+
+        [[nodiscard]] auto get_mapping() const noexcept -> const mapping_type& {
+            return _mapping;
+        }
+
+        [[nodiscard]] auto get_extent(const usize dimension) const noexcept -> usize {
+            return _mapping.get_extent(dimension);
+        }
+
+        [[nodiscard]] auto size() const noexcept -> usize {
+            usize result = 1;
+            for(usize i = 0; i < TRank; ++i) {
+                result *= _mapping.get_extent(i);
+            }
+            return result;
+        }
+
+        template<concepts::Integer... TIndices>
+        requires(sizeof...(TIndices) == TRank)
+        [[nodiscard]] auto operator()(const TIndices... indices) const noexcept -> T& {
+            return _data[_mapping(make_indices(indices...))];
+        }
+
+        template<concepts::Integer... TIndices>
+        requires(sizeof...(TIndices) == TRank)
+        [[nodiscard]] auto at(const TIndices... indices) const noexcept -> T& {
+            const auto index_array = make_indices(indices...);
+            for(usize i = 0; i < TRank; ++i) {
+                if(index_array[i] >= _mapping.get_extent(i)) {
+                    panic("MdSlice index out of bounds");
+                }
+            }
+            return _data[_mapping(index_array)];
+        }
+
+        /**
+         * @param indices The indices of all but the last dimension.
+         * @return A contiguous slice over the addressed innermost row.
+         */
+        template<concepts::Integer... TIndices>
+        requires(TLayout::has_contiguous_rows && sizeof...(TIndices) == TRank - 1)
+        [[nodiscard]] auto row(const TIndices... indices) const noexcept -> SliceMut<T> {
+            return {_data + _mapping(make_indices(indices..., 0)), _mapping.get_extent(TRank - 1)};
+        }
+
+        /**
+         * @param offsets The index of the first element of the sub-view in every dimension.
+         * @param extents The extents of the sub-view.
+         * @return A strided view over the given region which shares the underlying buffer.
+         */
+        [[nodiscard]] auto sub_view(const extents_type& offsets, const extents_type& extents) const noexcept
+            -> MdSlice<T, TRank, Strided>
+        requires(TLayout::has_strides)
+        {
+            for(usize i = 0; i < TRank; ++i) {
+                if(offsets[i] + extents[i] > _mapping.get_extent(i)) {
+                    panic("MdSlice sub-view out of bounds");
+                }
+            }
+            return {_data + _mapping(offsets), StridedMapping<TRank>(extents, _mapping.get_strides())};
+        }
+
+        /**
+         * @param tile_row The row index of the tile.
+         * @param tile_column The column index of the tile.
+         * @return A contiguous row-major view over a single tile.
+         */
+        [[nodiscard]] auto tile(const usize tile_row, const usize tile_column) const noexcept -> MdSlice<T, 2, RowMajor>
+        requires(TLayout::is_tiled)
+        {
+            return {_data + _mapping.get_tile_offset(tile_row, tile_column), make_indices(TLayout::tile_rows, TLayout::tile_columns)};
+        }
+    };
+}// namespace kstd
\ No newline at end of file
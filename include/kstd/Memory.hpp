@@ -34,6 +34,6 @@ namespace kstd {
 
     template<typename T>
     [[nodiscard]] constexpr T* align(T* pointer, const usize alignment) noexcept {
-        return reinterpret_cast<T*>((reinterpret_cast<usize>(pointer) + alignment - 1) & ~alignment);
+        return reinterpret_cast<T*>((reinterpret_cast<usize>(pointer) + alignment - 1) & ~(alignment - 1));
     }
 }
\ No newline at end of file
@@ -198,11 +198,15 @@ namespace kstd {
     template<typename TLeft, typename TRight>
     constexpr bool is_assignable = IsAssignable<TLeft, TRight>::value;
 
+    // IsTriviallyDefaultConstructible
+    template<typename T>
+    constexpr bool is_trivially_default_constructible = __is_trivially_constructible(T);
+
     // IsConvertible
     template<typename TTo, typename TFrom>
     struct IsConvertible {
         template<typename T, typename F>
-        static auto test(T) -> decltype(static_cast<T>(declval<F>()), TrueType{});
+        static auto test(int) -> decltype(static_cast<T>(declval<F>()), TrueType{});
 
         template<typename, typename>
         static auto test(...) -> FalseType;
@@ -0,0 +1,297 @@
+// Copyright 2024 Karma Krafts & associates
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+// NOLINTBEGIN
+#include <string.h>
+// NOLINTEND
+
+#include "Bits.hpp"
+#include "Concepts.hpp"
+#include "StringView.hpp"
+#include "Types.hpp"
+
+namespace kstd {
+    /**
+     * The outcome of parsing a number from the front of a string.
+     * A consumed count of zero means the string did not start with a number
+     * or the number was out of range for the requested type.
+     *
+     * @tparam T The type of the parsed value.
+     */
+    template<typename T>
+    struct ParseResult final {
+        T value;
+        usize consumed;
+
+        [[nodiscard]] constexpr auto is_valid() const noexcept -> bool {
+            return consumed != 0;
+        }
+    };
+
+    namespace concepts {
+        template<typename T>
+        concept Number = Signed<T> || Unsigned<T> || Float<T>;
+    }// namespace concepts
+
+    namespace number {
+        /**
+         * The number of characters the longest output of to_chars may occupy for the given type.
+         */
+        template<concepts::Number T>
+        static constexpr usize max_chars = concepts::Float<T> ? (sizeof(T) == 4 ? 15 : 24) : (sizeof(T) == 1 ? 4 : sizeof(T) == 2 ? 6 : sizeof(T) == 4 ? 11 : 20);
+
+        static constexpr u64 powers_of_ten[] = {
+                0,// Simplifies get_digit_count, see below
+                10ULL,
+                100ULL,
+                1000ULL,
+                10000ULL,
+                100000ULL,
+                1000000ULL,
+                10000000ULL,
+                100000000ULL,
+                1000000000ULL,
+                10000000000ULL,
+                100000000000ULL,
+                1000000000000ULL,
+                10000000000000ULL,
+                100000000000000ULL,
+                1000000000000000ULL,
+                10000000000000000ULL,
+                100000000000000000ULL,
+                1000000000000000000ULL,
+                10000000000000000000ULL,
+        };
+
+        static constexpr char digit_pairs[] = "00010203040506070809"
+                                              "10111213141516171819"
+                                              "20212223242526272829"
+                                              "30313233343536373839"
+                                              "40414243444546474849"
+                                              "50515253545556575859"
+                                              "60616263646566676869"
+                                              "70717273747576777879"
+                                              "80818283848586878889"
+                                              "90919293949596979899";
+
+        [[nodiscard]] constexpr auto is_digit(const char value) noexcept -> bool {
+            return static_cast<u8>(value - '0') < 10;
+        }
+
+        /**
+         * @return The number of decimal digits of the given value, without branching on its magnitude.
+         */
+        [[nodiscard]] constexpr auto get_digit_count(const u64 value) noexcept -> usize {
+            // 1233 / 4096 approximates log10(2), which may overestimate by one
+            const auto estimate = ((64 - bits::count_leading_zeros(value | 1)) * 1233) >> 12;
+            return estimate - (value < powers_of_ten[estimate]) + 1;
+        }
+
+        /**
+         * Loads eight characters as a little-endian word, the caller has to make sure they are readable.
+         */
+        [[nodiscard]] inline auto read_eight(const char* data) noexcept -> u64 {
+            u64 value;
+            memcpy(&value, data, sizeof(u64));
+            return value;
+        }
+
+        /**
+         * Checks eight characters at once for being decimal digits, SIMD within a register.
+         */
+        [[nodiscard]] constexpr auto is_eight_digits(const u64 value) noexcept -> bool {
+            return (((value & 0xF0F0F0F0F0F0F0F0ULL) | (((value + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) ==
+                    0x3333333333333333ULL);
+        }
+
+        /**
+         * Converts eight decimal digits to their value in three multiplications,
+         * combining neighbouring digits, then pairs, then quadruples.
+         */
+        [[nodiscard]] constexpr auto parse_eight_digits(u64 value) noexcept -> u32 {
+            constexpr u64 mask = 0x000000FF000000FFULL;
+            constexpr u64 multiplier_low = 100 + (1000000ULL << 32);
+            constexpr u64 multiplier_high = 1 + (10000ULL << 32);
+            value -= 0x3030303030303030ULL;
+            value = (value * 10) + (value >> 8);
+            return static_cast<u32>((((value & mask) * multiplier_low) + (((value >> 16) & mask) * multiplier_high)) >> 32);
+        }
+
+        /**
+         * Parses a run of decimal digits into the given accumulator, eight at a time where possible.
+         * Only the lowest 64 bits of the result are kept.
+         *
+         * @return A pointer past the last digit.
+         */
+        [[nodiscard]] inline auto parse_digits(const char* begin, const char* end, u64& value) noexcept -> const char* {
+            auto* current = begin;
+            while(end - current >= 8) {
+                const auto chunk = read_eight(current);
+                if(!is_eight_digits(chunk)) {
+                    break;
+                }
+                value = value * 100000000ULL + parse_eight_digits(chunk);
+                current += 8;
+            }
+            while(current != end && is_digit(*current)) {
+                value = value * 10 + static_cast<u64>(*current - '0');
+                ++current;
+            }
+            return current;
+        }
+
+        /**
+         * Writes the decimal digits of the given value, which must occupy exactly count characters.
+         */
+        inline auto write_digits(char* buffer, u64 value, const usize count) noexcept -> void {
+            auto* current = buffer + count;
+            while(value >= 100) {
+                const auto index = (value % 100) << 1;
+                value /= 100;
+                current -= 2;
+                memcpy(current, digit_pairs + index, 2);
+            }
+            if(value >= 10) {
+                memcpy(current - 2, digit_pairs + (value << 1), 2);
+            }
+            else {
+                *(current - 1) = static_cast<char>('0' + value);
+            }
+        }
+
+        auto parse_float(const char* begin, const char* end, f32& value) noexcept -> usize;
+        auto parse_float(const char* begin, const char* end, f64& value) noexcept -> usize;
+        auto format_float(char* buffer, f32 value) noexcept -> usize;
+        auto format_float(char* buffer, f64 value) noexcept -> usize;
+    }// namespace number
+
+    /**
+     * Parses an integer from the front of the given string, in the style of from_chars.
+     * An optional minus sign is accepted for signed types, leading whitespace and plus signs are not.
+     *
+     * @tparam T The integer type to parse.
+     * @param value The string to parse.
+     * @return The parsed value and the number of consumed characters, which is zero on failure or overflow.
+     */
+    template<concepts::Number T>
+    requires(!concepts::Float<T>)
+    [[nodiscard]] auto parse(const StringView& value) noexcept -> ParseResult<T> {
+        constexpr auto bits = sizeof(T) << 3;
+        const auto* begin = value.data();
+        const auto* end = begin + value.length();
+        const auto* current = begin;
+        auto is_negative = false;
+        if constexpr(concepts::Signed<T>) {
+            if(current != end && *current == '-') {
+                is_negative = true;
+                ++current;
+            }
+        }
+        const auto* digits_begin = current;
+        while(current != end && *current == '0') {
+            ++current;
+        }
+        const auto* significant_begin = current;
+        u64 magnitude = 0;
+        current = number::parse_digits(current, end, magnitude);
+        if(current == digits_begin) {
+            return {T {}, 0};
+        }
+        const auto digit_count = static_cast<usize>(current - significant_begin);
+        if(digit_count > 20) {
+            return {T {}, 0};
+        }
+        if(digit_count == 20) {
+            // Only 20-digit values may have wrapped around, redo the last step with an explicit check
+            u64 prefix = 0;
+            static_cast<void>(number::parse_digits(significant_begin, significant_begin + 19, prefix));
+            constexpr auto max_prefix = ~u64 {0} / 10;
+            const auto last = static_cast<u64>(significant_begin[19] - '0');
+            if(prefix > max_prefix || (prefix == max_prefix && last > ~u64 {0} % 10)) {
+                return {T {}, 0};
+            }
+        }
+        const auto consumed = static_cast<usize>(current - begin);
+        if constexpr(concepts::Signed<T>) {
+            const auto limit = (u64 {1} << (bits - 1)) - !is_negative;
+            if(magnitude > limit) {
+                return {T {}, 0};
+            }
+            return {static_cast<T>(is_negative ? ~magnitude + 1 : magnitude), consumed};
+        }
+        else {
+            if constexpr(bits < 64) {
+                if(magnitude > (~u64 {0} >> (64 - bits))) {
+                    return {T {}, 0};
+                }
+            }
+            return {static_cast<T>(magnitude), consumed};
+        }
+    }
+
+    /**
+     * Parses a floating point number from the front of the given string, in the style of from_chars.
+     * Accepts decimal and scientific notation as well as inf, infinity and nan in any case,
+     * each with an optional minus sign. The result is always correctly rounded;
+     * the common case is handled by the Eisel-Lemire algorithm without any big number arithmetic.
+     *
+     * @tparam T The floating point type to parse.
+     * @param value The string to parse.
+     * @return The parsed value and the number of consumed characters, which is zero on failure.
+     */
+    template<concepts::Float T>
+    [[nodiscard]] auto parse(const StringView& value) noexcept -> ParseResult<T> {
+        T result {};
+        const auto consumed = number::parse_float(value.data(), value.data() + value.length(), result);
+        return {result, consumed};
+    }
+
+    /**
+     * Writes the decimal representation of the given integer.
+     *
+     * @param buffer The buffer to write into, which needs room for number::max_chars<T> characters.
+     * @param value The value to format.
+     * @return The number of written characters, no terminator is written.
+     */
+    template<concepts::Number T>
+    requires(!concepts::Float<T>)
+    auto to_chars(char* buffer, const T value) noexcept -> usize {
+        auto magnitude = static_cast<u64>(value);
+        usize offset = 0;
+        if constexpr(concepts::Signed<T>) {
+            if(value < 0) {
+                buffer[offset++] = '-';
+                magnitude = ~magnitude + 1;
+            }
+        }
+        const auto count = number::get_digit_count(magnitude);
+        number::write_digits(buffer + offset, magnitude, count);
+        return offset + count;
+    }
+
+    /**
+     * Writes the shortest decimal representation which parses back to exactly the given value,
+     * choosing between decimal and scientific notation by length like to_chars.
+     *
+     * @param buffer The buffer to write into, which needs room for number::max_chars<T> characters.
+     * @param value The value to format.
+     * @return The number of written characters, no terminator is written.
+     */
+    template<concepts::Float T>
+    auto to_chars(char* buffer, const T value) noexcept -> usize {
+        return number::format_float(buffer, value);
+    }
+}// namespace kstd
\ No newline at end of file
@@ -44,11 +44,49 @@ namespace kstd {
     template<usize TCount, typename... TTypes>
     struct LeftTrimPackImpl;
 
+    template<usize TCount, typename THead, typename... TTail>
+    requires(TCount > 0)
+    struct LeftTrimPackImpl<TCount, THead, TTail...> : LeftTrimPackImpl<TCount - 1, TTail...> {};
+
+    template<typename... TTypes>
+    struct LeftTrimPackImpl<0, TTypes...> {
+        using type = Pack<TTypes...>;
+    };
+
+    template<usize TCount, typename... TTypes>
+    using LeftTrimPack = typename LeftTrimPackImpl<TCount, TTypes...>::type;
+
     // RightTrimPack
+    template<usize TCount, typename TAccumulator, typename... TTypes>
+    struct TakePackImpl;
+
+    template<usize TCount, typename... TAccumulated, typename THead, typename... TTail>
+    requires(TCount > 0)
+    struct TakePackImpl<TCount, Pack<TAccumulated...>, THead, TTail...> : TakePackImpl<TCount - 1, Pack<TAccumulated..., THead>, TTail...> {};
+
+    template<typename... TAccumulated, typename... TTail>
+    struct TakePackImpl<0, Pack<TAccumulated...>, TTail...> {
+        using type = Pack<TAccumulated...>;
+    };
+
+    template<usize TCount, typename... TTypes>
+    struct RightTrimPackImpl : TakePackImpl<sizeof...(TTypes) - TCount, Pack<>, TTypes...> {
+        static_assert(TCount <= sizeof...(TTypes), "Cannot trim more types than the pack contains");
+    };
+
     template<usize TCount, typename... TTypes>
-    struct RightTrimPackImpl;
+    using RightTrimPack = typename RightTrimPackImpl<TCount, TTypes...>::type;
 
     // SlicePack
     template<usize TStart, usize TEnd, typename... TTypes>
-    struct SlicePack;
+    struct SlicePackImpl : TakePackImpl<TEnd - TStart, Pack<>, TTypes...> {
+        static_assert(TStart <= TEnd && TEnd <= sizeof...(TTypes), "Pack slice out of bounds");
+    };
+
+    template<usize TStart, usize TEnd, typename THead, typename... TTail>
+    requires(TStart > 0)
+    struct SlicePackImpl<TStart, TEnd, THead, TTail...> : SlicePackImpl<TStart - 1, TEnd - 1, TTail...> {};
+
+    template<usize TStart, usize TEnd, typename... TTypes>
+    using SlicePack = typename SlicePackImpl<TStart, TEnd, TTypes...>::type;
 }// namespace kstd
\ No newline at end of file
@@ -0,0 +1,231 @@
+// Copyright 2024 Karma Krafts & associates
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include "Defaults.hpp"
+#include "FixedArray.hpp"
+#include "Hash.hpp"
+#include "Math.hpp"
+#include "Panic.hpp"
+#include "StringView.hpp"
+#include "Types.hpp"
+
+namespace kstd {
+    namespace perfect_hash {
+        static constexpr usize npos = static_cast<usize>(-1);
+        static constexpr u32 empty_slot = ~u32 {0};
+        static constexpr u32 max_pilot = 1U << 16;
+        static constexpr u64 max_attempts = 64;
+
+        [[nodiscard]] constexpr auto get_slot_count(const usize size) noexcept -> usize {
+            // Keep the load at or below 80% so pilot searches stay short
+            usize count = 2;
+            while(count * 4 < size * 5) {
+                count <<= 1;
+            }
+            return count;
+        }
+
+        [[nodiscard]] constexpr auto get_slot_shift(const usize slot_count) noexcept -> usize {
+            usize shift = 64;
+            for(auto count = slot_count; count > 1; count >>= 1) {
+                --shift;
+            }
+            return shift;
+        }
+
+        [[nodiscard]] constexpr auto get_bucket_count(const usize size) noexcept -> usize {
+            return size < 3 ? 1 : size / 3;
+        }
+    }// namespace perfect_hash
+
+    /**
+     * An immutable map from a constant set of strings to values, built entirely at compile time.
+     * Keys are first hashed into buckets, then every bucket gets a pilot which moves all of its
+     * keys into free slots (hash and displace, like CHD and PTHash). A lookup is one hash,
+     * one table probe and a single key comparison, regardless of the number of keys.
+     *
+     * @tparam TValue The type of the mapped values.
+     * @tparam TSize The number of keys.
+     */
+    template<typename TValue, usize TSize>
+    struct PerfectHashMap final {
+        using key_type = StringView;
+        using value_type = TValue;
+
+        static constexpr usize npos = perfect_hash::npos;
+        static constexpr usize slot_count = perfect_hash::get_slot_count(TSize);
+        static constexpr usize bucket_count = perfect_hash::get_bucket_count(TSize);
+
+        static_assert(TSize > 0, "Perfect hash map requires at least one key");
+        static_assert(TSize < perfect_hash::empty_slot, "Too many keys for a perfect hash map");
+
+    private:
+        static constexpr usize slot_shift = perfect_hash::get_slot_shift(slot_count);
+
+        FixedArray<key_type, TSize> _keys;
+        FixedArray<value_type, TSize> _values;
+        FixedArray<u64, bucket_count> _displacements;
+        FixedArray<u32, slot_count> _slots;
+        u64 _seed;
+
+        [[nodiscard]] static constexpr auto get_bucket(const u64 hash) noexcept -> usize {
+            // The upper half picks the bucket, the displaced lower half picks the slot
+            return static_cast<usize>((hash >> 32) % bucket_count);
+        }
+
+        [[nodiscard]] static constexpr auto get_slot(const u64 hash, const u64 displacement) noexcept -> usize {
+            // Multiplying moves differences in any bit into the top bits, so keys sharing low bits still separate
+            return static_cast<usize>(((hash ^ displacement) * hash::secret) >> slot_shift);
+        }
+
+        [[nodiscard]] static constexpr auto get_displacement(const u32 pilot) noexcept -> u64 {
+            return hash::mix(pilot, hash::secret);
+        }
+
+        /**
+         * @return True if a pilot was found for every bucket using the given seed.
+         */
+        [[nodiscard]] constexpr auto try_build(const u64 seed) noexcept -> bool {
+            FixedArray<u64, TSize> hashes {};
+            FixedArray<usize, bucket_count + 1> bucket_offsets {};
+            for(usize i = 0; i < TSize; ++i) {
+                hashes[i] = hash_elements(_keys[i].data(), _keys[i].length(), seed);
+                ++bucket_offsets[get_bucket(hashes[i]) + 1];
+            }
+            usize max_bucket_size = 0;
+            for(usize bucket = 0; bucket < bucket_count; ++bucket) {
+                max_bucket_size = max(max_bucket_size, bucket_offsets[bucket + 1]);
+                bucket_offsets[bucket + 1] += bucket_offsets[bucket];
+            }
+
+            // Group the keys by bucket
+            FixedArray<u32, TSize> bucket_keys {};
+            FixedArray<usize, bucket_count> bucket_fill {};
+            for(usize i = 0; i < TSize; ++i) {
+                const auto bucket = get_bucket(hashes[i]);
+                bucket_keys[bucket_offsets[bucket] + bucket_fill[bucket]++] = static_cast<u32>(i);
+            }
+
+            for(usize slot = 0; slot < slot_count; ++slot) {
+                _slots[slot] = perfect_hash::empty_slot;
+            }
+
+            // Place the largest buckets first while most slots are still free
+            for(auto size = max_bucket_size; size > 0; --size) {
+                for(usize bucket = 0; bucket < bucket_count; ++bucket) {
+                    const auto begin = bucket_offsets[bucket];
+                    if(bucket_offsets[bucket + 1] - begin != size) {
+                        continue;
+                    }
+                    auto is_placed = false;
+                    for(u32 pilot = 0; pilot < perfect_hash::max_pilot; ++pilot) {
+                        const auto displacement = get_displacement(pilot);
+                        usize placed = 0;
+                        for(; placed < size; ++placed) {
+                            const auto slot = get_slot(hashes[bucket_keys[begin + placed]], displacement);
+                            if(_slots[slot] != perfect_hash::empty_slot) {
+                                break;
+                            }
+                            _slots[slot] = bucket_keys[begin + placed];
+                        }
+                        if(placed == size) {
+                            _displacements[bucket] = displacement;
+                            is_placed = true;
+                            break;
+                        }
+                        // Roll back the partial placement
+                        for(usize i = 0; i < placed; ++i) {
+                            _slots[get_slot(hashes[bucket_keys[begin + i]], displacement)] = perfect_hash::empty_slot;
+                        }
+                    }
+                    if(!is_placed) {
+                        // Only identical hashes make this happen, reject duplicates before trying the next seed
+                        for(usize i = begin; i < begin + size; ++i) {
+                            for(usize j = i + 1; j < begin + size; ++j) {
+                                if(_keys[bucket_keys[i]] == _keys[bucket_keys[j]]) {
+                                    panic("Duplicate key in perfect hash map");
+                                }
+                            }
+                        }
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+    public:
+        /**
+         * Builds the table, meant to be evaluated at compile time.
+         *
+         * @param keys The keys, which must be unique.
+         * @param values The value for every key, at the same index.
+         */
+        constexpr PerfectHashMap(const FixedArray<key_type, TSize>& keys, const FixedArray<value_type, TSize>& values) noexcept
+            : _keys(keys)
+            , _values(values)
+            , _displacements()
+            , _slots()
+            , _seed(hash::default_seed) {
+            for(u64 attempt = 0; attempt < perfect_hash::max_attempts; ++attempt) {
+                _seed = hash::default_seed + attempt;
+                if(try_build(_seed)) {
+                    return;
+                }
+            }
+            panic("Could not build perfect hash map");
+        }
+
+        KSTD_DEFAULT_MOVE_COPY(PerfectHashMap, PerfectHashMap, constexpr)
+        ~PerfectHashMap() noexcept = default;
+
+        /**
+         * @return The index of the given key in the key array the map was built from, or npos.
+         */
+        [[nodiscard]] constexpr auto find_index(const key_type& key) const noexcept -> usize {
+            const auto hash = hash_elements(key.data(), key.length(), _seed);
+            const auto index = _slots[get_slot(hash, _displacements[get_bucket(hash)])];
+            if(index == perfect_hash::empty_slot || !(_keys[index] == key)) {
+                return npos;
+            }
+            return index;
+        }
+
+        /**
+         * @return A pointer to the value of the given key, or null if the key is not in the map.
+         */
+        [[nodiscard]] constexpr auto find(const key_type& key) const noexcept -> const value_type* {
+            const auto index = find_index(key);
+            return index == npos ? nullptr : &_values[index];
+        }
+
+        [[nodiscard]] constexpr auto contains(const key_type& key) const noexcept -> bool {
+            return find_index(key) != npos;
+        }
+
+        [[nodiscard]] constexpr auto get_key(const usize index) const noexcept -> const key_type& {
+            return _keys[index];
+        }
+
+        [[nodiscard]] constexpr auto get_value(const usize index) const noexcept -> const value_type& {
+            return _values[index];
+        }
+
+        [[nodiscard]] constexpr auto size() const noexcept -> usize {
+            return TSize;
+        }
+    };
+}// namespace kstd
\ No newline at end of file
@@ -0,0 +1,84 @@
+// Copyright 2024 Karma Krafts & associates
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include "Types.hpp"
+
+namespace kstd::profiler {
+    /**
+     * The maximum number of frames recorded per sample, deeper stacks are cut off at the outermost frames.
+     */
+    constexpr usize max_depth = 64;
+
+    /**
+     * The number of samples every thread can buffer until the aggregator drains them.
+     */
+    constexpr usize ring_capacity = 128;
+
+    /**
+     * Starts sampling all registered threads by their consumed CPU time.
+     * On Linux every thread gets its own timer, so each of them is sampled at the given
+     * frequency. Other Unix systems share one process-wide profiling timer, which the
+     * kernel delivers to whichever thread is running.
+     *
+     * Samples are captured with StackTrace::capture in the signal handler, so the active
+     * UnwindMode applies, and are drained into an aggregate of unique stacks by a background thread.
+     *
+     * @param frequency The number of samples per second of CPU time.
+     * @return True if the profiler was started, false if it is running already or unsupported.
+     */
+    auto start(usize frequency = 100) noexcept -> bool;
+
+    /**
+     * Stops sampling and aggregates all remaining samples. The aggregate is kept until reset is called.
+     */
+    auto stop() noexcept -> void;
+
+    [[nodiscard]] auto is_running() noexcept -> bool;
+
+    /**
+     * Allocates the sample buffer of the calling thread. Only registered threads are sampled,
+     * and every registered thread has to call unregister_thread before it exits.
+     */
+    auto register_thread() noexcept -> bool;
+
+    auto unregister_thread() noexcept -> void;
+
+    /**
+     * @return The number of samples aggregated so far.
+     */
+    [[nodiscard]] auto get_sample_count() noexcept -> usize;
+
+    /**
+     * @return The number of samples lost because a buffer was full or the thread was not registered.
+     */
+    [[nodiscard]] auto get_dropped_count() noexcept -> usize;
+
+    /**
+     * Discards the aggregated samples.
+     */
+    auto reset() noexcept -> void;
+
+    /**
+     * Writes the aggregate as folded stacks, one "outer;...;inner count" line per unique stack,
+     * which is the input format of flamegraph.pl and most other flame graph tools.
+     */
+    auto write_folded(const char* path) noexcept -> bool;
+
+    /**
+     * Writes the aggregate as an uncompressed pprof profile with samples/count and cpu/nanoseconds values.
+     */
+    auto write_pprof(const char* path) noexcept -> bool;
+}// namespace kstd::profiler
\ No newline at end of file
@@ -0,0 +1,441 @@
+// Copyright 2024 Karma Krafts & associates
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include "Allocator.hpp"
+#include "Atomic.hpp"
+#include "Concepts.hpp"
+#include "Defaults.hpp"
+#include "FixedArray.hpp"
+#include "Math.hpp"
+#include "Panic.hpp"
+#include "String.hpp"
+#include "StringView.hpp"
+#include "Types.hpp"
+#include "Utility.hpp"
+
+namespace kstd {
+    /**
+     * An immutable string stored as a height-balanced tree of shared leaves.
+     * Concatenation and sub-ranges build new trees which share all untouched
+     * nodes with their inputs, so both run in O(log n) regardless of the length.
+     * Nodes are reference counted atomically, ropes may be shared between threads.
+     *
+     * @tparam T The character type of the rope.
+     */
+    template<concepts::Integer T>
+    struct BasicRope final {
+        using char_type = T;
+        using view_type = BasicStringView<char_type>;
+        using string_type = BasicString<char_type>;
+
+        static constexpr usize max_leaf_length = 512;
+        static constexpr usize max_height = 96;// Enough for any length addressable by usize
+
+    private:
+        using self_type = BasicRope<T>;
+
+        struct Node final {
+            Atomic<usize> ref_count;
+            usize length;
+            usize height;
+            Node* left; // Null for leaves
+            Node* right;// Null for leaves
+
+            [[nodiscard]] auto is_leaf() const noexcept -> bool {
+                return left == nullptr;
+            }
+
+            [[nodiscard]] auto get_data() const noexcept -> const T* {
+                return reinterpret_cast<const T*>(this + 1);
+            }
+        };
+
+        Node* _root;
+
+        [[nodiscard]] static auto allocate_node(const usize leaf_length) noexcept -> Node* {
+            Allocator<u8> allocator {};
+            return reinterpret_cast<Node*>(allocator.allocate(sizeof(Node) + leaf_length * sizeof(T)));
+        }
+
+        [[nodiscard]] static auto make_leaf(const T* data, const usize length) noexcept -> Node* {
+            auto* node = new(allocate_node(length)) Node {1, length, 0, nullptr, nullptr};
+            memcpy(const_cast<T*>(node->get_data()), data, length * sizeof(T));
+            return node;
+        }
+
+        /**
+         * Takes ownership of one reference to each child.
+         */
+        [[nodiscard]] static auto make_branch(Node* left, Node* right) noexcept -> Node* {
+            const auto height = max(left->height, right->height) + 1;
+            return new(allocate_node(0)) Node {1, left->length + right->length, height, left, right};
+        }
+
+        static auto acquire(Node* node) noexcept -> Node* {
+            if(node != nullptr) {
+                node->ref_count.fetch_add(1, std::memory_order_relaxed);
+            }
+            return node;
+        }
+
+        static auto release(Node* node) noexcept -> void {
+            if(node == nullptr || node->ref_count.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+                return;
+            }
+            if(!node->is_leaf()) {
+                release(node->left);
+                release(node->right);
+            }
+            node->~Node();
+            Allocator<u8> allocator {};
+            allocator.free(reinterpret_cast<u8*>(node));
+        }
+
+        [[nodiscard]] static auto get_height(const Node* node) noexcept -> usize {
+            return node == nullptr ? 0 : node->height;
+        }
+
+        /**
+         * Builds a balanced tree over the given text by halving it until it fits into leaves.
+         */
+        [[nodiscard]] static auto build(const T* data, const usize length) noexcept -> Node* {
+            if(length <= max_leaf_length) {
+                return make_leaf(data, length);
+            }
+            const auto half = length >> 1;
+            return make_branch(build(data, half), build(data + half, length - half));
+        }
+
+        /**
+         * Creates a branch and restores the AVL invariant with at most a double rotation.
+         * Takes ownership of one reference to each child.
+         */
+        [[nodiscard]] static auto make_balanced(Node* left, Node* right) noexcept -> Node* {
+            if(left->height > right->height + 1) {
+                // Left-heavy; rotated nodes are rebuilt since nodes are shared and immutable
+                auto* outer = acquire(left->left);
+                auto* inner = acquire(left->right);
+                release(left);
+                if(get_height(outer) >= get_height(inner)) {
+                    return make_branch(outer, make_branch(inner, right));
+                }
+                auto* inner_left = acquire(inner->left);
+                auto* inner_right = acquire(inner->right);
+                release(inner);
+                return make_branch(make_branch(outer, inner_left), make_branch(inner_right, right));
+            }
+            if(right->height > left->height + 1) {
+                auto* outer = acquire(right->right);
+                auto* inner = acquire(right->left);
+                release(right);
+                if(get_height(outer) >= get_height(inner)) {
+                    return make_branch(make_branch(left, inner), outer);
+                }
+                auto* inner_left = acquire(inner->left);
+                auto* inner_right = acquire(inner->right);
+                release(inner);
+                return make_branch(make_branch(left, inner_left), make_branch(inner_right, outer));
+            }
+            return make_branch(left, right);
+        }
+
+        /**
+         * Joins two trees in O(|height(left) - height(right)|), descending the taller one.
+         * Takes ownership of one reference to each tree.
+         */
+        [[nodiscard]] static auto join(Node* left, Node* right) noexcept -> Node* {
+            if(left == nullptr || left->length == 0) {
+                release(left);
+                return right;
+            }
+            if(right == nullptr || right->length == 0) {
+                release(right);
+                return left;
+            }
+            if(left->is_leaf() && right->is_leaf() && left->length + right->length <= max_leaf_length) {
+                // Merge small neighbours so repeated appends do not degenerate into tiny leaves
+                auto* node = new(allocate_node(left->length + right->length)) Node {1, left->length + right->length, 0, nullptr, nullptr};
+                auto* data = const_cast<T*>(node->get_data());
+                memcpy(data, left->get_data(), left->length * sizeof(T));
+                memcpy(data + left->length, right->get_data(), right->length * sizeof(T));
+                release(left);
+                release(right);
+                return node;
+            }
+            if(left->height > right->height + 1) {
+                auto* left_left = acquire(left->left);
+                auto* left_right = acquire(left->right);
+                release(left);
+                return make_balanced(left_left, join(left_right, right));
+            }
+            if(right->height > left->height + 1) {
+                auto* right_left = acquire(right->left);
+                auto* right_right = acquire(right->right);
+                release(right);
+                return make_balanced(join(left, right_left), right_right);
+            }
+            return make_branch(left, right);
+        }
+
+        /**
+         * @return A new reference to a tree holding the characters [start, end) of the given node.
+         */
+        [[nodiscard]] static auto slice(Node* node, const usize start, const usize end) noexcept -> Node* {
+            if(start == 0 && end == node->length) {
+                return acquire(node);
+            }
+            if(start >= end) {
+                return nullptr;
+            }
+            if(node->is_leaf()) {
+                return make_leaf(node->get_data() + start, end - start);
+            }
+            const auto split = node->left->length;
+            if(end <= split) {
+                return slice(node->left, start, end);
+            }
+            if(start >= split) {
+                return slice(node->right, start - split, end - split);
+            }
+            return join(slice(node->left, start, split), slice(node->right, 0, end - split));
+        }
+
+        explicit BasicRope(Node* root) noexcept
+            : _root(root) {
+        }
+
+    public:
+        /**
+         * Iterates the leaves of a rope in order, yielding one view per leaf.
+         */
+        class ChunkIterator final {
+            FixedArray<const Node*, max_height> _stack;
+            usize _depth;
+
+            auto descend(const Node* node) noexcept -> void {
+                while(node != nullptr) {
+                    _stack[_depth++] = node;
+                    node = node->left;
+                }
+            }
+
+        public:
+            explicit ChunkIterator(const Node* root) noexcept
+                : _stack()
+                , _depth(0) {
+                descend(root);
+            }
+
+            KSTD_DEFAULT_MOVE_COPY(ChunkIterator, ChunkIterator)
+            ~ChunkIterator() noexcept = default;
+
+            [[nodiscard]] auto operator==(const ChunkIterator& other) const noexcept -> bool {
+                if(_depth == 0 || other._depth == 0) {
+                    return _depth == other._depth;
+                }
+                return _stack[_depth - 1] == other._stack[other._depth - 1];
+            }
+
+            auto operator++() noexcept -> ChunkIterator& {
+                // The top of the stack is a leaf, continue with the right subtree of the closest branch
+                --_depth;
+                if(_depth != 0) {
+                    const auto* parent = _stack[--_depth];
+                    descend(parent->right);
+                }
+                return *this;
+            }
+
+            [[nodiscard]] auto operator*() const noexcept -> view_type {
+                const auto* node = _stack[_depth - 1];
+                return {node->get_data(), node->length};
+            }
+        };
+
+        class ChunkRange final {
+            const Node* _root;
+
+        public:
+            explicit ChunkRange(const Node* root) noexcept
+                : _root(root) {
+            }
+
+            KSTD_DEFAULT_MOVE_COPY(ChunkRange, ChunkRange)
+            ~ChunkRange() noexcept = default;
+
+            [[nodiscard]] auto begin() const noexcept -> ChunkIterator {
+                return ChunkIterator(_root);
+            }
+
+            [[nodiscard]] auto end() const noexcept -> ChunkIterator {
+                return ChunkIterator(nullptr);
+            }
+        };
+
+        BasicRope() noexcept
+            : _root(nullptr) {
+        }
+
+        explicit BasicRope(const view_type& value) noexcept
+            : _root(value.length() == 0 ? nullptr : build(value.data(), value.length())) {
+        }
+
+        BasicRope(const self_type& other) noexcept
+            : _root(acquire(other._root)) {
+        }
+
+        BasicRope(self_type&& other) noexcept
+            : _root(other._root) {
+            other._root = nullptr;
+        }
+
+        ~BasicRope() noexcept {
+            release(_root);
+        }
+
+        auto operator=(const self_type& other) noexcept -> self_type& {
+            if(&other == this) {
+                return *this;
+            }
+            release(_root);
+            _root = acquire(other._root);
+            return *this;
+        }
+
+        auto operator=(self_type&& other) noexcept -> self_type& {
+            if(&other == this) {
+                return *this;
+            }
+            release(_root);
+            _root = other._root;
+            other._root = nullptr;
+            return *this;
+        }
+
+        [[nodiscard]] auto length() const noexcept -> usize {
+            return _root == nullptr ? 0 : _root->length;
+        }
+
+        [[nodiscard]] auto is_empty() const noexcept -> bool {
+            return length() == 0;
+        }
+
+        /**
+         * @return The height of the tree, zero for ropes which fit into a single leaf.
+         */
+        [[nodiscard]] auto get_height() const noexcept -> usize {
+            return get_height(_root);
+        }
+
+        /**
+         * @return A rope holding this rope followed by the other one.
+         */
+        [[nodiscard]] auto concat(const self_type& other) const noexcept -> self_type {
+            return self_type(join(acquire(_root), acquire(other._root)));
+        }
+
+        [[nodiscard]] auto operator+(const self_type& other) const noexcept -> self_type {
+            return concat(other);
+        }
+
+        /**
+         * @param start The index of the first character, clamped to the length.
+         * @param count The maximum number of characters.
+         * @return A rope sharing the nodes of this rope which lie entirely inside the range.
+         */
+        [[nodiscard]] auto substr(const usize start, const usize count = static_cast<usize>(-1)) const noexcept -> self_type {
+            const auto size = length();
+            const auto begin = min(start, size);
+            const auto end = begin + min(count, size - begin);
+            if(_root == nullptr || begin == end) {
+                return {};
+            }
+            return self_type(slice(_root, begin, end));
+        }
+
+        [[nodiscard]] auto operator[](const usize index) const noexcept -> T {
+            const auto* node = _root;
+            auto offset = index;
+            while(!node->is_leaf()) {
+                const auto split = node->left->length;
+                if(offset < split) {
+                    node = node->left;
+                }
+                else {
+                    offset -= split;
+                    node = node->right;
+                }
+            }
+            return node->get_data()[offset];
+        }
+
+        [[nodiscard]] auto at(const usize index) const noexcept -> T {
+            if(index >= length()) {
+                panic("Rope index out of bounds");
+            }
+            return (*this)[index];
+        }
+
+        /**
+         * @return A range over the leaves of this rope, as views.
+         */
+        [[nodiscard]] auto chunks() const noexcept -> ChunkRange {
+            return ChunkRange(_root);
+        }
+
+        auto copy_to(T* dst, const usize size) const noexcept -> usize {
+            usize offset = 0;
+            for(const auto chunk : chunks()) {
+                const auto count = min(chunk.length(), size - offset);
+                memcpy(dst + offset, chunk.data(), count * sizeof(T));
+                offset += count;
+                if(offset == size) {
+                    break;
+                }
+            }
+            return offset;
+        }
+
+        [[nodiscard]] auto flatten() const noexcept -> string_type {
+            string_type result {};
+            result.reserve(length());
+            for(const auto chunk : chunks()) {
+                result.append(chunk);
+            }
+            return result;
+        }
+
+        [[nodiscard]] auto operator==(const view_type& other) const noexcept -> bool {
+            if(other.length() != length()) {
+                return false;
+            }
+            usize offset = 0;
+            for(const auto chunk : chunks()) {
+                if(memcmp(chunk.data(), other.data() + offset, chunk.length() * sizeof(T)) != 0) {
+                    return false;
+                }
+                offset += chunk.length();
+            }
+            return true;
+        }
+    };
+
+    using Rope = BasicRope<char>;
+    using WRope = BasicRope<wchar_t>;
+    using RopeUTF8 = BasicRope<char8_t>;
+    using RopeUTF16 = BasicRope<char16_t>;
+    using RopeUTF32 = BasicRope<char32_t>;
+}// namespace kstd
\ No newline at end of file
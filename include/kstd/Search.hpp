@@ -0,0 +1,393 @@
+// Copyright 2024 Karma Krafts & associates
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+// NOLINTBEGIN
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+// NOLINTEND
+
+#include "Bits.hpp"
+#include "Concepts.hpp"
+#include "FixedArray.hpp"
+#include "System.hpp"
+#include "Types.hpp"
+
+namespace kstd::search {
+    static constexpr usize npos = static_cast<usize>(-1);
+
+    template<typename T>
+    concept Byte = concepts::Integer<T> && sizeof(T) == 1;
+
+    /**
+     * A set of bytes which can be tested a whole vector at a time.
+     * Every member is assigned a bit by its high nibble, so a byte is in the set
+     * exactly when the entries for its low and high nibble share a bit. This is exact
+     * as long as the members span no more than 8 distinct high nibbles, larger sets
+     * are matched through the bitmap instead.
+     */
+    struct ByteSet final {
+    private:
+        FixedArray<u64, 4> _bits;
+        FixedArray<u8, 16> _low_table;
+        FixedArray<u8, 16> _high_table;
+        bool _is_nibble_exact;
+
+        constexpr auto update_tables() noexcept -> void {
+            usize next_bit = 0;
+            for(usize i = 0; i < 16; ++i) {
+                _low_table[i] = 0;
+                _high_table[i] = 0;
+            }
+            for(usize high = 0; high < 16; ++high) {
+                const auto members = (_bits[high >> 2] >> ((high & 3) << 4)) & 0xFFFF;
+                if(members == 0) {
+                    continue;
+                }
+                if(next_bit == 8) {
+                    _is_nibble_exact = false;
+                    return;
+                }
+                const auto bit = static_cast<u8>(1U << next_bit++);
+                _high_table[high] = bit;
+                for(usize low = 0; low < 16; ++low) {
+                    if(((members >> low) & 1) != 0) {
+                        _low_table[low] |= bit;
+                    }
+                }
+            }
+            _is_nibble_exact = true;
+        }
+
+    public:
+        constexpr ByteSet() noexcept
+            : _bits()
+            , _low_table()
+            , _high_table()
+            , _is_nibble_exact(true) {
+            update_tables();
+        }
+
+        template<Byte T>
+        constexpr ByteSet(const T* values, const usize count) noexcept
+            : _bits()
+            , _low_table()
+            , _high_table()
+            , _is_nibble_exact(true) {
+            for(usize i = 0; i < count; ++i) {
+                const auto value = static_cast<u8>(values[i]);
+                _bits[value >> 6] |= u64 {1} << (value & 63);
+            }
+            update_tables();
+        }
+
+        KSTD_DEFAULT_MOVE_COPY(ByteSet, ByteSet, constexpr)
+        constexpr ~ByteSet() noexcept = default;
+
+        [[nodiscard]] constexpr auto contains(const u8 value) const noexcept -> bool {
+            return ((_bits[value >> 6] >> (value & 63)) & 1) != 0;
+        }
+
+        [[nodiscard]] constexpr auto is_nibble_exact() const noexcept -> bool {
+            return _is_nibble_exact;
+        }
+
+        [[nodiscard]] auto get_low_table() const noexcept -> const u8* {
+            return _low_table.data();
+        }
+
+        [[nodiscard]] auto get_high_table() const noexcept -> const u8* {
+            return _high_table.data();
+        }
+    };
+
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64)
+#define KSTD_SEARCH_VECTORIZED
+
+    namespace simd {
+#if defined(__AVX2__)
+        using vector_type = __m256i;
+
+        [[nodiscard]] inline auto load(const u8* address) noexcept -> vector_type {
+            return _mm256_loadu_si256(reinterpret_cast<const vector_type*>(address));
+        }
+
+        [[nodiscard]] inline auto splat(const u8 value) noexcept -> vector_type {
+            return _mm256_set1_epi8(static_cast<char>(value));
+        }
+
+        [[nodiscard]] inline auto get_equal_mask(const vector_type lhs, const vector_type rhs) noexcept -> u32 {
+            return static_cast<u32>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lhs, rhs)));
+        }
+
+        [[nodiscard]] inline auto get_both_equal_mask(const vector_type first, const vector_type first_value, const vector_type last,
+                                                      const vector_type last_value) noexcept -> u32 {
+            const auto both = _mm256_and_si256(_mm256_cmpeq_epi8(first, first_value), _mm256_cmpeq_epi8(last, last_value));
+            return static_cast<u32>(_mm256_movemask_epi8(both));
+        }
+#else
+        using vector_type = __m128i;
+
+        [[nodiscard]] inline auto load(const u8* address) noexcept -> vector_type {
+            return _mm_loadu_si128(reinterpret_cast<const vector_type*>(address));
+        }
+
+        [[nodiscard]] inline auto splat(const u8 value) noexcept -> vector_type {
+            return _mm_set1_epi8(static_cast<char>(value));
+        }
+
+        [[nodiscard]] inline auto get_equal_mask(const vector_type lhs, const vector_type rhs) noexcept -> u32 {
+            return static_cast<u32>(_mm_movemask_epi8(_mm_cmpeq_epi8(lhs, rhs)));
+        }
+
+        [[nodiscard]] inline auto get_both_equal_mask(const vector_type first, const vector_type first_value, const vector_type last,
+                                                      const vector_type last_value) noexcept -> u32 {
+            const auto both = _mm_and_si128(_mm_cmpeq_epi8(first, first_value), _mm_cmpeq_epi8(last, last_value));
+            return static_cast<u32>(_mm_movemask_epi8(both));
+        }
+#endif
+
+        static constexpr usize vector_size = sizeof(vector_type);
+    }// namespace simd
+#endif
+
+    /**
+     * Crochemore-Perrin two-way string matching, linear time and constant space
+     * for any needle. Used for wide characters and as the tail of the vectorized search.
+     */
+    template<typename T>
+    [[nodiscard]] constexpr auto find_two_way(const T* haystack, const usize haystack_size, const T* needle,
+                                              const usize needle_size) noexcept -> usize {
+        if(needle_size == 0) {
+            return 0;
+        }
+        if(needle_size > haystack_size) {
+            return npos;
+        }
+        const auto get_maximal_suffix = [needle, needle_size](const bool is_reversed, isize& period) constexpr noexcept -> isize {
+            isize suffix = -1;
+            isize j = 0;
+            isize k = 1;
+            period = 1;
+            const auto n = static_cast<isize>(needle_size);
+            while(j + k < n) {
+                const auto a = needle[j + k];
+                const auto b = needle[suffix + k];
+                if(is_reversed ? a > b : a < b) {
+                    j += k;
+                    k = 1;
+                    period = j - suffix;
+                }
+                else if(a == b) {
+                    if(k != period) {
+                        ++k;
+                    }
+                    else {
+                        j += period;
+                        k = 1;
+                    }
+                }
+                else {
+                    suffix = j++;
+                    k = 1;
+                    period = 1;
+                }
+            }
+            return suffix;
+        };
+
+        isize period = 0;
+        isize reversed_period = 0;
+        const auto suffix = get_maximal_suffix(false, period);
+        const auto reversed_suffix = get_maximal_suffix(true, reversed_period);
+        const auto critical = suffix > reversed_suffix ? suffix : reversed_suffix;
+        if(suffix <= reversed_suffix) {
+            period = reversed_period;
+        }
+
+        const auto n = static_cast<isize>(needle_size);
+        const auto m = static_cast<isize>(haystack_size);
+        bool is_periodic = true;
+        for(isize i = 0; i <= critical; ++i) {
+            if(needle[i] != needle[i + period]) {
+                is_periodic = false;
+                break;
+            }
+        }
+
+        isize j = 0;
+        if(is_periodic) {
+            isize memory = -1;
+            while(j <= m - n) {
+                auto i = (critical > memory ? critical : memory) + 1;
+                while(i < n && needle[i] == haystack[i + j]) {
+                    ++i;
+                }
+                if(i >= n) {
+                    i = critical;
+                    while(i > memory && needle[i] == haystack[i + j]) {
+                        --i;
+                    }
+                    if(i <= memory) {
+                        return static_cast<usize>(j);
+                    }
+                    j += period;
+                    memory = n - period - 1;
+                }
+                else {
+                    j += i - critical;
+                    memory = -1;
+                }
+            }
+            return npos;
+        }
+        period = (critical + 1 > n - critical - 1 ? critical + 1 : n - critical - 1) + 1;
+        while(j <= m - n) {
+            auto i = critical + 1;
+            while(i < n && needle[i] == haystack[i + j]) {
+                ++i;
+            }
+            if(i >= n) {
+                i = critical;
+                while(i >= 0 && needle[i] == haystack[i + j]) {
+                    --i;
+                }
+                if(i < 0) {
+                    return static_cast<usize>(j);
+                }
+                j += period;
+            }
+            else {
+                j += i - critical;
+            }
+        }
+        return npos;
+    }
+
+    /**
+     * @return The index of the first element equal to value, or npos.
+     */
+    template<concepts::Integer T>
+    [[nodiscard]] auto find(const T* data, const usize size, const T value) noexcept -> usize {
+        usize index = 0;
+#ifdef KSTD_SEARCH_VECTORIZED
+        if constexpr(Byte<T>) {
+            const auto* bytes = reinterpret_cast<const u8*>(data);
+            const auto needle = simd::splat(static_cast<u8>(value));
+            for(; index + simd::vector_size <= size; index += simd::vector_size) {
+                const auto mask = simd::get_equal_mask(simd::load(bytes + index), needle);
+                if(mask != 0) {
+                    return index + bits::count_trailing_zeros(mask);
+                }
+            }
+        }
+#endif
+        for(; index < size; ++index) {
+            if(data[index] == value) {
+                return index;
+            }
+        }
+        return npos;
+    }
+
+    /**
+     * @return The index of the last element equal to value, or npos.
+     */
+    template<concepts::Integer T>
+    [[nodiscard]] auto find_last(const T* data, const usize size, const T value) noexcept -> usize {
+        for(usize index = size; index > 0; --index) {
+            if(data[index - 1] == value) {
+                return index - 1;
+            }
+        }
+        return npos;
+    }
+
+    /**
+     * Finds a needle by filtering candidate positions on its first and last element
+     * a whole vector at a time, then comparing only the candidates.
+     *
+     * @return The index of the first occurrence of the needle, or npos.
+     */
+    template<concepts::Integer T>
+    [[nodiscard]] auto find(const T* haystack, const usize haystack_size, const T* needle, const usize needle_size) noexcept -> usize {
+        if(needle_size == 0) {
+            return 0;
+        }
+        if(needle_size > haystack_size) {
+            return npos;
+        }
+        if(needle_size == 1) {
+            return find(haystack, haystack_size, needle[0]);
+        }
+        usize index = 0;
+#ifdef KSTD_SEARCH_VECTORIZED
+        if constexpr(Byte<T>) {
+            const auto* bytes = reinterpret_cast<const u8*>(haystack);
+            const auto* needle_bytes = reinterpret_cast<const u8*>(needle);
+            const auto last = needle_size - 1;
+            const auto first_value = simd::splat(needle_bytes[0]);
+            const auto last_value = simd::splat(needle_bytes[last]);
+            for(; index + last + simd::vector_size <= haystack_size; index += simd::vector_size) {
+                auto mask = simd::get_both_equal_mask(simd::load(bytes + index), first_value, simd::load(bytes + index + last),
+                                                      last_value);
+                while(mask != 0) {
+                    const auto candidate = index + bits::count_trailing_zeros(mask);
+                    if(memcmp(bytes + candidate + 1, needle_bytes + 1, needle_size - 2) == 0) {
+                        return candidate;
+                    }
+                    mask &= mask - 1;
+                }
+            }
+        }
+#endif
+        const auto result = find_two_way(haystack + index, haystack_size - index, needle, needle_size);
+        return result == npos ? npos : result + index;
+    }
+
+    namespace simd {
+        /**
+         * Tests a vector of bytes at a time against nibble-exact sets, selected by the features
+         * of the executing CPU on first use.
+         *
+         * @return The index of the first byte contained in the set, or npos.
+         */
+        [[nodiscard]] auto find_any_of(const u8* data, usize size, const ByteSet& set) noexcept -> usize;
+    }// namespace simd
+
+    /**
+     * @return The index of the first byte contained in the set, or npos.
+     */
+    template<Byte T>
+    [[nodiscard]] auto find_any_of(const T* data, const usize size, const ByteSet& set) noexcept -> usize {
+        return simd::find_any_of(reinterpret_cast<const u8*>(data), size, set);
+    }
+
+    /**
+     * Scalar fallback for wide characters, which cannot use a byte set.
+     */
+    template<concepts::Integer T>
+    [[nodiscard]] constexpr auto find_any_of(const T* data, const usize size, const T* values, const usize count) noexcept -> usize {
+        for(usize index = 0; index < size; ++index) {
+            for(usize i = 0; i < count; ++i) {
+                if(data[index] == values[i]) {
+                    return index;
+                }
+            }
+        }
+        return npos;
+    }
+}// namespace kstd::search
\ No newline at end of file
@@ -14,10 +14,208 @@
 #pragma once
 
 #include "Defaults.hpp"
+#include "Functional.hpp"
+#include "Math.hpp"
+#include "Panic.hpp"
 #include "System.hpp"
+#include "Tuple.hpp"
 #include "Types.hpp"
+#include "Utility.hpp"
 
 namespace kstd {
+    template<typename TSlice>
+    class ChunkRange final {
+        class Iterator final {
+            TSlice _slice;
+            usize _chunk_size;
+            usize _offset;
+
+        public:
+            Iterator(TSlice slice, const usize chunk_size, const usize offset) noexcept
+                : _slice(slice)
+                , _chunk_size(chunk_size)
+                , _offset(offset) {
+            }
+
+            KSTD_DEFAULT_MOVE_COPY(Iterator, Iterator)
+            ~Iterator() noexcept = default;
+
+            [[nodiscard]] auto operator==(const Iterator& other) const noexcept -> bool {
+                return _offset == other._offset;
+            }
+
+            auto operator++() noexcept -> Iterator& {
+                _offset = min(_offset + _chunk_size, _slice.size());
+                return *this;
+            }
+
+            [[nodiscard]] auto operator*() const noexcept -> TSlice {
+                return _slice.sub_slice(_offset, min(_offset + _chunk_size, _slice.size()));
+            }
+        };
+
+        TSlice _slice;
+        usize _chunk_size;
+
+    public:
+        ChunkRange(TSlice slice, const usize chunk_size) noexcept
+            : _slice(slice)
+            , _chunk_size(chunk_size) {
+            if(chunk_size == 0) {
+                panic("Chunk size must not be zero");
+            }
+        }
+
+        KSTD_DEFAULT_MOVE_COPY(ChunkRange, ChunkRange)
+        ~ChunkRange() noexcept = default;
+
+        [[nodiscard]] auto begin() const noexcept -> Iterator {
+            return {_slice, _chunk_size, 0};
+        }
+
+        [[nodiscard]] auto end() const noexcept -> Iterator {
+            return {_slice, _chunk_size, _slice.size()};
+        }
+
+        [[nodiscard]] auto size() const noexcept -> usize {
+            return (_slice.size() + _chunk_size - 1) / _chunk_size;
+        }
+    };
+
+    template<typename TSlice>
+    class WindowRange final {
+        class Iterator final {
+            TSlice _slice;
+            usize _window_size;
+            usize _offset;
+
+        public:
+            Iterator(TSlice slice, const usize window_size, const usize offset) noexcept
+                : _slice(slice)
+                , _window_size(window_size)
+                , _offset(offset) {
+            }
+
+            KSTD_DEFAULT_MOVE_COPY(Iterator, Iterator)
+            ~Iterator() noexcept = default;
+
+            [[nodiscard]] auto operator==(const Iterator& other) const noexcept -> bool {
+                return _offset == other._offset;
+            }
+
+            auto operator++() noexcept -> Iterator& {
+                ++_offset;
+                return *this;
+            }
+
+            [[nodiscard]] auto operator*() const noexcept -> TSlice {
+                return _slice.sub_slice(_offset, _offset + _window_size);
+            }
+        };
+
+        TSlice _slice;
+        usize _window_size;
+
+    public:
+        WindowRange(TSlice slice, const usize window_size) noexcept
+            : _slice(slice)
+            , _window_size(window_size) {
+            if(window_size == 0) {
+                panic("Window size must not be zero");
+            }
+        }
+
+        KSTD_DEFAULT_MOVE_COPY(WindowRange, WindowRange)
+        ~WindowRange() noexcept = default;
+
+        [[nodiscard]] auto begin() const noexcept -> Iterator {
+            return {_slice, _window_size, 0};
+        }
+
+        [[nodiscard]] auto end() const noexcept -> Iterator {
+            return {_slice, _window_size, size()};
+        }
+
+        [[nodiscard]] auto size() const noexcept -> usize {
+            return _slice.size() < _window_size ? 0 : _slice.size() - _window_size + 1;
+        }
+    };
+
+    template<typename TSlice, typename TPredicate>
+    class SplitRange final {
+        class Iterator final {
+            TSlice _remaining;
+            const TPredicate* _predicate;
+            usize _length;
+            bool _is_finished;
+
+            [[nodiscard]] auto find_delimiter() const noexcept -> usize {
+                const auto size = _remaining.size();
+                for(usize i = 0; i < size; ++i) {
+                    if((*_predicate)(_remaining[i])) {
+                        return i;
+                    }
+                }
+                return size;
+            }
+
+        public:
+            Iterator(TSlice remaining, const TPredicate* predicate, const bool is_finished) noexcept
+                : _remaining(remaining)
+                , _predicate(predicate)
+                , _length(0)
+                , _is_finished(is_finished) {
+                if(!_is_finished) {
+                    _length = find_delimiter();
+                }
+            }
+
+            KSTD_DEFAULT_MOVE_COPY(Iterator, Iterator)
+            ~Iterator() noexcept = default;
+
+            [[nodiscard]] auto operator==(const Iterator& other) const noexcept -> bool {
+                if(_is_finished || other._is_finished) {
+                    return _is_finished == other._is_finished;
+                }
+                return _remaining.data() == other._remaining.data();
+            }
+
+            auto operator++() noexcept -> Iterator& {
+                if(_length == _remaining.size()) {
+                    _is_finished = true;
+                    return *this;
+                }
+                _remaining = _remaining.sub_slice(_length + 1, _remaining.size());
+                _length = find_delimiter();
+                return *this;
+            }
+
+            [[nodiscard]] auto operator*() const noexcept -> TSlice {
+                return _remaining.sub_slice(0, _length);
+            }
+        };
+
+        TSlice _slice;
+        TPredicate _predicate;
+
+    public:
+        SplitRange(TSlice slice, TPredicate predicate) noexcept
+            : _slice(slice)
+            , _predicate(move(predicate)) {
+        }
+
+        KSTD_DEFAULT_MOVE_COPY(SplitRange, SplitRange)
+        ~SplitRange() noexcept = default;
+
+        [[nodiscard]] auto begin() const noexcept -> Iterator {
+            return {_slice, &_predicate, false};
+        }
+
+        [[nodiscard]] auto end() const noexcept -> Iterator {
+            return {_slice, &_predicate, true};
+        }
+    };
+
     template<typename T>
     struct Slice final {
         using value_type = T;
@@ -26,10 +224,15 @@ namespace kstd {
     private:
         using self_type = Slice<value_type>;
 
-        const T* const _data;
+        const T* _data;
         usize _size;
 
     public:
+        Slice() noexcept
+            : _data(nullptr)
+            , _size(0) {
+        }
+
         Slice(const T* data, const usize size) noexcept
             : _data(data)
             , _size(size) {
@@ -50,18 +253,56 @@ namespace kstd {
             return _size;
         }
 
-        [[nodiscard]] auto data() noexcept -> T* {
-            return _data;
+        [[nodiscard]] auto is_empty() const noexcept -> bool {
+            return _size == 0;
         }
 
         [[nodiscard]] auto data() const noexcept -> const T* {
             return _data;
         }
 
+        [[nodiscard]] auto operator[](const usize index) const noexcept -> const T& {
+            return _data[index];
+        }
+
         [[nodiscard]] auto sub_slice(const usize start, const usize end) const noexcept -> self_type {
             return {_data + start, end - start};
         }
 
+        [[nodiscard]] auto split_at(const usize index) const noexcept -> Pair<self_type, self_type> {
+            if(index > _size) {
+                panic("Slice index out of bounds");
+            }
+            return {sub_slice(0, index), sub_slice(index, _size)};
+        }
+
+        /**
+         * @param chunk_size The maximum number of elements per chunk.
+         * @return A range over consecutive, non-overlapping sub-slices of the given size.
+         * The last chunk may be shorter if the size of this slice is not a multiple of the chunk size.
+         */
+        [[nodiscard]] auto chunks(const usize chunk_size) const noexcept -> ChunkRange<self_type> {
+            return {*this, chunk_size};
+        }
+
+        /**
+         * @param window_size The number of elements per window.
+         * @return A range over all overlapping sub-slices of the given size.
+         */
+        [[nodiscard]] auto windows(const usize window_size) const noexcept -> WindowRange<self_type> {
+            return {*this, window_size};
+        }
+
+        /**
+         * @param predicate A function which returns true for every element that separates two sub-slices.
+         * @return A range over the sub-slices between the matched separators, which are not included.
+         */
+        template<typename TPredicate>
+        requires(is_callable<TPredicate, const T&>)
+        [[nodiscard]] auto split(TPredicate predicate) const noexcept -> SplitRange<self_type, TPredicate> {
+            return {*this, move(predicate)};
+        }
+
         auto copy_to(T* dst, const usize size) const noexcept -> void {
             memcpy(dst, _data, sizeof(T) * size);
         }
@@ -70,4 +311,116 @@ namespace kstd {
             memcpy(dst, _data, size);
         }
     };
+
+    template<typename T>
+    struct SliceMut final {
+        using value_type = T;
+        using iterator = value_type*;
+        using const_iterator = const value_type*;
+        using slice_type = Slice<value_type>;
+
+    private:
+        using self_type = SliceMut<value_type>;
+
+        T* _data;
+        usize _size;
+
+    public:
+        SliceMut() noexcept
+            : _data(nullptr)
+            , _size(0) {
+        }
+
+        SliceMut(T* data, const usize size) noexcept
+            : _data(data)
+            , _size(size) {
+        }
+
+        KSTD_DEFAULT_MOVE_COPY(SliceMut, self_type, inline)
+        ~SliceMut() noexcept = default;
+
+        [[nodiscard]] operator slice_type() const noexcept {
+            return {_data, _size};
+        }
+
+        [[nodiscard]] auto begin() const noexcept -> iterator {
+            return _data;
+        }
+
+        [[nodiscard]] auto end() const noexcept -> iterator {
+            return _data + _size;
+        }
+
+        [[nodiscard]] auto size() const noexcept -> usize {
+            return _size;
+        }
+
+        [[nodiscard]] auto is_empty() const noexcept -> bool {
+            return _size == 0;
+        }
+
+        [[nodiscard]] auto data() const noexcept -> T* {
+            return _data;
+        }
+
+        [[nodiscard]] auto operator[](const usize index) const noexcept -> T& {
+            return _data[index];
+        }
+
+        [[nodiscard]] auto sub_slice(const usize start, const usize end) const noexcept -> self_type {
+            return {_data + start, end - start};
+        }
+
+        /**
+         * @param index The index at which to split this slice.
+         * @return Two disjoint mutable slices over [0, index) and [index, size()).
+         */
+        [[nodiscard]] auto split_at(const usize index) const noexcept -> Pair<self_type, self_type> {
+            if(index > _size) {
+                panic("Slice index out of bounds");
+            }
+            return {sub_slice(0, index), sub_slice(index, _size)};
+        }
+
+        /**
+         * @param chunk_size The maximum number of elements per chunk.
+         * @return A range over consecutive, disjoint sub-slices of the given size.
+         * The last chunk may be shorter if the size of this slice is not a multiple of the chunk size.
+         */
+        [[nodiscard]] auto chunks(const usize chunk_size) const noexcept -> ChunkRange<self_type> {
+            return {*this, chunk_size};
+        }
+
+        /**
+         * @param window_size The number of elements per window.
+         * @return A range over all overlapping, read-only sub-slices of the given size.
+         */
+        [[nodiscard]] auto windows(const usize window_size) const noexcept -> WindowRange<slice_type> {
+            return {*this, window_size};
+        }
+
+        /**
+         * @param predicate A function which returns true for every element that separates two sub-slices.
+         * @return A range over the sub-slices between the matched separators, which are not included.
+         */
+        template<typename TPredicate>
+        requires(is_callable<TPredicate, const T&>)
+        [[nodiscard]] auto split(TPredicate predicate) const noexcept -> SplitRange<self_type, TPredicate> {
+            return {*this, move(predicate)};
+        }
+
+        auto fill(const T& value) const noexcept -> void {
+            for(usize i = 0; i < _size; ++i) {
+                _data[i] = value;
+            }
+        }
+
+        auto copy_from(const slice_type& slice) const noexcept -> void {
+            memcpy(_data, slice.data(), sizeof(T) * min(slice.size(), _size));
+        }
+
+        auto copy_to(T* dst, const usize size) const noexcept -> void {
+            memcpy(dst, _data, sizeof(T) * size);
+        }
+    };
 }// namespace kstd
\ No newline at end of file
@@ -0,0 +1,352 @@
+// Copyright 2024 Karma Krafts & associates
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "Allocator.hpp"
+#include "Concepts.hpp"
+#include "FixedArray.hpp"
+#include "Math.hpp"
+#include "Memory.hpp"
+#include "Panic.hpp"
+#include "ParameterPack.hpp"
+#include "Slice.hpp"
+#include "Types.hpp"
+#include "Utility.hpp"
+
+namespace kstd {
+    /**
+     * A structure-of-arrays container which stores every field in its own
+     * contiguous column. All columns live in a single allocation and every
+     * column starts on a cache line boundary.
+     *
+     * @tparam TAllocator The byte allocator used for the column storage.
+     * @tparam TFields The types of the individual fields of a row.
+     */
+    template<concepts::Allocator<u8> TAllocator, typename... TFields>
+    struct BasicSoAArray final {
+        using allocator_type = TAllocator;
+        using field_types = Pack<TFields...>;
+
+        static constexpr usize num_fields = sizeof...(TFields);
+        static constexpr usize column_alignment = 64;
+
+        template<usize TIndex>
+        using field_type = PackElement<TIndex, TFields...>;
+
+        static_assert(num_fields > 0, "SoAArray requires at least one field");
+
+    private:
+        using self_type = BasicSoAArray<TAllocator, TFields...>;
+
+        template<bool TIsConst>
+        class RowImpl final {
+            using array_type = conditional<TIsConst, const self_type, self_type>;
+
+            array_type* _array;
+            usize _index;
+
+        public:
+            RowImpl(array_type* array, const usize index) noexcept
+                : _array(array)
+                , _index(index) {
+            }
+
+            KSTD_DEFAULT_MOVE_COPY(RowImpl, RowImpl)
+            ~RowImpl() noexcept = default;
+
+            template<usize TIndex>
+            [[nodiscard]] auto get() const noexcept -> conditional<TIsConst, const field_type<TIndex>&, field_type<TIndex>&> {
+                return _array->template get_column_data<TIndex>()[_index];
+            }
+
+            [[nodiscard]] auto get_index() const noexcept -> usize {
+                return _index;
+            }
+        };
+
+    public:
+        using row_type = RowImpl<false>;
+        using const_row_type = RowImpl<true>;
+
+    private:
+        TAllocator _allocator;
+        usize _size;
+        usize _capacity;
+        u8* _memory;
+        FixedArray<u8*, num_fields> _columns;
+
+        template<usize TIndex>
+        [[nodiscard]] static constexpr auto get_field_alignment() noexcept -> usize {
+            return max(alignof(field_type<TIndex>), column_alignment);
+        }
+
+        [[nodiscard]] static constexpr auto get_base_alignment() noexcept -> usize {
+            usize alignment = column_alignment;
+            ((alignment = max(alignment, alignof(TFields))), ...);
+            return alignment;
+        }
+
+        template<usize TIndex>
+        [[nodiscard]] static constexpr auto get_column_offset(const usize capacity) noexcept -> usize {
+            if constexpr(TIndex == 0) {
+                return 0;
+            }
+            else {
+                const auto previous_end = get_column_offset<TIndex - 1>(capacity) + sizeof(field_type<TIndex - 1>) * capacity;
+                const auto alignment = get_field_alignment<TIndex>();
+                return (previous_end + alignment - 1) & ~(alignment - 1);
+            }
+        }
+
+        [[nodiscard]] static constexpr auto get_buffer_size(const usize capacity) noexcept -> usize {
+            // Over-allocate by the strictest field alignment so the base can be aligned manually
+            return get_column_offset<num_fields - 1>(capacity) + sizeof(field_type<num_fields - 1>) * capacity + get_base_alignment();
+        }
+
+        template<usize TIndex = 0>
+        auto assign_columns(u8* memory, FixedArray<u8*, num_fields>& columns, const usize capacity) noexcept -> void {
+            columns[TIndex] = align(memory, get_base_alignment()) + get_column_offset<TIndex>(capacity);
+            if constexpr(TIndex + 1 < num_fields) {
+                assign_columns<TIndex + 1>(memory, columns, capacity);
+            }
+        }
+
+        template<usize TIndex = 0>
+        auto move_columns(FixedArray<u8*, num_fields>& columns) noexcept -> void {
+            using T = field_type<TIndex>;
+            auto* old_data = reinterpret_cast<T*>(_columns[TIndex]);
+            auto* new_data = reinterpret_cast<T*>(columns[TIndex]);
+            for(usize i = 0; i < _size; ++i) {
+                new(&new_data[i]) T(kstd::move(old_data[i]));
+                old_data[i].~T();
+            }
+            if constexpr(TIndex + 1 < num_fields) {
+                move_columns<TIndex + 1>(columns);
+            }
+        }
+
+        template<usize TIndex = 0>
+        auto copy_columns(const self_type& other) noexcept -> void {
+            using T = field_type<TIndex>;
+            const auto* src_data = other.template get_column_data<TIndex>();
+            auto* dst_data = get_column_data<TIndex>();
+            for(usize i = 0; i < other._size; ++i) {
+                new(&dst_data[i]) T(src_data[i]);
+            }
+            if constexpr(TIndex + 1 < num_fields) {
+                copy_columns<TIndex + 1>(other);
+            }
+        }
+
+        template<usize TIndex = 0>
+        auto destroy_range(const usize start, const usize end) noexcept -> void {
+            using T = field_type<TIndex>;
+            auto* data = get_column_data<TIndex>();
+            for(usize i = start; i < end; ++i) {
+                data[i].~T();
+            }
+            if constexpr(TIndex + 1 < num_fields) {
+                destroy_range<TIndex + 1>(start, end);
+            }
+        }
+
+        template<usize TIndex, typename THead, typename... TTail>
+        auto construct_row_impl(const usize index, THead&& head, TTail&&... tail) noexcept -> void {
+            new(&get_column_data<TIndex>()[index]) field_type<TIndex>(forward<THead>(head));
+            if constexpr(sizeof...(TTail) > 0) {
+                construct_row_impl<TIndex + 1, TTail...>(index, forward<TTail>(tail)...);
+            }
+        }
+
+        auto reallocate_internal(const usize capacity) noexcept -> void {
+            auto* new_memory = _allocator.allocate(get_buffer_size(capacity));
+            FixedArray<u8*, num_fields> new_columns {};
+            assign_columns(new_memory, new_columns, capacity);
+            if(_memory != nullptr) {
+                move_columns(new_columns);
+                _allocator.free(_memory);
+            }
+            _memory = new_memory;
+            _columns = new_columns;
+            _capacity = capacity;
+        }
+
+    public:
+        BasicSoAArray() noexcept
+            : _allocator()
+            , _size(0)
+            , _capacity(0)
+            , _memory(nullptr)
+            , _columns() {
+        }
+
+        explicit BasicSoAArray(const usize capacity) noexcept
+            : BasicSoAArray() {
+            reserve(capacity);
+        }
+
+        BasicSoAArray(const self_type& other) noexcept
+            : BasicSoAArray() {
+            reserve(other._size);
+            copy_columns(other);
+            _size = other._size;
+        }
+
+        BasicSoAArray(self_type&& other) noexcept
+            : _allocator(move(other._allocator))
+            , _size(other._size)
+            , _capacity(other._capacity)
+            , _memory(other._memory)
+            , _columns(other._columns) {
+            other._size = 0;
+            other._capacity = 0;
+            other._memory = nullptr;
+        }
+
+        ~BasicSoAArray() noexcept {
+            if(_memory == nullptr) {
+                return;
+            }
+            destroy_range(0, _size);
+            _allocator.free(_memory);
+        }
+
+        auto operator=(const self_type& other) noexcept -> self_type& {
+            if(&other == this) {
+                return *this;
+            }
+            clear();
+            reserve(other._size);
+            copy_columns(other);
+            _size = other._size;
+            return *this;
+        }
+
+        auto operator=(self_type&& other) noexcept -> self_type& {
+            if(&other == this) {
+                return *this;
+            }
+            if(_memory != nullptr) {
+                destroy_range(0, _size);
+                _allocator.free(_memory);
+            }
+            _allocator = move(other._allocator);
+            _size = other._size;
+            _capacity = other._capacity;
+            _memory = other._memory;
+            _columns = other._columns;
+            other._size = 0;
+            other._capacity = 0;
+            other._memory = nullptr;
+            return *this;
+        }
+
+        template<usize TIndex>
+        [[nodiscard]] auto get_column_data() noexcept -> field_type<TIndex>* {
+            return reinterpret_cast<field_type<TIndex>*>(_columns[TIndex]);
+        }
+
+        template<usize TIndex>
+        [[nodiscard]] auto get_column_data() const noexcept -> const field_type<TIndex>* {
+            return reinterpret_cast<const field_type<TIndex>*>(_columns[TIndex]);
+        }
+
+        template<usize TIndex>
+        [[nodiscard]] auto column() const noexcept -> Slice<field_type<TIndex>> {
+            return {get_column_data<TIndex>(), _size};
+        }
+
+        template<usize TIndex>
+        [[nodiscard]] auto column_mut() noexcept -> SliceMut<field_type<TIndex>> {
+            return {get_column_data<TIndex>(), _size};
+        }
+
+        auto reserve(const usize capacity) noexcept -> void {
+            if(capacity <= _capacity) {
+                return;
+            }
+            reallocate_internal(capacity);
+        }
+
+        auto shrink_to_fit() noexcept -> void {
+            if(_size == _capacity || _size == 0) {
+                return;
+            }
+            reallocate_internal(_size);
+        }
+
+        template<typename... TArgs>
+        requires(sizeof...(TArgs) == num_fields)
+        auto push_back(TArgs&&... values) noexcept -> void {
+            if(_size == _capacity) {
+                reserve(max<usize>(_size << 1, 4));
+            }
+            construct_row_impl<0, TArgs...>(_size, forward<TArgs>(values)...);
+            ++_size;
+        }
+
+        auto pop_back() noexcept -> void {
+            if(_size == 0) {
+                panic("No elements in array");
+            }
+            destroy_range(_size - 1, _size);
+            --_size;
+        }
+
+        auto clear() noexcept -> void {
+            if(_memory == nullptr) {
+                return;
+            }
+            destroy_range(0, _size);
+            _size = 0;
+        }
+
+        [[nodiscard]] auto size() const noexcept -> usize {
+            return _size;
+        }
+
+        [[nodiscard]] auto capacity() const noexcept -> usize {
+            return _capacity;
+        }
+
+        [[nodiscard]] auto is_empty() const noexcept -> bool {
+            return _size == 0;
+        }
+
+        [[nodiscard]] auto at(const usize index) noexcept -> row_type {
+            if(index >= _size) {
+                panic("Array index out of bounds");
+            }
+            return {this, index};
+        }
+
+        [[nodiscard]] auto at(const usize index) const noexcept -> const_row_type {
+            if(index >= _size) {
+                panic("Array index out of bounds");
+            }
+            return {this, index};
+        }
+
+        [[nodiscard]] auto operator[](const usize index) noexcept -> row_type {
+            return {this, index};
+        }
+
+        [[nodiscard]] auto operator[](const usize index) const noexcept -> const_row_type {
+            return {this, index};
+        }
+    };
+
+    template<typename... TFields>
+    using SoAArray = BasicSoAArray<Allocator<u8>, TFields...>;
+}// namespace kstd
\ No newline at end of file
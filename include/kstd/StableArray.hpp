@@ -0,0 +1,298 @@
+// Copyright 2024 Karma Krafts & associates
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "Allocator.hpp"
+#include "Bits.hpp"
+#include "Concepts.hpp"
+#include "Defaults.hpp"
+#include "FixedArray.hpp"
+#include "Math.hpp"
+#include "Panic.hpp"
+#include "Slice.hpp"
+#include "Types.hpp"
+#include "Utility.hpp"
+
+namespace kstd {
+    /**
+     * A growable array made of geometrically growing segments.
+     * Segment k holds first_segment_size << k elements, so growing the array
+     * only ever allocates a new segment and never moves existing elements.
+     * Pointers and references to elements stay valid until they are popped.
+     *
+     * @tparam T The type of the elements stored in the array.
+     * @tparam TAllocator The allocator used for the segments.
+     */
+    template<typename T, concepts::Allocator<T> TAllocator = Allocator<T>>
+    struct StableArray final {
+        using element_type = T;
+        using allocator_type = TAllocator;
+        using slice_type = Slice<T>;
+
+        static constexpr usize first_segment_shift = 4;
+        static constexpr usize first_segment_size = usize {1} << first_segment_shift;
+        static constexpr usize max_segments = (sizeof(usize) << 3) - first_segment_shift;
+
+    private:
+        using self_type = StableArray<T, TAllocator>;
+
+        template<bool TIsConst>
+        class IteratorImpl final {
+            using array_type = conditional<TIsConst, const self_type, self_type>;
+            using reference = conditional<TIsConst, const T&, T&>;
+
+            array_type* _array;
+            usize _index;
+
+        public:
+            IteratorImpl(array_type* array, const usize index) noexcept
+                : _array(array)
+                , _index(index) {
+            }
+
+            KSTD_DEFAULT_MOVE_COPY(IteratorImpl, IteratorImpl)
+            ~IteratorImpl() noexcept = default;
+
+            [[nodiscard]] auto operator==(const IteratorImpl& other) const noexcept -> bool {
+                return _index == other._index;
+            }
+
+            auto operator++() noexcept -> IteratorImpl& {
+                ++_index;
+                return *this;
+            }
+
+            [[nodiscard]] auto operator*() const noexcept -> reference {
+                return (*_array)[_index];
+            }
+        };
+
+    public:
+        using iterator = IteratorImpl<false>;
+        using const_iterator = IteratorImpl<true>;
+
+    private:
+        TAllocator _allocator;
+        usize _size;
+        usize _segment_count;
+        FixedArray<T*, max_segments> _segments;
+
+        [[nodiscard]] static constexpr auto get_segment_size(const usize segment) noexcept -> usize {
+            return first_segment_size << segment;
+        }
+
+        [[nodiscard]] static constexpr auto get_capacity(const usize segment_count) noexcept -> usize {
+            // Sum of all segment sizes below segment_count
+            return (first_segment_size << segment_count) - first_segment_size;
+        }
+
+        [[nodiscard]] static auto get_segment_index(const usize index) noexcept -> usize {
+            constexpr usize msb = (sizeof(usize) << 3) - 1;
+            return msb - bits::count_leading_zeros(index + first_segment_size) - first_segment_shift;
+        }
+
+        [[nodiscard]] auto get_slot(const usize index) const noexcept -> T* {
+            const auto segment = get_segment_index(index);
+            return _segments[segment] + (index - get_capacity(segment));
+        }
+
+        auto grow() noexcept -> void {
+            if(_segment_count == max_segments) {
+                panic("Stable array exceeded its maximum capacity");
+            }
+            _segments[_segment_count] = _allocator.allocate(get_segment_size(_segment_count));
+            ++_segment_count;
+        }
+
+        auto destroy() noexcept -> void {
+            clear();
+            for(usize i = 0; i < _segment_count; ++i) {
+                _allocator.free(_segments[i]);
+            }
+            _segment_count = 0;
+        }
+
+    public:
+        StableArray() noexcept
+            : _allocator()
+            , _size(0)
+            , _segment_count(0)
+            , _segments() {
+        }
+
+        StableArray(const self_type& other) noexcept
+            : StableArray() {
+            for(const auto& element : other) {
+                push_back(element);
+            }
+        }
+
+        StableArray(self_type&& other) noexcept
+            : _allocator(move(other._allocator))
+            , _size(other._size)
+            , _segment_count(other._segment_count)
+            , _segments(other._segments) {
+            other._size = 0;
+            other._segment_count = 0;
+        }
+
+        ~StableArray() noexcept {
+            destroy();
+        }
+
+        auto operator=(const self_type& other) noexcept -> self_type& {
+            if(&other == this) {
+                return *this;
+            }
+            clear();
+            for(const auto& element : other) {
+                push_back(element);
+            }
+            return *this;
+        }
+
+        auto operator=(self_type&& other) noexcept -> self_type& {
+            if(&other == this) {
+                return *this;
+            }
+            destroy();
+            _allocator = move(other._allocator);
+            _size = other._size;
+            _segment_count = other._segment_count;
+            _segments = other._segments;
+            other._size = 0;
+            other._segment_count = 0;
+            return *this;
+        }
+
+        template<typename... TArgs>
+        auto emplace_back(TArgs&&... args) noexcept -> T& {
+            if(_size == get_capacity(_segment_count)) {
+                grow();
+            }
+            auto* slot = get_slot(_size++);
+            new(slot) T(kstd::forward<TArgs>(args)...);
+            return *slot;
+        }
+
+        auto push_back(const T& value) noexcept -> T& {
+            return emplace_back(value);
+        }
+
+        auto push_back(T&& value) noexcept -> T& {
+            return emplace_back(kstd::move(value));
+        }
+
+        auto pop_back() noexcept -> void {
+            if(_size == 0) {
+                panic("No elements in array");
+            }
+            get_slot(--_size)->~T();
+        }
+
+        auto clear() noexcept -> void {
+            for(usize i = 0; i < _size; ++i) {
+                get_slot(i)->~T();
+            }
+            _size = 0;
+        }
+
+        auto reserve(const usize size) noexcept -> void {
+            while(get_capacity(_segment_count) < size) {
+                grow();
+            }
+        }
+
+        [[nodiscard]] auto size() const noexcept -> usize {
+            return _size;
+        }
+
+        [[nodiscard]] auto capacity() const noexcept -> usize {
+            return get_capacity(_segment_count);
+        }
+
+        [[nodiscard]] auto is_empty() const noexcept -> bool {
+            return _size == 0;
+        }
+
+        /**
+         * @return The number of segments which currently hold at least one element.
+         */
+        [[nodiscard]] auto get_segment_count() const noexcept -> usize {
+            return _size == 0 ? 0 : get_segment_index(_size - 1) + 1;
+        }
+
+        /**
+         * @param segment The index of the segment to retrieve.
+         * @return A slice over the occupied part of the given segment.
+         */
+        [[nodiscard]] auto get_segment(const usize segment) const noexcept -> slice_type {
+            const auto start = get_capacity(segment);
+            const auto end = min(start + get_segment_size(segment), _size);
+            return {_segments[segment], end - start};
+        }
+
+        [[nodiscard]] auto begin() noexcept -> iterator {
+            return {this, 0};
+        }
+
+        [[nodiscard]] auto end() noexcept -> iterator {
+            return {this, _size};
+        }
+
+        [[nodiscard]] auto begin() const noexcept -> const_iterator {
+            return {this, 0};
+        }
+
+        [[nodiscard]] auto end() const noexcept -> const_iterator {
+            return {this, _size};
+        }
+
+        [[nodiscard]] auto front() noexcept -> T& {
+            if(_size == 0) {
+                panic("No elements in array");
+            }
+            return *get_slot(0);
+        }
+
+        [[nodiscard]] auto back() noexcept -> T& {
+            if(_size == 0) {
+                panic("No elements in array");
+            }
+            return *get_slot(_size - 1);
+        }
+
+        [[nodiscard]] auto at(const usize index) noexcept -> T& {
+            if(index >= _size) {
+                panic("Array index out of bounds");
+            }
+            return *get_slot(index);
+        }
+
+        [[nodiscard]] auto at(const usize index) const noexcept -> const T& {
+            if(index >= _size) {
+                panic("Array index out of bounds");
+            }
+            return *get_slot(index);
+        }
+
+        [[nodiscard]] auto operator[](const usize index) noexcept -> T& {
+            return *get_slot(index);
+        }
+
+        [[nodiscard]] auto operator[](const usize index) const noexcept -> const T& {
+            return *get_slot(index);
+        }
+    };
+}// namespace kstd
\ No newline at end of file
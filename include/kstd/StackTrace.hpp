@@ -15,56 +15,67 @@
 
 #include "Array.hpp"
 #include "Defaults.hpp"
-#include "String.hpp"
+#include "FixedArray.hpp"
+#include "Hash.hpp"
+#include "Slice.hpp"
+#include "StringView.hpp"
 #include "Types.hpp"
 #include "Utility.hpp"
 
 namespace kstd {
+    /**
+     * A single symbolized function of a frame. The names are views into the process-wide
+     * SymbolCache when produced by StackTrace, so elements are cheap to copy and never own memory.
+     */
     struct StackTraceElement final {
         void* _address;
-        String _binary;
-        String _file_name;
-        String _function_name;
+        StringView _binary;
+        StringView _file_name;
+        StringView _function_name;
         usize _line;
         usize _column;
+        bool _is_inlined;
 
     public:
         StackTraceElement() noexcept
             : _address(nullptr)
             , _line(0)
-            , _column(0) {
+            , _column(0)
+            , _is_inlined(false) {
         }
 
         KSTD_DEFAULT_MOVE_COPY(StackTraceElement, StackTraceElement)
         ~StackTraceElement() noexcept = default;
 
         StackTraceElement(void* address,
-                          String binary,
-                          String file_name,
-                          String function_name,
+                          const StringView& binary,
+                          const StringView& file_name,
+                          const StringView& function_name,
                           const usize line,
-                          const usize column) noexcept
+                          const usize column,
+                          const bool is_inlined = false) noexcept
             : _address(address)
-            , _binary(kstd::move(binary))
-            , _file_name(kstd::move(file_name))
-            , _function_name(kstd::move(function_name))
+            , _binary(binary)
+            , _file_name(file_name)
+            , _function_name(function_name)
             , _line(line)
-            , _column(column) {
+            , _column(column)
+            , _is_inlined(is_inlined) {
         }
 
         [[nodiscard]] auto get_address() const noexcept -> void* {
             return _address;
         }
 
-        [[nodiscard]] auto get_binary() const noexcept -> const String& {
+        [[nodiscard]] auto get_binary() const noexcept -> StringView {
             return _binary;
         }
 
-        [[nodiscard]] auto get_file_name() const noexcept -> const String& {
+        [[nodiscard]] auto get_file_name() const noexcept -> StringView {
             return _file_name;
         }
 
-        [[nodiscard]] auto get_function_name() const noexcept -> const String& {
+        [[nodiscard]] auto get_function_name() const noexcept -> StringView {
             return _function_name;
         }
 
@@ -75,16 +86,59 @@ namespace kstd {
         [[nodiscard]] auto get_column() const noexcept -> usize {
             return _column;
         }
+
+        /**
+         * @return True if this frame was inlined into the next element, which shares its address.
+         */
+        [[nodiscard]] auto is_inlined() const noexcept -> bool {
+            return _is_inlined;
+        }
+    };
+
+    /**
+     * How StackTrace::get_current walks the stack. Windows always uses the system unwinder.
+     */
+    enum class UnwindMode : u8 {
+        LIBUNWIND,    // Uses the unwind tables, which works for any code
+        FRAME_POINTER,// Follows the saved frame pointers, only complete if all code keeps them
     };
 
+    /**
+     * A captured call stack. Capturing only records the return addresses into an inline buffer,
+     * the frames are symbolized in one batch when the first element is accessed or symbolize()
+     * is called. Symbolization mutates the trace, so a single trace must not be accessed from
+     * multiple threads at the same time before it was symbolized.
+     */
     class StackTrace final {
-        Array<StackTraceElement> _elements {};
+    public:
+        static constexpr usize max_depth = 128;
+
+    private:
+        struct Frame final {
+            u32 first_element;
+            u32 element_count;
+        };
+
+        FixedArray<void*, max_depth> _addresses {};
+        usize _depth {0};
+        mutable FixedArray<Frame, max_depth> _frames {};
+        mutable Array<StackTraceElement> _elements {};
+        mutable bool _is_symbolized {false};
 
         StackTrace() noexcept = default;
 
-        explicit StackTrace(Array<StackTraceElement> elements) noexcept
-            : _elements(move(elements)) {
-        }
+        /**
+         * Appends the elements for the given address to the given array, one per inlined function
+         * and innermost first, followed by the element of the function the address belongs to.
+         * The elements of every address are resolved once and then served from the SymbolCache.
+         */
+        static auto symbolize_address(void* address, Array<StackTraceElement>& elements) noexcept -> void;
+
+        /**
+         * Drops cached symbols which may be stale because a binary was unloaded,
+         * called once before the addresses of a trace are symbolized.
+         */
+        static auto invalidate_symbols() noexcept -> void;
 
     public:
         using const_iterator = typename decltype(_elements)::const_iterator;
@@ -92,22 +146,156 @@ namespace kstd {
         KSTD_DEFAULT_MOVE_COPY(StackTrace, StackTrace)
         ~StackTrace() noexcept = default;
 
+        /**
+         * Resolves the elements of all frames, this is a no-op if the trace was already symbolized.
+         */
+        auto symbolize() const noexcept -> void {
+            if(_is_symbolized) {
+                return;
+            }
+            invalidate_symbols();
+            _elements.reserve(_depth);
+            for(usize i = 0; i < _depth; ++i) {
+                const auto first_element = _elements.size();
+                symbolize_address(_addresses[i], _elements);
+                if(_elements.size() == first_element) {
+                    _elements.emplace_back(_addresses[i], StringView(), StringView(), StringView(), 0, 0);
+                }
+                _frames[i] = {static_cast<u32>(first_element), static_cast<u32>(_elements.size() - first_element)};
+            }
+            _is_symbolized = true;
+        }
+
+        /**
+         * @return An iterator over the elements of all frames, including inlined ones.
+         */
         [[nodiscard]] auto cbegin() const noexcept -> const_iterator {
+            symbolize();
             return _elements.cbegin();
         }
 
         [[nodiscard]] auto cend() const noexcept -> const_iterator {
+            symbolize();
             return _elements.cend();
         }
 
+        /**
+         * @return The element of the innermost function executing at the given frame.
+         */
         [[nodiscard]] auto operator[](const usize index) const noexcept -> const StackTraceElement& {
-            return _elements[index];
+            symbolize();
+            return _elements[_frames[index].first_element];
+        }
+
+        /**
+         * @return The elements of the given frame, one per inlined function and innermost first.
+         */
+        [[nodiscard]] auto get_elements(const usize index) const noexcept -> Slice<StackTraceElement> {
+            symbolize();
+            const auto& frame = _frames[index];
+            return {_elements.data() + frame.first_element, frame.element_count};
+        }
+
+        /**
+         * @return The return address of the given frame, without symbolizing the trace.
+         */
+        [[nodiscard]] auto get_address(const usize index) const noexcept -> void* {
+            return _addresses[index];
+        }
+
+        /**
+         * @return The return addresses of all frames, innermost first, without symbolizing the trace.
+         */
+        [[nodiscard]] auto get_addresses() const noexcept -> Slice<void*> {
+            return {_addresses.data(), _depth};
         }
 
         [[nodiscard]] auto get_depth() const noexcept -> usize {
-            return _elements.size();
+            return _depth;
+        }
+
+        /**
+         * Hashes the return addresses without symbolizing the trace. Traces which share the hashed
+         * frames hash equal within a process, but the hashes change between runs since binaries are
+         * usually loaded at randomized addresses.
+         *
+         * @param skip The number of innermost frames to leave out, like the frames of an error reporting helper.
+         * @param depth The maximum number of frames to hash after the skipped ones, so traces which only differ in outer callers hash equal.
+         */
+        [[nodiscard]] auto get_hash(const usize skip = 0, const usize depth = max_depth) const noexcept -> u64 {
+            const auto first = skip < _depth ? skip : _depth;
+            const auto count = depth < _depth - first ? depth : _depth - first;
+            return hash_addresses(_addresses.data() + first, count);
+        }
+
+        /**
+         * Hashes the given return addresses the same way as get_hash, this neither allocates nor takes locks.
+         */
+        [[nodiscard]] static auto hash_addresses(void* const* addresses, const usize count) noexcept -> u64 {
+            static_assert(sizeof(void*) == sizeof(usize), "Addresses are hashed as integers");
+            return hash_elements(reinterpret_cast<const usize*>(addresses), count);
+        }
+
+        [[nodiscard]] auto is_symbolized() const noexcept -> bool {
+            return _is_symbolized;
         }
 
+        /**
+         * Captures the return addresses of the calling thread, this does not allocate.
+         *
+         * @param depth The maximum number of frames to capture. Together with the skipped frames, this is limited to max_depth.
+         * @param skip The number of innermost frames to leave out, 1 leaves out get_current itself.
+         */
         [[nodiscard]] static auto get_current(usize depth = 32, usize skip = 1) noexcept -> StackTrace;
+
+        /**
+         * Captures the return addresses of the calling thread into the given buffer. This neither
+         * allocates nor takes locks, so it may be called from signal handlers of threads which
+         * called prepare_thread before.
+         *
+         * @param buffer The buffer to write the addresses to.
+         * @param capacity The maximum number of addresses to write. Together with the skipped frames, this is limited to max_depth.
+         * @param skip The number of innermost frames to leave out, 0 starts at the caller.
+         * @return The number of addresses written.
+         */
+        static auto capture(void** buffer, usize capacity, usize skip = 0) noexcept -> usize;
+
+        /**
+         * Initializes everything capture needs for the calling thread in either unwind mode, which
+         * is not async-signal-safe. Without it, capture falls back to the unwind tables in the
+         * frame pointer mode, since the bounds of the stack are unknown.
+         */
+        static auto prepare_thread() noexcept -> void;
+
+        /**
+         * Creates an unsymbolized trace from previously captured addresses, innermost first.
+         */
+        [[nodiscard]] static auto from_addresses(void* const* addresses, const usize count) noexcept -> StackTrace {
+            StackTrace trace {};
+            trace._depth = count < max_depth ? count : max_depth;
+            for(usize i = 0; i < trace._depth; ++i) {
+                trace._addresses[i] = addresses[i];
+            }
+            return trace;
+        }
+
+        /**
+         * Selects how all threads capture traces from now on. The frame pointer walker is an order
+         * of magnitude faster, but stops early at the first frame of code built without
+         * -fno-omit-frame-pointer.
+         */
+        static auto set_unwind_mode(UnwindMode mode) noexcept -> void;
+
+        [[nodiscard]] static auto get_unwind_mode() noexcept -> UnwindMode;
+
+        /**
+         * Selects where symbol indices are persisted, one per binary keyed by its build-id. The first
+         * lookup in an indexed binary maps its index instead of parsing the debug information, the
+         * first process without an index parses all of it once to write the index. Defaults to
+         * $KSTD_SYMBOL_INDEX_DIR, the index is disabled if neither is set or the path is empty.
+         * Drops all opened binaries and cached addresses, so every later lookup uses the new
+         * directory. Only has an effect on Unix.
+         */
+        static auto set_symbol_index_directory(const StringView& path) noexcept -> void;
     };
 }// namespace kstd
\ No newline at end of file
@@ -0,0 +1,289 @@
+// Copyright 2024 Karma Krafts & associates
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+// NOLINTBEGIN
+#include <algorithm>
+#include <mutex>
+// NOLINTEND
+
+#include "Array.hpp"
+#include "Atomic.hpp"
+#include "Defaults.hpp"
+#include "FixedArray.hpp"
+#include "Math.hpp"
+#include "StackTrace.hpp"
+#include "Types.hpp"
+
+namespace kstd {
+    /**
+     * A unique stack and how often it was added to a StackTraceAggregator.
+     */
+    struct StackTraceCount final {
+        StackTrace trace;
+        u64 count;// Overestimates the true count by at most the error
+        u64 error;// Non-zero if the stack replaced an evicted one
+
+        StackTraceCount() noexcept
+            : trace(StackTrace::from_addresses(nullptr, 0))
+            , count(0)
+            , error(0) {
+        }
+
+        StackTraceCount(StackTrace trace, const u64 count, const u64 error) noexcept
+            : trace(kstd::move(trace))
+            , count(count)
+            , error(error) {
+        }
+
+        KSTD_DEFAULT_MOVE_COPY(StackTraceCount, StackTraceCount)
+        ~StackTraceCount() noexcept = default;
+    };
+
+    /**
+     * Counts unique stacks in a fixed amount of memory. Stacks are compared by their raw return
+     * addresses, so adding a stack never symbolizes it. Once the aggregator is full, every new
+     * stack replaces the least frequent one and inherits its count, the Space-Saving algorithm:
+     * the most frequent stacks are always kept, and no count is ever underestimated.
+     *
+     * Stacks are distributed over independently locked shards by their hash,
+     * so concurrent threads rarely contend on the same lock.
+     */
+    class StackTraceAggregator final {
+    public:
+        static constexpr usize shard_count = 16;
+
+    private:
+        struct Entry final {
+            u64 hash;
+            u64 count;
+            u64 error;
+            usize depth;
+        };
+
+        struct Shard final {
+            std::mutex mutex;
+            Array<Entry> entries;  // The first size entries are in use
+            usize size;
+            Array<u32> slots;      // Indices into the entries plus one, zero for empty slots
+            Array<void*> addresses;// The addresses of every entry, at the entry index times the depth
+
+            [[nodiscard]] auto get_addresses(const usize index, const usize depth) noexcept -> void** {
+                return addresses.data() + index * depth;
+            }
+
+            [[nodiscard]] auto find_slot(const usize index) const noexcept -> usize {
+                const auto mask = slots.size() - 1;
+                auto slot = static_cast<usize>(entries[index].hash) & mask;
+                while(slots[slot] != index + 1) {
+                    slot = (slot + 1) & mask;
+                }
+                return slot;
+            }
+
+            auto insert_slot(const usize index) noexcept -> void {
+                const auto mask = slots.size() - 1;
+                auto slot = static_cast<usize>(entries[index].hash) & mask;
+                while(slots[slot] != 0) {
+                    slot = (slot + 1) & mask;
+                }
+                slots[slot] = static_cast<u32>(index + 1);
+            }
+
+            auto erase_slot(const usize index) noexcept -> void {
+                // Shift back following slots which would not be reachable across the hole anymore
+                const auto mask = slots.size() - 1;
+                auto hole = find_slot(index);
+                auto next = (hole + 1) & mask;
+                while(slots[next] != 0) {
+                    const auto home = static_cast<usize>(entries[slots[next] - 1].hash) & mask;
+                    if(((next - home) & mask) >= ((next - hole) & mask)) {
+                        slots[hole] = slots[next];
+                        hole = next;
+                    }
+                    next = (next + 1) & mask;
+                }
+                slots[hole] = 0;
+            }
+
+            /**
+             * @return True if another stack was evicted to make room for the given one.
+             */
+            auto add(const u64 hash, void* const* stack, const usize depth, const usize max_depth) noexcept -> bool {
+                const auto mask = slots.size() - 1;
+                auto slot = static_cast<usize>(hash) & mask;
+                while(slots[slot] != 0) {
+                    const auto index = slots[slot] - 1;
+                    auto& entry = entries[index];
+                    if(entry.hash == hash && entry.depth == depth &&
+                       memcmp(get_addresses(index, max_depth), stack, depth * sizeof(void*)) == 0) {
+                        ++entry.count;
+                        return false;
+                    }
+                    slot = (slot + 1) & mask;
+                }
+                if(size < entries.size()) {
+                    const auto index = size++;
+                    entries[index] = {hash, 1, 0, depth};
+                    memcpy(get_addresses(index, max_depth), stack, depth * sizeof(void*));
+                    slots[slot] = static_cast<u32>(index + 1);
+                    return false;
+                }
+                usize index = 0;
+                for(usize i = 1; i < size; ++i) {
+                    if(entries[i].count < entries[index].count) {
+                        index = i;
+                    }
+                }
+                erase_slot(index);
+                const auto min_count = entries[index].count;
+                entries[index] = {hash, min_count + 1, min_count, depth};
+                memcpy(get_addresses(index, max_depth), stack, depth * sizeof(void*));
+                insert_slot(index);
+                return true;
+            }
+
+            auto clear() noexcept -> void {
+                size = 0;
+                for(auto& value : slots) {
+                    value = 0;
+                }
+            }
+        };
+
+        usize _depth;
+        usize _skip;
+        FixedArray<Shard, shard_count> _shards;
+        Atomic<u64> _total_count;
+        Atomic<u64> _eviction_count;
+
+        [[nodiscard]] static auto get_shard_index(const u64 hash) noexcept -> usize {
+            // The low bits select the slot inside of the shard
+            return static_cast<usize>(hash >> 60) & (shard_count - 1);
+        }
+
+    public:
+        /**
+         * @param capacity The maximum number of unique stacks, rounded up to a multiple of the shard count.
+         * @param depth The maximum number of frames compared and kept per stack, deeper frames are ignored.
+         * @param skip The number of innermost frames to leave out of every stack, like the frames of an error reporting helper.
+         */
+        explicit StackTraceAggregator(const usize capacity = 1024, const usize depth = 32, const usize skip = 0) noexcept
+            : _depth(min(max<usize>(depth, 1), StackTrace::max_depth))
+            , _skip(skip)
+            , _shards()
+            , _total_count(0)
+            , _eviction_count(0) {
+            const auto shard_capacity = max<usize>((capacity + shard_count - 1) / shard_count, 1);
+            usize slot_count = 1;
+            while(slot_count < shard_capacity << 1) {
+                slot_count <<= 1;
+            }
+            for(usize i = 0; i < shard_count; ++i) {
+                auto& shard = _shards[i];
+                shard.entries = Array<Entry>(shard_capacity);
+                shard.size = 0;
+                shard.slots = Array<u32>(slot_count, 0);
+                shard.addresses = Array<void*>(shard_capacity * _depth, nullptr);
+            }
+        }
+
+        KSTD_NO_MOVE_COPY(StackTraceAggregator, StackTraceAggregator)
+        ~StackTraceAggregator() noexcept = default;
+
+        /**
+         * Counts the given return addresses, innermost first. Together with StackTrace::capture,
+         * this records a stack without constructing a StackTrace.
+         */
+        auto add(void* const* addresses, const usize count) noexcept -> void {
+            const auto first = min(_skip, count);
+            const auto depth = min(_depth, count - first);
+            const auto hash = StackTrace::hash_addresses(addresses + first, depth);
+            _total_count.fetch_add(1, std::memory_order_relaxed);
+            auto& shard = _shards[get_shard_index(hash)];
+            const std::lock_guard guard(shard.mutex);
+            if(shard.add(hash, addresses + first, depth, _depth)) {
+                _eviction_count.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        auto add(const StackTrace& trace) noexcept -> void {
+            const auto addresses = trace.get_addresses();
+            add(addresses.data(), addresses.size());
+        }
+
+        /**
+         * @param limit The maximum number of stacks to return.
+         * @return The most frequent stacks in descending order of their counts, with all traces symbolized.
+         */
+        [[nodiscard]] auto get_counts(const usize limit = static_cast<usize>(-1)) noexcept -> Array<StackTraceCount> {
+            Array<StackTraceCount> counts {};
+            counts.reserve(get_capacity());
+            for(usize shard_index = 0; shard_index < shard_count; ++shard_index) {
+                auto& shard = _shards[shard_index];
+                const std::lock_guard guard(shard.mutex);
+                for(usize i = 0; i < shard.size; ++i) {
+                    const auto& entry = shard.entries[i];
+                    counts.emplace_back(StackTrace::from_addresses(shard.get_addresses(i, _depth), entry.depth), entry.count,
+                                        entry.error);
+                }
+            }
+            std::sort(counts.begin(), counts.end(), [](const StackTraceCount& lhs, const StackTraceCount& rhs) {
+                return lhs.count > rhs.count;
+            });
+            if(counts.size() > limit) {
+                counts.resize(limit);
+            }
+            for(const auto& count : counts) {
+                count.trace.symbolize();
+            }
+            return counts;
+        }
+
+        /**
+         * Forgets all stacks and resets the counters.
+         */
+        auto clear() noexcept -> void {
+            for(usize i = 0; i < shard_count; ++i) {
+                auto& shard = _shards[i];
+                const std::lock_guard guard(shard.mutex);
+                shard.clear();
+            }
+            _total_count.store(0, std::memory_order_relaxed);
+            _eviction_count.store(0, std::memory_order_relaxed);
+        }
+
+        /**
+         * @return The maximum number of unique stacks.
+         */
+        [[nodiscard]] auto get_capacity() const noexcept -> usize {
+            return _shards[0].entries.size() * shard_count;
+        }
+
+        /**
+         * @return The number of stacks added, including duplicates.
+         */
+        [[nodiscard]] auto get_total_count() const noexcept -> u64 {
+            return _total_count.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @return The number of stacks which were replaced by a new stack because the aggregator was full.
+         */
+        [[nodiscard]] auto get_eviction_count() const noexcept -> u64 {
+            return _eviction_count.load(std::memory_order_relaxed);
+        }
+    };
+}// namespace kstd
\ No newline at end of file
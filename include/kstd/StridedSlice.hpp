@@ -0,0 +1,169 @@
+// Copyright 2024 Karma Krafts & associates
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "Defaults.hpp"
+#include "Panic.hpp"
+#include "Slice.hpp"
+#include "Types.hpp"
+
+namespace kstd {
+    /**
+     * A non-owning view over every stride-th element of a buffer, for example
+     * a single column of a row-major matrix. Use a const-qualified T for a
+     * read-only view.
+     *
+     * @tparam T The type of the viewed elements.
+     */
+    template<typename T>
+    struct StridedSlice final {
+        using value_type = T;
+
+    private:
+        using self_type = StridedSlice<value_type>;
+
+        /**
+         * Tracks an element index rather than a pointer, since stepping a pointer by the stride
+         * past the last element would leave the buffer.
+         */
+        class Iterator final {
+            T* _data;
+            usize _index;
+            usize _stride;
+
+        public:
+            Iterator(T* data, const usize index, const usize stride) noexcept
+                : _data(data)
+                , _index(index)
+                , _stride(stride) {
+            }
+
+            KSTD_DEFAULT_MOVE_COPY(Iterator, Iterator)
+            ~Iterator() noexcept = default;
+
+            [[nodiscard]] auto operator==(const Iterator& other) const noexcept -> bool {
+                return _index == other._index;
+            }
+
+            auto operator++() noexcept -> Iterator& {
+                ++_index;
+                return *this;
+            }
+
+            [[nodiscard]] auto operator*() const noexcept -> T& {
+                return _data[_index * _stride];
+            }
+        };
+
+        T* _data;
+        usize _size;
+        usize _stride;
+
+    public:
+        using iterator = Iterator;
+
+        StridedSlice() noexcept
+            : _data(nullptr)
+            , _size(0)
+            , _stride(1) {
+        }
+
+        /**
+         * @param data A pointer to the first viewed element.
+         * @param size The number of viewed elements.
+         * @param stride The distance between two viewed elements, in elements.
+         */
+        StridedSlice(T* data, const usize size, const usize stride) noexcept
+            : _data(data)
+            , _size(size)
+            , _stride(stride) {
+            if(stride == 0) {
+                panic("Stride must not be zero");
+            }
+        }
+
+        KSTD_DEFAULT_MOVE_COPY(StridedSlice, self_type, inline)
+        ~StridedSlice() noexcept = default;
+
+        /**
+         * Creates a view over a single column of a row-major buffer.
+         *
+         * @param data A pointer to the first element of the buffer.
+         * @param rows The number of rows in the buffer.
+         * @param columns The number of elements per row.
+         * @param column The index of the column to view.
+         */
+        [[nodiscard]] static auto of_column(T* data, const usize rows, const usize columns, const usize column) noexcept -> self_type {
+            if(column >= columns) {
+                panic("Column index out of bounds");
+            }
+            return {data + column, rows, columns};
+        }
+
+        [[nodiscard]] auto begin() const noexcept -> iterator {
+            return {_data, 0, _stride};
+        }
+
+        [[nodiscard]] auto end() const noexcept -> iterator {
+            return {_data, _size, _stride};
+        }
+
+        [[nodiscard]] auto size() const noexcept -> usize {
+            return _size;
+        }
+
+        [[nodiscard]] auto is_empty() const noexcept -> bool {
+            return _size == 0;
+        }
+
+        [[nodiscard]] auto get_stride() const noexcept -> usize {
+            return _stride;
+        }
+
+        [[nodiscard]] auto data() const noexcept -> T* {
+            return _data;
+        }
+
+        /**
+         * @return True if the viewed elements are adjacent in memory and can be viewed as a regular slice.
+         */
+        [[nodiscard]] auto is_contiguous() const noexcept -> bool {
+            return _stride == 1;
+        }
+
+        [[nodiscard]] auto operator[](const usize index) const noexcept -> T& {
+            return _data[index * _stride];
+        }
+
+        [[nodiscard]] auto sub_slice(const usize start, const usize end) const noexcept -> self_type {
+            if(start == end) {
+                return {_data, 0, _stride};// An empty tail would start past the buffer
+            }
+            return {_data + start * _stride, end - start, _stride};
+        }
+
+        /**
+         * Gathers the viewed elements into a contiguous destination buffer.
+         *
+         * @param dst The buffer to copy into.
+         * @param size The maximum number of elements to copy.
+         */
+        auto copy_to(remove_const<T>* dst, const usize size) const noexcept -> void {
+            const auto count = min(size, _size);
+            for(usize i = 0; i < count; ++i) {
+                dst[i] = _data[i * _stride];
+            }
+        }
+    };
+}// namespace kstd
\ No newline at end of file
@@ -13,15 +13,452 @@
 
 #pragma once
 
-#include <fmt/format.h>
-
+#include "Allocator.hpp"
 #include "Concepts.hpp"
+#include "Defaults.hpp"
+#include "Math.hpp"
+#include "Panic.hpp"
+#include "StringView.hpp"
+#include "System.hpp"
+#include "Types.hpp"
+#include "Utility.hpp"
 
 namespace kstd {
-    template<concepts::Integer T>
+    /**
+     * An owning, null-terminated string with small-string optimization.
+     * Strings of up to inline_capacity characters (23 for char on 64-bit targets)
+     * are stored inside the object itself, longer strings are allocated through TAllocator.
+     *
+     * The last character slot of the inline buffer holds the remaining inline capacity,
+     * which doubles as the null terminator once the inline buffer is full.
+     * In heap mode, the highest bit of that byte is set.
+     *
+     * @tparam T The character type of the string.
+     * @tparam TAllocator The allocator used once the string outgrows the inline buffer.
+     */
+    template<concepts::Integer T, concepts::Allocator<T> TAllocator = Allocator<T>>
     struct BasicString final {
+        using char_type = T;
+        using allocator_type = TAllocator;
+        using view_type = BasicStringView<char_type>;
+        using slice_type = Slice<char_type>;
+        using iterator = char_type*;
+        using const_iterator = const char_type*;
+
+        static constexpr usize npos = view_type::npos;
+
+    private:
+        using self_type = BasicString<char_type, TAllocator>;
+
+        struct HeapData final {
+            char_type* data;
+            usize size;
+            usize capacity;// Encoded, see encode_capacity
+        };
+
+        static constexpr usize storage_size = sizeof(HeapData);
+        static constexpr u8 heap_flag = 0x80;
+        static constexpr usize tag_shift = (sizeof(usize) - 1) << 3;
+
+    public:
+        static constexpr usize inline_capacity = storage_size / sizeof(char_type) - 1;
+
+    private:
+        static_assert(inline_capacity < heap_flag, "Inline capacity does not fit into the tag byte");
+
+        union Storage {
+            HeapData heap;
+            char_type inline_data[inline_capacity + 1];
+        };
+
+        KSTD_NO_UNIQUE_ADDRESS TAllocator _allocator;
+        Storage _storage;
+
+        [[nodiscard]] static constexpr auto encode_capacity(const usize capacity) noexcept -> usize {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+            return (capacity << 8) | heap_flag;
+#else
+            return capacity | (static_cast<usize>(heap_flag) << tag_shift);
+#endif
+        }
+
+        [[nodiscard]] static constexpr auto decode_capacity(const usize capacity) noexcept -> usize {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+            return capacity >> 8;
+#else
+            return capacity & ~(static_cast<usize>(0xFF) << tag_shift);
+#endif
+        }
+
+        [[nodiscard]] auto is_inline() const noexcept -> bool {
+            return (reinterpret_cast<const u8*>(&_storage)[storage_size - 1] & heap_flag) == 0;
+        }
+
+        auto set_inline_size(const usize size) noexcept -> void {
+            _storage.inline_data[size] = static_cast<char_type>(0);
+            _storage.inline_data[inline_capacity] = static_cast<char_type>(inline_capacity - size);
+        }
+
+        auto set_size(const usize size) noexcept -> void {
+            if(is_inline()) {
+                set_inline_size(size);
+                return;
+            }
+            _storage.heap.size = size;
+            _storage.heap.data[size] = static_cast<char_type>(0);
+        }
+
+        auto reallocate_internal(const usize capacity) noexcept -> void {
+            const auto old_size = size();
+            auto* memory = _allocator.allocate(capacity + 1);// Account for the null terminator
+            auto new_capacity = capacity;
+            if constexpr(requires(TAllocator allocator, char_type* value) { allocator.get_usable_size(value); }) {
+                // Claim any slack the allocator handed out anyway, so the next growth happens later
+                new_capacity = max(capacity, _allocator.get_usable_size(memory) - 1);
+            }
+            memcpy(memory, data(), (old_size + 1) * sizeof(char_type));
+            if(!is_inline()) {
+                _allocator.free(_storage.heap.data);
+            }
+            _storage.heap.data = memory;
+            _storage.heap.size = old_size;
+            _storage.heap.capacity = encode_capacity(new_capacity);
+        }
+
+        auto grow(const usize required) noexcept -> void {
+            const auto current = capacity();
+            if(required <= current) {
+                return;
+            }
+            reallocate_internal(max(required, current + (current >> 1)));
+        }
+
+        /**
+         * Copies more characters than fit inline into a new heap buffer. Never inlined, so a small
+         * source buffer of the caller can't make the compiler warn about this path, which allocates anyway.
+         */
+        KSTD_NOINLINE auto init_heap(const char_type* data, const usize size) noexcept -> void {
+            auto* memory = _allocator.allocate(size + 1);
+            auto capacity = size;
+            if constexpr(requires(TAllocator allocator, char_type* value) { allocator.get_usable_size(value); }) {
+                capacity = max(size, _allocator.get_usable_size(memory) - 1);
+            }
+            memcpy(memory, data, size * sizeof(char_type));
+            memory[size] = static_cast<char_type>(0);
+            _storage.heap.data = memory;
+            _storage.heap.size = size;
+            _storage.heap.capacity = encode_capacity(capacity);
+        }
+
+        auto init(const char_type* data, const usize size) noexcept -> void {
+            if(size <= inline_capacity) {
+                memcpy(_storage.inline_data, data, size * sizeof(char_type));
+                set_inline_size(size);
+                return;
+            }
+            init_heap(data, size);
+        }
+
+        auto release() noexcept -> void {
+            if(!is_inline()) {
+                _allocator.free(_storage.heap.data);
+            }
+            set_inline_size(0);
+        }
+
+    public:
+        BasicString() noexcept
+            : _allocator() {
+            set_inline_size(0);
+        }
+
+        BasicString(const char_type* data, const usize size) noexcept
+            : _allocator() {
+            init(data, size);
+        }
+
+        BasicString(const char_type* data) noexcept// NOLINT
+            : BasicString(data, system::get_string_length(data)) {
+        }
+
+        BasicString(const view_type& view) noexcept// NOLINT
+            : BasicString(view.data(), view.length()) {
+        }
+
+        BasicString(const usize count, const char_type value) noexcept
+            : _allocator() {
+            set_inline_size(0);
+            resize(count, value);
+        }
+
+        BasicString(const self_type& other) noexcept
+            : _allocator() {
+            if(other.is_inline()) {
+                _storage = other._storage;
+                return;
+            }
+            init(other._storage.heap.data, other._storage.heap.size);
+        }
+
+        BasicString(self_type&& other) noexcept
+            : _allocator(move(other._allocator))
+            , _storage(other._storage) {
+            other.set_inline_size(0);
+        }
+
+        ~BasicString() noexcept {
+            if(!is_inline()) {
+                _allocator.free(_storage.heap.data);
+            }
+        }
+
+        auto operator=(const self_type& other) noexcept -> self_type& {
+            if(&other == this) {
+                return *this;
+            }
+            clear();
+            append(other.data(), other.size());
+            return *this;
+        }
+
+        auto operator=(self_type&& other) noexcept -> self_type& {
+            if(&other == this) {
+                return *this;
+            }
+            release();
+            _allocator = move(other._allocator);
+            _storage = other._storage;
+            other.set_inline_size(0);
+            return *this;
+        }
+
+        auto operator=(const view_type& view) noexcept -> self_type& {
+            clear();
+            append(view.data(), view.length());
+            return *this;
+        }
+
+        auto operator=(const char_type* value) noexcept -> self_type& {
+            clear();
+            append(value, system::get_string_length(value));
+            return *this;
+        }
+
+        [[nodiscard]] operator view_type() const noexcept {
+            return {data(), size()};
+        }
+
+        [[nodiscard]] operator slice_type() const noexcept {
+            return {data(), size()};
+        }
+
+        [[nodiscard]] auto get_view() const noexcept -> view_type {
+            return {data(), size()};
+        }
 
+        [[nodiscard]] auto data() noexcept -> char_type* {
+            return is_inline() ? _storage.inline_data : _storage.heap.data;
+        }
+
+        [[nodiscard]] auto data() const noexcept -> const char_type* {
+            return is_inline() ? _storage.inline_data : _storage.heap.data;
+        }
+
+        [[nodiscard]] auto c_str() const noexcept -> const char_type* {
+            return data();
+        }
+
+        [[nodiscard]] auto size() const noexcept -> usize {
+            if(is_inline()) {
+                return inline_capacity - static_cast<usize>(_storage.inline_data[inline_capacity]);
+            }
+            return _storage.heap.size;
+        }
+
+        [[nodiscard]] auto length() const noexcept -> usize {
+            return size();
+        }
+
+        [[nodiscard]] auto capacity() const noexcept -> usize {
+            return is_inline() ? inline_capacity : decode_capacity(_storage.heap.capacity);
+        }
+
+        [[nodiscard]] auto is_empty() const noexcept -> bool {
+            return size() == 0;
+        }
+
+        [[nodiscard]] auto begin() noexcept -> iterator {
+            return data();
+        }
+
+        [[nodiscard]] auto end() noexcept -> iterator {
+            return data() + size();
+        }
+
+        [[nodiscard]] auto begin() const noexcept -> const_iterator {
+            return data();
+        }
+
+        [[nodiscard]] auto end() const noexcept -> const_iterator {
+            return data() + size();
+        }
+
+        [[nodiscard]] auto cbegin() const noexcept -> const_iterator {
+            return data();
+        }
+
+        [[nodiscard]] auto cend() const noexcept -> const_iterator {
+            return data() + size();
+        }
+
+        auto reserve(const usize capacity) noexcept -> void {
+            if(capacity <= this->capacity()) {
+                return;
+            }
+            reallocate_internal(capacity);
+        }
+
+        auto resize(const usize size, const char_type value = static_cast<char_type>(0)) noexcept -> void {
+            const auto old_size = this->size();
+            grow(size);
+            auto* memory = data();
+            for(usize i = old_size; i < size; ++i) {
+                memory[i] = value;
+            }
+            set_size(size);
+        }
+
+        /**
+         * Resizes the string without writing the newly added characters,
+         * which hold indeterminate values until they are written.
+         */
+        auto resize_uninitialized(const usize size) noexcept -> void {
+            grow(size);
+            set_size(size);
+        }
+
+        auto clear() noexcept -> void {
+            set_size(0);
+        }
+
+        auto append(const char_type* value, const usize count) noexcept -> self_type& {
+            const auto old_size = size();
+            const auto address = reinterpret_cast<usize>(value);
+            const auto begin = reinterpret_cast<usize>(data());
+            if(address >= begin && address < begin + old_size * sizeof(char_type)) {
+                // The source is part of this string, growing may move or overwrite it
+                const auto offset = (address - begin) / sizeof(char_type);
+                grow(old_size + count);
+                memmove(data() + old_size, data() + offset, count * sizeof(char_type));
+            }
+            else {
+                grow(old_size + count);
+                memcpy(data() + old_size, value, count * sizeof(char_type));
+            }
+            set_size(old_size + count);
+            return *this;
+        }
+
+        auto append(const view_type& view) noexcept -> self_type& {
+            return append(view.data(), view.length());
+        }
+
+        auto push_back(const char_type value) noexcept -> void {
+            const auto old_size = size();
+            grow(old_size + 1);
+            data()[old_size] = value;
+            set_size(old_size + 1);
+        }
+
+        auto pop_back() noexcept -> void {
+            const auto old_size = size();
+            if(old_size == 0) {
+                panic("No characters in string");
+            }
+            set_size(old_size - 1);
+        }
+
+        auto operator+=(const view_type& view) noexcept -> self_type& {
+            return append(view.data(), view.length());
+        }
+
+        auto operator+=(const self_type& other) noexcept -> self_type& {
+            return append(other.data(), other.size());
+        }
+
+        auto operator+=(const char_type* value) noexcept -> self_type& {
+            return append(value, system::get_string_length(value));
+        }
+
+        auto operator+=(const char_type value) noexcept -> self_type& {
+            push_back(value);
+            return *this;
+        }
+
+        [[nodiscard]] auto operator+(const view_type& view) const noexcept -> self_type {
+            self_type result {};
+            result.reserve(size() + view.length());
+            result.append(data(), size());
+            result.append(view.data(), view.length());
+            return result;
+        }
+
+        /**
+         * @param value The character to search for.
+         * @param start The index at which to start searching.
+         * @return The index of the first occurrence of value at or after start, or npos.
+         */
+        [[nodiscard]] auto find(const char_type value, const usize start = 0) const noexcept -> usize {
+            return get_view().find(value, start);
+        }
+
+        [[nodiscard]] auto find(const view_type& needle, const usize start = 0) const noexcept -> usize {
+            return get_view().find(needle, start);
+        }
+
+        /**
+         * @param start The index of the first character to copy.
+         * @param count The maximum number of characters to copy.
+         * @return A new string holding the given range of characters.
+         */
+        [[nodiscard]] auto substr(const usize start, const usize count = npos) const noexcept -> self_type {
+            const auto current_size = size();
+            if(start > current_size) {
+                panic("String index out of bounds");
+            }
+            return {data() + start, min(count, current_size - start)};
+        }
+
+        [[nodiscard]] auto operator[](const usize index) noexcept -> char_type& {
+            return data()[index];
+        }
+
+        [[nodiscard]] auto operator[](const usize index) const noexcept -> const char_type& {
+            return data()[index];
+        }
+
+        [[nodiscard]] auto operator==(const view_type& other) const noexcept -> bool {
+            const auto count = size();
+            if(count != other.length()) {
+                return false;
+            }
+            return memcmp(data(), other.data(), count * sizeof(char_type)) == 0;
+        }
+
+        [[nodiscard]] auto operator==(const self_type& other) const noexcept -> bool {
+            return *this == other.get_view();
+        }
+
+        [[nodiscard]] auto operator==(const char_type* other) const noexcept -> bool {
+            return *this == view_type(other, system::get_string_length(other));
+        }
     };
 
-    using String = std::string;
+    using String = BasicString<char>;
+    using WString = BasicString<wchar_t>;
+    using StringUTF8 = BasicString<char8_t>;
+    using StringUTF16 = BasicString<char16_t>;
+    using StringUTF32 = BasicString<char32_t>;
+
+    static_assert(sizeof(void*) != 8 || String::inline_capacity == 23);
 }// namespace kstd
\ No newline at end of file
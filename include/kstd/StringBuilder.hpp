@@ -0,0 +1,303 @@
+// Copyright 2024 Karma Krafts & associates
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include "Allocator.hpp"
+#include "Array.hpp"
+#include "Concepts.hpp"
+#include "Math.hpp"
+#include "Meta.hpp"
+#include "Number.hpp"
+#include "Slice.hpp"
+#include "String.hpp"
+#include "StringView.hpp"
+#include "Types.hpp"
+#include "Utility.hpp"
+
+namespace kstd {
+    /**
+     * Assembles a string from many fragments without ever moving what was already written.
+     * Copied text goes into a chain of geometrically growing chunks, borrowed text is only
+     * referenced. The result is exposed as a sequence of slices, for example for writev,
+     * or flattened into a single string on demand.
+     *
+     * @tparam T The character type of the assembled string.
+     * @tparam TAllocator The allocator used for the chunks.
+     */
+    template<concepts::Integer T, concepts::Allocator<T> TAllocator = Allocator<T>>
+    struct BasicStringBuilder final {
+        using char_type = T;
+        using allocator_type = TAllocator;
+        using view_type = BasicStringView<char_type>;
+        using slice_type = Slice<char_type>;
+        using string_type = BasicString<char_type>;
+
+        static constexpr usize min_chunk_size = 256;
+        static constexpr usize max_chunk_size = 1024 * 1024;
+
+    private:
+        using self_type = BasicStringBuilder<T, TAllocator>;
+
+        struct Chunk final {
+            T* data;
+            usize size;
+            usize capacity;
+        };
+
+        TAllocator _allocator;
+        Array<Chunk> _chunks;
+        Array<slice_type> _segments;
+        usize _current_chunk;
+        usize _length;
+
+        auto destroy() noexcept -> void {
+            for(auto& chunk : _chunks) {
+                _allocator.free(chunk.data);
+            }
+            _chunks = {};
+            _segments = {};
+            _current_chunk = 0;
+            _length = 0;
+        }
+
+        [[nodiscard]] auto get_next_chunk_size(const usize required) const noexcept -> usize {
+            const auto count = _chunks.size();
+            const auto previous = count == 0 ? min_chunk_size >> 1 : _chunks[count - 1].capacity;
+            return max(required, min(previous << 1, max_chunk_size));
+        }
+
+    public:
+        BasicStringBuilder() noexcept
+            : _allocator()
+            , _chunks()
+            , _segments()
+            , _current_chunk(0)
+            , _length(0) {
+        }
+
+        // Segments point into the chunks, so a copy would alias the chunks of the original
+        KSTD_NO_COPY(BasicStringBuilder, self_type)
+
+        BasicStringBuilder(self_type&& other) noexcept
+            : _allocator(move(other._allocator))
+            , _chunks(move(other._chunks))
+            , _segments(move(other._segments))
+            , _current_chunk(other._current_chunk)
+            , _length(other._length) {
+            other._current_chunk = 0;
+            other._length = 0;
+        }
+
+        ~BasicStringBuilder() noexcept {
+            destroy();
+        }
+
+        auto operator=(self_type&& other) noexcept -> self_type& {
+            if(&other == this) {
+                return *this;
+            }
+            destroy();
+            _allocator = move(other._allocator);
+            _chunks = move(other._chunks);
+            _segments = move(other._segments);
+            _current_chunk = other._current_chunk;
+            _length = other._length;
+            other._current_chunk = 0;
+            other._length = 0;
+            return *this;
+        }
+
+        /**
+         * Reserves room for writing up to count characters in place, which only become part
+         * of the string once they are committed.
+         *
+         * @param count The number of characters to make room for.
+         * @return A pointer to at least count writable characters.
+         */
+        [[nodiscard]] auto acquire(const usize count) noexcept -> T* {
+            while(_current_chunk < _chunks.size()) {
+                auto& chunk = _chunks[_current_chunk];
+                if(chunk.capacity - chunk.size >= count) {
+                    return chunk.data + chunk.size;
+                }
+                if(_current_chunk + 1 == _chunks.size()) {
+                    break;
+                }
+                ++_current_chunk;// Chunks retained by clear are reused first
+            }
+            const auto capacity = get_next_chunk_size(count);
+            _chunks.reserve_amortized(_chunks.size() + 1);
+            _chunks.push_back({_allocator.allocate(capacity), 0, capacity});
+            _current_chunk = _chunks.size() - 1;
+            return _chunks[_current_chunk].data;
+        }
+
+        /**
+         * @return The number of characters which may be written to the pointer returned by the last call to acquire.
+         */
+        [[nodiscard]] auto get_available() const noexcept -> usize {
+            if(_current_chunk >= _chunks.size()) {
+                return 0;
+            }
+            const auto& chunk = _chunks[_current_chunk];
+            return chunk.capacity - chunk.size;
+        }
+
+        /**
+         * Appends count characters which were written to the pointer returned by the last call to acquire.
+         */
+        auto commit(const usize count) noexcept -> void {
+            if(count == 0) {
+                return;
+            }
+            auto& chunk = _chunks[_current_chunk];
+            const auto* start = chunk.data + chunk.size;
+            chunk.size += count;
+            _length += count;
+            const auto segment_count = _segments.size();
+            if(segment_count != 0) {
+                auto& last = _segments[segment_count - 1];
+                if(last.data() + last.size() == start) {
+                    last = slice_type(last.data(), last.size() + count);
+                    return;
+                }
+            }
+            _segments.reserve_amortized(_segments.size() + 1);
+            _segments.push_back(slice_type(start, count));
+        }
+
+        auto append(const view_type& value) noexcept -> self_type& {
+            const auto count = value.length();
+            if(count == 0) {
+                return *this;
+            }
+            memcpy(acquire(count), value.data(), count * sizeof(T));
+            commit(count);
+            return *this;
+        }
+
+        auto append(const char_type value) noexcept -> self_type& {
+            *acquire(1) = value;
+            commit(1);
+            return *this;
+        }
+
+        /**
+         * Appends the decimal representation of a number, floats use their shortest round-trip form.
+         */
+        template<concepts::Number TValue>
+        auto append(const TValue value) noexcept -> self_type& {
+            if constexpr(is_same<char_type, char>) {
+                commit(to_chars(acquire(number::max_chars<TValue>), value));
+            }
+            else {
+                char buffer[number::max_chars<TValue>];
+                const auto count = to_chars(buffer, value);
+                auto* data = acquire(count);
+                for(usize i = 0; i < count; ++i) {
+                    data[i] = static_cast<T>(buffer[i]);
+                }
+                commit(count);
+            }
+            return *this;
+        }
+
+        /**
+         * Appends a reference to the given text without copying it.
+         * The referenced memory has to outlive every use of this builder's segments.
+         */
+        auto append_borrowed(const view_type& value) noexcept -> self_type& {
+            if(value.length() == 0) {
+                return *this;
+            }
+            _segments.reserve_amortized(_segments.size() + 1);
+            _segments.push_back(slice_type(value.data(), value.length()));
+            _length += value.length();
+            return *this;
+        }
+
+        template<typename TValue>
+        auto operator<<(const TValue& value) noexcept -> self_type& {
+            return append(value);
+        }
+
+        /**
+         * Removes all text but keeps the chunks for reuse.
+         */
+        auto clear() noexcept -> void {
+            for(auto& chunk : _chunks) {
+                chunk.size = 0;
+            }
+            _segments = {};
+            _current_chunk = 0;
+            _length = 0;
+        }
+
+        [[nodiscard]] auto length() const noexcept -> usize {
+            return _length;
+        }
+
+        [[nodiscard]] auto is_empty() const noexcept -> bool {
+            return _length == 0;
+        }
+
+        /**
+         * @return The text in order, as contiguous slices into chunks and borrowed memory.
+         */
+        [[nodiscard]] auto get_segments() const noexcept -> Slice<slice_type> {
+            return {_segments.data(), _segments.size()};
+        }
+
+        [[nodiscard]] auto get_segment_count() const noexcept -> usize {
+            return _segments.size();
+        }
+
+        /**
+         * @param dst The buffer to copy into.
+         * @param size The maximum number of characters to copy.
+         * @return The number of copied characters.
+         */
+        auto copy_to(T* dst, const usize size) const noexcept -> usize {
+            usize offset = 0;
+            for(const auto& segment : _segments) {
+                const auto count = min(segment.size(), size - offset);
+                memcpy(dst + offset, segment.data(), count * sizeof(T));
+                offset += count;
+                if(offset == size) {
+                    break;
+                }
+            }
+            return offset;
+        }
+
+        /**
+         * @return The whole text as a single string, allocated once.
+         */
+        [[nodiscard]] auto flatten() const noexcept -> string_type {
+            string_type result {};
+            result.reserve(_length);
+            for(const auto& segment : _segments) {
+                result.append(segment.data(), segment.size());
+            }
+            return result;
+        }
+    };
+
+    using StringBuilder = BasicStringBuilder<char>;
+    using WStringBuilder = BasicStringBuilder<wchar_t>;
+    using StringBuilderUTF8 = BasicStringBuilder<char8_t>;
+    using StringBuilderUTF16 = BasicStringBuilder<char16_t>;
+    using StringBuilderUTF32 = BasicStringBuilder<char32_t>;
+}// namespace kstd
\ No newline at end of file
@@ -15,16 +15,176 @@
 
 #include "Concepts.hpp"
 #include "Defaults.hpp"
+#include "Math.hpp"
+#include "Panic.hpp"
+#include "Search.hpp"
 #include "Slice.hpp"
 #include "Types.hpp"
+#include "Utility.hpp"
 
 namespace kstd {
+    template<concepts::Integer T>
+    struct BasicStringView;
+
+    /**
+     * A lazy range over the parts of a string view between occurrences of a delimiter.
+     * Adjacent delimiters yield empty parts, nothing is allocated.
+     *
+     * @tparam T The character type of the viewed string.
+     */
+    template<concepts::Integer T>
+    class StringSplitRange final {
+        using view_type = BasicStringView<T>;
+
+        class Iterator final {
+            const StringSplitRange* _range;
+            view_type _remaining;
+            usize _length;
+            bool _is_finished;
+
+        public:
+            Iterator(const StringSplitRange* range, const view_type& remaining, const bool is_finished) noexcept
+                : _range(range)
+                , _remaining(remaining)
+                , _length(0)
+                , _is_finished(is_finished) {
+                if(!_is_finished) {
+                    _length = _range->find_delimiter(_remaining);
+                }
+            }
+
+            KSTD_DEFAULT_MOVE_COPY(Iterator, Iterator)
+            ~Iterator() noexcept = default;
+
+            [[nodiscard]] auto operator==(const Iterator& other) const noexcept -> bool {
+                if(_is_finished || other._is_finished) {
+                    return _is_finished == other._is_finished;
+                }
+                return _remaining.data() == other._remaining.data();
+            }
+
+            auto operator++() noexcept -> Iterator& {
+                if(_length == _remaining.length()) {
+                    _is_finished = true;
+                    return *this;
+                }
+                _remaining = _remaining.substr(_length + _range->get_delimiter_length());
+                _length = _range->find_delimiter(_remaining);
+                return *this;
+            }
+
+            [[nodiscard]] auto operator*() const noexcept -> view_type {
+                return _remaining.substr(0, _length);
+            }
+        };
+
+        view_type _view;
+        view_type _delimiter;// Empty when splitting on a single character
+        T _character;
+
+        [[nodiscard]] auto find_delimiter(const view_type& view) const noexcept -> usize {
+            const auto index = _delimiter.is_empty() ? view.find(_character) : view.find(_delimiter);
+            return min(index, view.length());
+        }
+
+        [[nodiscard]] auto get_delimiter_length() const noexcept -> usize {
+            return _delimiter.is_empty() ? 1 : _delimiter.length();
+        }
+
+    public:
+        StringSplitRange(const view_type& view, const view_type& delimiter) noexcept
+            : _view(view)
+            , _delimiter(delimiter)
+            , _character() {
+        }
+
+        StringSplitRange(const view_type& view, const T character) noexcept
+            : _view(view)
+            , _delimiter()
+            , _character(character) {
+        }
+
+        KSTD_DEFAULT_MOVE_COPY(StringSplitRange, StringSplitRange)
+        ~StringSplitRange() noexcept = default;
+
+        [[nodiscard]] auto begin() const noexcept -> Iterator {
+            return {this, _view, false};
+        }
+
+        [[nodiscard]] auto end() const noexcept -> Iterator {
+            return {this, _view, true};
+        }
+    };
+
+    /**
+     * A lazy range over the lines of a string view. Lines end at a line feed, a preceding
+     * carriage return is stripped and a trailing line feed does not produce an empty last line.
+     *
+     * @tparam T The character type of the viewed string.
+     */
+    template<concepts::Integer T>
+    class LineRange final {
+        using view_type = BasicStringView<T>;
+
+        class Iterator final {
+            view_type _remaining;
+            usize _length;
+
+        public:
+            explicit Iterator(const view_type& remaining) noexcept
+                : _remaining(remaining)
+                , _length(min(remaining.find(static_cast<T>('\n')), remaining.length())) {
+            }
+
+            KSTD_DEFAULT_MOVE_COPY(Iterator, Iterator)
+            ~Iterator() noexcept = default;
+
+            [[nodiscard]] auto operator==(const Iterator& other) const noexcept -> bool {
+                return _remaining.length() == other._remaining.length();
+            }
+
+            auto operator++() noexcept -> Iterator& {
+                _remaining = _remaining.substr(min(_length + 1, _remaining.length()));
+                _length = min(_remaining.find(static_cast<T>('\n')), _remaining.length());
+                return *this;
+            }
+
+            [[nodiscard]] auto operator*() const noexcept -> view_type {
+                auto line = _remaining.substr(0, _length);
+                if(line.ends_with(static_cast<T>('\r'))) {
+                    line = line.substr(0, line.length() - 1);
+                }
+                return line;
+            }
+        };
+
+        view_type _view;
+
+    public:
+        explicit LineRange(const view_type& view) noexcept
+            : _view(view) {
+        }
+
+        KSTD_DEFAULT_MOVE_COPY(LineRange, LineRange)
+        ~LineRange() noexcept = default;
+
+        [[nodiscard]] auto begin() const noexcept -> Iterator {
+            return Iterator(_view);
+        }
+
+        [[nodiscard]] auto end() const noexcept -> Iterator {
+            return Iterator(_view.substr(_view.length()));
+        }
+    };
+
     template<concepts::Integer T>
     struct BasicStringView final {
         using char_type = T;
         using slice_type = Slice<char_type>;
         using const_iterator = const char_type*;
 
+        static constexpr usize npos = search::npos;
+
     private:
         using self_type = BasicStringView<char_type>;
 
@@ -51,6 +211,14 @@ namespace kstd {
             return {_data, _length};
         }
 
+        [[nodiscard]] auto begin() const noexcept -> const_iterator {
+            return _data;
+        }
+
+        [[nodiscard]] auto end() const noexcept -> const_iterator {
+            return _data + _length;
+        }
+
         [[nodiscard]] auto cbegin() const noexcept -> const_iterator {
             return _data;
         }
@@ -59,13 +227,147 @@ namespace kstd {
             return _data + _length;
         }
 
-        [[nodiscard]] auto data() const noexcept -> const char_type* {
+        [[nodiscard]] constexpr auto data() const noexcept -> const char_type* {
             return _data;
         }
 
-        [[nodiscard]] auto length() const noexcept -> usize {
+        [[nodiscard]] constexpr auto length() const noexcept -> usize {
             return _length;
         }
+
+        [[nodiscard]] constexpr auto is_empty() const noexcept -> bool {
+            return _length == 0;
+        }
+
+        [[nodiscard]] constexpr auto operator[](const usize index) const noexcept -> const char_type& {
+            return _data[index];
+        }
+
+        /**
+         * @param start The index of the first character of the sub-view, clamped to the length.
+         * @param count The maximum number of characters in the sub-view.
+         */
+        [[nodiscard]] auto substr(const usize start, const usize count = npos) const noexcept -> self_type {
+            const auto offset = min(start, _length);
+            return {_data + offset, min(count, _length - offset)};
+        }
+
+        /**
+         * @return The index of the first occurrence of value at or after start, or npos.
+         */
+        [[nodiscard]] auto find(const char_type value, const usize start = 0) const noexcept -> usize {
+            if(start >= _length) {
+                return npos;
+            }
+            const auto index = search::find(_data + start, _length - start, value);
+            return index == npos ? npos : index + start;
+        }
+
+        /**
+         * @return The index of the first occurrence of needle at or after start, or npos.
+         */
+        [[nodiscard]] auto find(const self_type& needle, const usize start = 0) const noexcept -> usize {
+            if(start > _length) {
+                return npos;
+            }
+            const auto index = search::find(_data + start, _length - start, needle._data, needle._length);
+            return index == npos ? npos : index + start;
+        }
+
+        /**
+         * @return The index of the last occurrence of value, or npos.
+         */
+        [[nodiscard]] auto find_last(const char_type value) const noexcept -> usize {
+            return search::find_last(_data, _length, value);
+        }
+
+        /**
+         * @param set The characters to look for.
+         * @return The index of the first character which is part of the given set, or npos.
+         */
+        [[nodiscard]] auto find_any_of(const self_type& set, const usize start = 0) const noexcept -> usize {
+            if(start >= _length) {
+                return npos;
+            }
+            usize index = npos;
+            if constexpr(search::Byte<char_type>) {
+                index = search::find_any_of(_data + start, _length - start, search::ByteSet(set._data, set._length));
+            }
+            else {
+                index = search::find_any_of(_data + start, _length - start, set._data, set._length);
+            }
+            return index == npos ? npos : index + start;
+        }
+
+        /**
+         * Searches with a prebuilt set, so repeated scans do not rebuild the lookup tables.
+         */
+        [[nodiscard]] auto find_any_of(const search::ByteSet& set, const usize start = 0) const noexcept -> usize
+        requires(search::Byte<char_type>)
+        {
+            if(start >= _length) {
+                return npos;
+            }
+            const auto index = search::find_any_of(_data + start, _length - start, set);
+            return index == npos ? npos : index + start;
+        }
+
+        [[nodiscard]] auto contains(const self_type& needle) const noexcept -> bool {
+            return find(needle) != npos;
+        }
+
+        [[nodiscard]] auto starts_with(const self_type& prefix) const noexcept -> bool {
+            return prefix._length <= _length && memcmp(_data, prefix._data, prefix._length * sizeof(char_type)) == 0;
+        }
+
+        [[nodiscard]] auto starts_with(const char_type value) const noexcept -> bool {
+            return _length != 0 && _data[0] == value;
+        }
+
+        [[nodiscard]] auto ends_with(const self_type& suffix) const noexcept -> bool {
+            return suffix._length <= _length &&
+                   memcmp(_data + _length - suffix._length, suffix._data, suffix._length * sizeof(char_type)) == 0;
+        }
+
+        [[nodiscard]] auto ends_with(const char_type value) const noexcept -> bool {
+            return _length != 0 && _data[_length - 1] == value;
+        }
+
+        /**
+         * @return A lazy range over the parts between occurrences of the given delimiter.
+         */
+        [[nodiscard]] auto split(const self_type& delimiter) const noexcept -> StringSplitRange<char_type> {
+            if(delimiter._length == 0) {
+                panic("Delimiter must not be empty");
+            }
+            return {*this, delimiter};
+        }
+
+        [[nodiscard]] auto split(const char_type delimiter) const noexcept -> StringSplitRange<char_type> {
+            return {*this, delimiter};
+        }
+
+        /**
+         * @return A lazy range over the lines of this view.
+         */
+        [[nodiscard]] auto lines() const noexcept -> LineRange<char_type> {
+            return LineRange<char_type>(*this);
+        }
+
+        [[nodiscard]] constexpr auto operator==(const self_type& other) const noexcept -> bool {
+            if(_length != other._length) {
+                return false;
+            }
+            if(is_constant_evaluated()) {
+                for(usize i = 0; i < _length; ++i) {
+                    if(_data[i] != other._data[i]) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+            return memcmp(_data, other._data, _length * sizeof(char_type)) == 0;
+        }
     };
 
     using StringView = BasicStringView<char>;
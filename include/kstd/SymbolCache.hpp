@@ -0,0 +1,240 @@
+// Copyright 2024 Karma Krafts & associates
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+// NOLINTBEGIN
+#include <mutex>
+// NOLINTEND
+
+#include "Allocator.hpp"
+#include "Atomic.hpp"
+#include "Defaults.hpp"
+#include "Hash.hpp"
+#include "Interner.hpp"
+#include "Slice.hpp"
+#include "StackTrace.hpp"
+#include "StringView.hpp"
+#include "Types.hpp"
+
+namespace kstd {
+    /**
+     * Caches the symbolized elements of return addresses, together with an interner which owns
+     * all names referenced by StackTraceElements. Looking up an address which was symbolized
+     * before never takes the lock and never allocates, using the same scheme as ConcurrentInterner:
+     * slots are published with release stores, and tables replaced by a rehash or an invalidation
+     * are kept alive until destruction.
+     *
+     * Entries and names are never freed while the cache lives, so elements handed out before an
+     * invalidation stay valid as well.
+     */
+    class SymbolCache final {
+    public:
+        static constexpr usize initial_table_capacity = 256;
+
+    private:
+        /**
+         * The header of a cached address, the elements follow directly after the header.
+         */
+        struct Entry final {
+            Entry* previous;
+            const void* address;
+            usize element_count;
+
+            [[nodiscard]] auto get_elements() const noexcept -> const StackTraceElement* {
+                return reinterpret_cast<const StackTraceElement*>(this + 1);
+            }
+        };
+
+        using slot_type = Atomic<const Entry*>;
+
+        struct Table final {
+            Table* previous;
+            usize capacity;
+
+            [[nodiscard]] auto get_slots() noexcept -> slot_type* {
+                return reinterpret_cast<slot_type*>(this + 1);
+            }
+
+            [[nodiscard]] auto get_slots() const noexcept -> const slot_type* {
+                return reinterpret_cast<const slot_type*>(this + 1);
+            }
+        };
+
+        static_assert(alignof(StackTraceElement) <= alignof(Entry), "Elements must not be over-aligned");
+
+        Allocator<u8> _allocator;
+        std::mutex _mutex;
+        Atomic<Table*> _table;
+        usize _count;
+        Entry* _entry;// The most recently inserted entry
+        ConcurrentInterner _names;
+
+        [[nodiscard]] static auto get_hash(const void* address) noexcept -> u64 {
+            return hash_combine(hash::default_seed, reinterpret_cast<usize>(address));
+        }
+
+        [[nodiscard]] auto allocate_table(const usize capacity, Table* previous) noexcept -> Table* {
+            auto* table = reinterpret_cast<Table*>(_allocator.allocate(sizeof(Table) + capacity * sizeof(slot_type)));
+            table->previous = previous;
+            table->capacity = capacity;
+            auto* slots = table->get_slots();
+            for(usize i = 0; i < capacity; ++i) {
+                new(&slots[i]) slot_type(nullptr);
+            }
+            return table;
+        }
+
+        static auto insert_slot(Table* table, const Entry* entry) noexcept -> void {
+            auto* slots = table->get_slots();
+            const auto mask = table->capacity - 1;
+            auto index = static_cast<usize>(get_hash(entry->address)) & mask;
+            while(slots[index].load(std::memory_order_relaxed) != nullptr) {
+                index = (index + 1) & mask;
+            }
+            slots[index].store(entry, std::memory_order_release);
+        }
+
+        [[nodiscard]] static auto find_entry(const Table* table, const void* address) noexcept -> const Entry* {
+            const auto* slots = table->get_slots();
+            const auto mask = table->capacity - 1;
+            auto index = static_cast<usize>(get_hash(address)) & mask;
+            while(true) {
+                const auto* entry = slots[index].load(std::memory_order_acquire);
+                if(entry == nullptr || entry->address == address) {
+                    return entry;
+                }
+                index = (index + 1) & mask;
+            }
+        }
+
+    public:
+        SymbolCache() noexcept
+            : _allocator()
+            , _mutex()
+            , _table(nullptr)
+            , _count(0)
+            , _entry(nullptr)
+            , _names() {
+            _table.store(allocate_table(initial_table_capacity, nullptr), std::memory_order_release);
+        }
+
+        // Elements point into the cache, so it stays where it was created
+        KSTD_NO_MOVE_COPY(SymbolCache, SymbolCache)
+
+        ~SymbolCache() noexcept {
+            auto* table = _table.load(std::memory_order_relaxed);
+            while(table != nullptr) {
+                auto* previous = table->previous;
+                _allocator.free(reinterpret_cast<u8*>(table));
+                table = previous;
+            }
+            while(_entry != nullptr) {
+                auto* previous = _entry->previous;
+                _allocator.free(reinterpret_cast<u8*>(_entry));
+                _entry = previous;
+            }
+        }
+
+        /**
+         * Looks up the elements of an address without inserting them. Never blocks.
+         *
+         * @param address The return address to look up.
+         * @param result Receives the cached elements if the address was found.
+         * @return True if the address has been symbolized before.
+         */
+        [[nodiscard]] auto find(const void* address, Slice<StackTraceElement>& result) const noexcept -> bool {
+            const auto* entry = find_entry(_table.load(std::memory_order_acquire), address);
+            if(entry == nullptr) {
+                return false;
+            }
+            result = {entry->get_elements(), entry->element_count};
+            return true;
+        }
+
+        /**
+         * Copies the given elements into the cache, their names have to be owned by this cache.
+         * If another thread inserted the address in the meantime, its elements are kept.
+         *
+         * @param address The return address the elements were resolved for.
+         * @param elements The elements of the address, innermost first.
+         * @return The cached elements of the given address.
+         */
+        auto insert(const void* address, const Slice<StackTraceElement>& elements) noexcept -> Slice<StackTraceElement> {
+            const std::lock_guard guard(_mutex);
+            auto* table = _table.load(std::memory_order_relaxed);
+            if(const auto* entry = find_entry(table, address)) {
+                return {entry->get_elements(), entry->element_count};
+            }
+            // Keep the load factor below one half
+            if((_count << 1) >= table->capacity) {
+                auto* new_table = allocate_table(table->capacity << 1, table);
+                const auto* slots = table->get_slots();
+                for(usize i = 0; i < table->capacity; ++i) {
+                    if(const auto* entry = slots[i].load(std::memory_order_relaxed)) {
+                        insert_slot(new_table, entry);
+                    }
+                }
+                _table.store(new_table, std::memory_order_release);
+                table = new_table;
+            }
+
+            const auto size = elements.size();
+            auto* memory = _allocator.allocate(sizeof(Entry) + size * sizeof(StackTraceElement));
+            auto* entry = new(memory) Entry {_entry, address, size};
+            auto* cached_elements = reinterpret_cast<StackTraceElement*>(entry + 1);
+            for(usize i = 0; i < size; ++i) {
+                new(&cached_elements[i]) StackTraceElement(elements[i]);
+            }
+            _entry = entry;
+            insert_slot(table, entry);
+            ++_count;
+            return {cached_elements, size};
+        }
+
+        /**
+         * @return A view of the given name which stays valid as long as the cache.
+         */
+        [[nodiscard]] auto intern(const StringView& name) noexcept -> StringView {
+            return _names.intern(name).get_view();
+        }
+
+        /**
+         * Forgets all cached addresses, for example after a binary was unloaded and its addresses
+         * may be reused. Names and previously returned elements stay valid.
+         */
+        auto invalidate() noexcept -> void {
+            const std::lock_guard guard(_mutex);
+            auto* table = _table.load(std::memory_order_relaxed);
+            _table.store(allocate_table(initial_table_capacity, table), std::memory_order_release);
+            _count = 0;
+        }
+
+        /**
+         * @return The number of cached addresses.
+         */
+        [[nodiscard]] auto size() noexcept -> usize {
+            const std::lock_guard guard(_mutex);
+            return _count;
+        }
+    };
+
+    /**
+     * @return The process-wide cache used by StackTrace::symbolize.
+     */
+    [[nodiscard]] inline auto get_symbol_cache() noexcept -> SymbolCache& {
+        static SymbolCache cache {};
+        return cache;
+    }
+}// namespace kstd
\ No newline at end of file
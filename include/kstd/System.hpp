@@ -15,6 +15,8 @@
 
 // NOLINTBEGIN
 #include <malloc.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <wchar.h>
 // NOLINTEND
@@ -109,14 +111,29 @@ namespace kstd::system {
     }
 
     // Strings
+    /**
+     * Vectorized kernels for 16- and 32-bit strings, the implementation is selected
+     * by the features of the executing CPU on first use.
+     */
+    [[nodiscard]] auto get_wide_string_length(const u16* str) noexcept -> usize;
+    [[nodiscard]] auto get_wide_string_length(const u32* str) noexcept -> usize;
+    [[nodiscard]] auto compare_wide_string(const u16* lhs, const u16* rhs) noexcept -> i32;
+    [[nodiscard]] auto compare_wide_string(const u32* lhs, const u32* rhs) noexcept -> i32;
+
     template<concepts::Integer T>
     [[nodiscard]] usize get_string_length(const T* str) noexcept {
-        if constexpr(is_same<T, char>) {
-            return ::strlen(str);
+        if constexpr(sizeof(T) == 1) {
+            return ::strlen(reinterpret_cast<const char*>(str));
         }
         else if constexpr(is_same<T, wchar_t>) {
             return ::wcslen(str);
         }
+        else if constexpr(sizeof(T) == 2) {
+            return get_wide_string_length(reinterpret_cast<const u16*>(str));
+        }
+        else if constexpr(sizeof(T) == 4) {
+            return get_wide_string_length(reinterpret_cast<const u32*>(str));
+        }
         else {
             auto* ptr = str;
             while(*ptr != static_cast<T>('\0')) {
@@ -135,30 +152,36 @@ namespace kstd::system {
             ::wcscpy(dst, src);
         }
         else {
-            const auto dst_length = get_string_length(dst);
-            const auto src_length = get_string_length(src);
-            const auto length = min(dst_length, src_length);
-            ::memcpy(dst, src, (length + 1) * sizeof(T));
+            ::memcpy(dst, src, (get_string_length(src) + 1) * sizeof(T));
         }
     }
 
+    /**
+     * Compares two null-terminated strings unit by unit, like strcmp.
+     * Units are compared as unsigned values for every type except wchar_t.
+     *
+     * @return A negative value, zero or a positive value if lhs orders before, equal to or after rhs.
+     */
     template<concepts::Integer T>
     [[nodiscard]] i32 compare_string(const T* lhs, const T* rhs) noexcept {
-        if constexpr(is_same<T, char>) {
-            return ::strcmp(lhs, rhs);
+        if constexpr(sizeof(T) == 1) {
+            return ::strcmp(reinterpret_cast<const char*>(lhs), reinterpret_cast<const char*>(rhs));
         }
         else if constexpr(is_same<T, wchar_t>) {
             return ::wcscmp(lhs, rhs);
         }
+        else if constexpr(sizeof(T) == 2) {
+            return compare_wide_string(reinterpret_cast<const u16*>(lhs), reinterpret_cast<const u16*>(rhs));
+        }
+        else if constexpr(sizeof(T) == 4) {
+            return compare_wide_string(reinterpret_cast<const u32*>(lhs), reinterpret_cast<const u32*>(rhs));
+        }
         else {
-            const auto a_length = get_string_length(lhs);
-            const auto b_length = get_string_length(rhs);
-
-            if(a_length != b_length) {
-                return static_cast<i32>(b_length - a_length);// Narrowing conversion -.-
+            while(*lhs != static_cast<T>('\0') && *lhs == *rhs) {
+                ++lhs;
+                ++rhs;
             }
-
-            return ::memcmp(lhs, rhs, a_length);
+            return *lhs < *rhs ? -1 : (*lhs > *rhs ? 1 : 0);
         }
     }
 
@@ -171,7 +194,7 @@ namespace kstd::system {
             return ::wcscat(dst, src);
         }
         else {
-            ::memcpy(dst + get_string_length(dst), src, get_string_length(src) + 1);
+            copy_string(dst + get_string_length(dst), src);
             return dst;
         }
     }
@@ -0,0 +1,425 @@
+// Copyright 2024 Karma Krafts & associates
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include "Array.hpp"
+#include "Concepts.hpp"
+#include "Math.hpp"
+#include "Meta.hpp"
+#include "StringView.hpp"
+#include "Types.hpp"
+
+namespace kstd::unicode {
+    static constexpr char32_t max_code_point = 0x10FFFF;
+    static constexpr char32_t replacement_character = 0xFFFD;
+
+    template<typename T>
+    concept UTF8Unit = concepts::Integer<T> && sizeof(T) == 1;
+
+    template<typename T>
+    concept UTF16Unit = concepts::Integer<T> && sizeof(T) == 2;
+
+    template<typename T>
+    concept UTF32Unit = concepts::Integer<T> && sizeof(T) == 4;
+
+    template<typename T>
+    concept Unit = UTF8Unit<T> || UTF16Unit<T> || UTF32Unit<T>;
+
+    template<Unit T>
+    using UnsignedUnit = conditional<UTF8Unit<T>, u8, conditional<UTF16Unit<T>, u16, u32>>;
+
+    /**
+     * The outcome of transcoding between two encodings.
+     * Transcoding stops at the first invalid sequence or when the destination is full.
+     */
+    struct TranscodeResult final {
+        usize read;   // The number of source units consumed
+        usize written;// The number of destination units produced
+        bool is_valid;// False if transcoding stopped at an invalid sequence
+    };
+
+    [[nodiscard]] constexpr auto is_surrogate(const char32_t value) noexcept -> bool {
+        return value >= 0xD800 && value <= 0xDFFF;
+    }
+
+    [[nodiscard]] constexpr auto is_scalar_value(const char32_t value) noexcept -> bool {
+        return value <= max_code_point && !is_surrogate(value);
+    }
+
+    /**
+     * @return The number of UTF-8 bytes required to encode the given scalar value.
+     */
+    [[nodiscard]] constexpr auto get_utf8_length(const char32_t value) noexcept -> usize {
+        return value < 0x80 ? 1 : value < 0x800 ? 2 : value < 0x10000 ? 3 : 4;
+    }
+
+    /**
+     * Decodes a single scalar value, rejecting overlong encodings, surrogates and values above U+10FFFF.
+     *
+     * @param data The UTF-8 bytes to decode.
+     * @param size The number of available bytes.
+     * @param value Receives the decoded scalar value.
+     * @return The number of consumed bytes, or 0 if the input does not start with a valid sequence.
+     */
+    template<UTF8Unit T>
+    [[nodiscard]] constexpr auto decode_utf8(const T* data, const usize size, char32_t& value) noexcept -> usize {
+        if(size == 0) {
+            return 0;
+        }
+        const auto lead = static_cast<u8>(data[0]);
+        if(lead < 0x80) {
+            value = lead;
+            return 1;
+        }
+        usize length = 0;
+        char32_t min_value = 0;
+        if((lead & 0xE0) == 0xC0) {
+            length = 2;
+            min_value = 0x80;
+            value = lead & 0x1F;
+        }
+        else if((lead & 0xF0) == 0xE0) {
+            length = 3;
+            min_value = 0x800;
+            value = lead & 0x0F;
+        }
+        else if((lead & 0xF8) == 0xF0) {
+            length = 4;
+            min_value = 0x10000;
+            value = lead & 0x07;
+        }
+        else {
+            return 0;
+        }
+        if(size < length) {
+            return 0;
+        }
+        for(usize i = 1; i < length; ++i) {
+            const auto unit = static_cast<u8>(data[i]);
+            if((unit & 0xC0) != 0x80) {
+                return 0;
+            }
+            value = (value << 6) | (unit & 0x3F);
+        }
+        if(value < min_value || !is_scalar_value(value)) {
+            return 0;
+        }
+        return length;
+    }
+
+    /**
+     * @param value The scalar value to encode.
+     * @param data The destination, which must have room for at least 4 bytes.
+     * @return The number of written bytes.
+     */
+    template<UTF8Unit T>
+    constexpr auto encode_utf8(const char32_t value, T* data) noexcept -> usize {
+        if(value < 0x80) {
+            data[0] = static_cast<T>(value);
+            return 1;
+        }
+        if(value < 0x800) {
+            data[0] = static_cast<T>(0xC0 | (value >> 6));
+            data[1] = static_cast<T>(0x80 | (value & 0x3F));
+            return 2;
+        }
+        if(value < 0x10000) {
+            data[0] = static_cast<T>(0xE0 | (value >> 12));
+            data[1] = static_cast<T>(0x80 | ((value >> 6) & 0x3F));
+            data[2] = static_cast<T>(0x80 | (value & 0x3F));
+            return 3;
+        }
+        data[0] = static_cast<T>(0xF0 | (value >> 18));
+        data[1] = static_cast<T>(0x80 | ((value >> 12) & 0x3F));
+        data[2] = static_cast<T>(0x80 | ((value >> 6) & 0x3F));
+        data[3] = static_cast<T>(0x80 | (value & 0x3F));
+        return 4;
+    }
+
+    /**
+     * @param data The UTF-16 units to decode.
+     * @param size The number of available units.
+     * @param value Receives the decoded scalar value.
+     * @return The number of consumed units, or 0 if the input starts with an unpaired surrogate.
+     */
+    template<UTF16Unit T>
+    [[nodiscard]] constexpr auto decode_utf16(const T* data, const usize size, char32_t& value) noexcept -> usize {
+        if(size == 0) {
+            return 0;
+        }
+        const auto high = static_cast<char32_t>(static_cast<u16>(data[0]));
+        if(!is_surrogate(high)) {
+            value = high;
+            return 1;
+        }
+        if(high > 0xDBFF || size < 2) {
+            return 0;
+        }
+        const auto low = static_cast<char32_t>(static_cast<u16>(data[1]));
+        if(low < 0xDC00 || low > 0xDFFF) {
+            return 0;
+        }
+        value = 0x10000 + ((high - 0xD800) << 10) + (low - 0xDC00);
+        return 2;
+    }
+
+    /**
+     * @param value The scalar value to encode.
+     * @param data The destination, which must have room for at least 2 units.
+     * @return The number of written units.
+     */
+    template<UTF16Unit T>
+    constexpr auto encode_utf16(const char32_t value, T* data) noexcept -> usize {
+        if(value < 0x10000) {
+            data[0] = static_cast<T>(value);
+            return 1;
+        }
+        const auto offset = value - 0x10000;
+        data[0] = static_cast<T>(0xD800 + (offset >> 10));
+        data[1] = static_cast<T>(0xDC00 + (offset & 0x3FF));
+        return 2;
+    }
+
+    template<Unit T>
+    [[nodiscard]] constexpr auto decode(const T* data, const usize size, char32_t& value) noexcept -> usize {
+        if constexpr(UTF8Unit<T>) {
+            return decode_utf8(data, size, value);
+        }
+        else if constexpr(UTF16Unit<T>) {
+            return decode_utf16(data, size, value);
+        }
+        else {
+            if(size == 0) {
+                return 0;
+            }
+            value = static_cast<char32_t>(data[0]);
+            return is_scalar_value(value) ? 1 : 0;
+        }
+    }
+
+    /**
+     * @return The number of units of type T required to encode the given scalar value.
+     */
+    template<Unit T>
+    [[nodiscard]] constexpr auto get_encoded_length(const char32_t value) noexcept -> usize {
+        if constexpr(UTF8Unit<T>) {
+            return get_utf8_length(value);
+        }
+        else if constexpr(UTF16Unit<T>) {
+            return value < 0x10000 ? 1 : 2;
+        }
+        else {
+            return 1;
+        }
+    }
+
+    template<Unit T>
+    constexpr auto encode(const char32_t value, T* data) noexcept -> usize {
+        if constexpr(UTF8Unit<T>) {
+            return encode_utf8(value, data);
+        }
+        else if constexpr(UTF16Unit<T>) {
+            return encode_utf16(value, data);
+        }
+        else {
+            data[0] = static_cast<T>(value);
+            return 1;
+        }
+    }
+
+    /**
+     * Kernels for the hot loops, selected by the features of the executing CPU on first use.
+     */
+    namespace simd {
+        /**
+         * Validates a block at a time after Keiser and Lemire, "Validating UTF-8 In Less Than One Instruction Per Byte".
+         */
+        [[nodiscard]] auto is_valid_utf8(const u8* data, usize size) noexcept -> bool;
+
+        [[nodiscard]] auto count_utf8_code_points(const u8* data, usize size) noexcept -> usize;
+
+        /**
+         * Copies the ASCII prefix of the source into the destination, which must hold size units.
+         *
+         * @return The number of copied units.
+         */
+        auto widen_ascii(const u8* src, usize size, u16* dst) noexcept -> usize;
+
+        auto widen_ascii(const u8* src, usize size, u32* dst) noexcept -> usize;
+
+        auto narrow_ascii(const u16* src, usize size, u8* dst) noexcept -> usize;
+
+        auto narrow_ascii(const u32* src, usize size, u8* dst) noexcept -> usize;
+    }// namespace simd
+
+    /**
+     * @param data The bytes to validate.
+     * @param size The number of bytes.
+     * @return True if the given bytes are well-formed UTF-8.
+     */
+    template<UTF8Unit T>
+    [[nodiscard]] auto is_valid_utf8(const T* data, const usize size) noexcept -> bool {
+        return simd::is_valid_utf8(reinterpret_cast<const u8*>(data), size);
+    }
+
+    template<UTF8Unit T>
+    [[nodiscard]] auto is_valid_utf8(const BasicStringView<T>& value) noexcept -> bool {
+        return is_valid_utf8(value.data(), value.length());
+    }
+
+    template<UTF16Unit T>
+    [[nodiscard]] auto is_valid_utf16(const T* data, const usize size) noexcept -> bool {
+        usize index = 0;
+        while(index < size) {
+            char32_t value = 0;
+            const auto length = decode_utf16(data + index, size - index, value);
+            if(length == 0) {
+                return false;
+            }
+            index += length;
+        }
+        return true;
+    }
+
+    template<UTF16Unit T>
+    [[nodiscard]] auto is_valid_utf16(const BasicStringView<T>& value) noexcept -> bool {
+        return is_valid_utf16(value.data(), value.length());
+    }
+
+    /**
+     * Counts the code points of well-formed UTF-8 or UTF-16 by counting every unit
+     * which does not continue a sequence. Malformed input yields an unspecified count.
+     *
+     * @param data The units to count.
+     * @param size The number of units.
+     * @return The number of encoded code points.
+     */
+    template<Unit T>
+    [[nodiscard]] auto count_code_points(const T* data, const usize size) noexcept -> usize {
+        if constexpr(UTF8Unit<T>) {
+            return simd::count_utf8_code_points(reinterpret_cast<const u8*>(data), size);
+        }
+        else if constexpr(UTF16Unit<T>) {
+            usize count = 0;
+            for(usize index = 0; index < size; ++index) {
+                const auto unit = static_cast<u16>(data[index]);
+                count += (unit < 0xDC00 || unit > 0xDFFF) ? 1 : 0;
+            }
+            return count;
+        }
+        else {
+            return size;
+        }
+    }
+
+    template<Unit T>
+    [[nodiscard]] auto count_code_points(const BasicStringView<T>& value) noexcept -> usize {
+        return count_code_points(value.data(), value.length());
+    }
+
+    /**
+     * @return The number of TTo units needed to hold the transcoded valid prefix of the source.
+     */
+    template<Unit TTo, Unit TFrom>
+    [[nodiscard]] auto get_transcoded_length(const TFrom* data, const usize size) noexcept -> usize {
+        if constexpr(sizeof(TTo) == sizeof(TFrom)) {
+            return size;
+        }
+        usize result = 0;
+        usize index = 0;
+        while(index < size) {
+            if constexpr(UTF8Unit<TFrom>) {
+                if(static_cast<u8>(data[index]) < 0x80) {
+                    ++result;
+                    ++index;
+                    continue;
+                }
+            }
+            char32_t value = 0;
+            const auto length = decode(data + index, size - index, value);
+            if(length == 0) {
+                break;
+            }
+            result += get_encoded_length<TTo>(value);
+            index += length;
+        }
+        return result;
+    }
+
+    /**
+     * Transcodes between UTF-8, UTF-16 and UTF-32, choosing the encodings by the unit sizes.
+     * Runs of ASCII are widened from or narrowed to UTF-8 a whole vector at a time.
+     *
+     * @param src The source units.
+     * @param src_size The number of source units.
+     * @param dst The destination buffer.
+     * @param dst_capacity The number of units the destination can hold.
+     * @return How many units were consumed and produced, and whether the source was valid.
+     */
+    template<Unit TTo, Unit TFrom>
+    auto transcode(const TFrom* src, const usize src_size, TTo* dst, const usize dst_capacity) noexcept -> TranscodeResult {
+        usize read = 0;
+        usize written = 0;
+        while(read < src_size) {
+            if constexpr(UTF8Unit<TFrom> != UTF8Unit<TTo>) {
+                if(static_cast<UnsignedUnit<TFrom>>(src[read]) < 0x80) {
+                    const auto ascii_size = min(src_size - read, dst_capacity - written);
+                    usize count = 0;
+                    if constexpr(UTF8Unit<TFrom>) {
+                        count = simd::widen_ascii(reinterpret_cast<const u8*>(src + read), ascii_size,
+                                                  reinterpret_cast<UnsignedUnit<TTo>*>(dst + written));
+                    }
+                    else {
+                        count = simd::narrow_ascii(reinterpret_cast<const UnsignedUnit<TFrom>*>(src + read), ascii_size,
+                                                   reinterpret_cast<u8*>(dst + written));
+                    }
+                    read += count;
+                    written += count;
+                    if(read == src_size) {
+                        break;
+                    }
+                }
+            }
+            char32_t value = 0;
+            const auto length = decode(src + read, src_size - read, value);
+            if(length == 0) {
+                return {read, written, false};
+            }
+            if(written + get_encoded_length<TTo>(value) > dst_capacity) {
+                break;
+            }
+            written += encode(value, dst + written);
+            read += length;
+        }
+        return {read, written, true};
+    }
+
+    /**
+     * Transcodes the given view and appends the result to an array.
+     *
+     * @return True if the whole source was valid, otherwise only the valid prefix is appended.
+     */
+    template<Unit TTo, Unit TFrom, typename TAllocator>
+    auto transcode(const BasicStringView<TFrom>& src, Array<TTo, TAllocator>& dst) noexcept -> bool {
+        const auto old_size = dst.size();
+        const auto length = get_transcoded_length<TTo>(src.data(), src.length());
+        dst.resize(old_size + length);
+        const auto result = transcode(src.data(), src.length(), dst.data() + old_size, length);
+        if(old_size + result.written != dst.size()) {
+            dst.resize(old_size + result.written);
+        }
+        return result.is_valid && result.read == src.length();
+    }
+}// namespace kstd::unicode
\ No newline at end of file
@@ -30,4 +30,11 @@ namespace kstd {
     [[nodiscard]] constexpr T&& forward(remove_ref<T>&& value) noexcept {
         return static_cast<T&&>(value);
     }
+
+    /**
+     * @return True if the call happens during constant evaluation, so runtime-only fast paths can be skipped.
+     */
+    [[nodiscard]] constexpr auto is_constant_evaluated() noexcept -> bool {
+        return __builtin_is_constant_evaluated();
+    }
 }// namespace kstd
\ No newline at end of file
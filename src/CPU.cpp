@@ -0,0 +1,96 @@
+// Copyright 2024 Karma Krafts & associates
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "kstd/CPU.hpp"
+
+// NOLINTBEGIN
+#if defined(KSTD_CPU_X86_FAMILY)
+#ifdef KSTD_COMPILER_MSVC
+#include <immintrin.h>
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+// NOLINTEND
+
+namespace kstd::cpu {
+#if defined(KSTD_CPU_X86_FAMILY)
+    namespace {
+        struct Registers final {
+            u32 eax;
+            u32 ebx;
+            u32 ecx;
+            u32 edx;
+        };
+
+        auto query(const u32 leaf, const u32 sub_leaf) noexcept -> Registers {
+            Registers result {};
+#ifdef KSTD_COMPILER_MSVC
+            int values[4] {};
+            __cpuidex(values, static_cast<int>(leaf), static_cast<int>(sub_leaf));
+            result = {static_cast<u32>(values[0]), static_cast<u32>(values[1]), static_cast<u32>(values[2]),
+                      static_cast<u32>(values[3])};
+#else
+            __cpuid_count(leaf, sub_leaf, result.eax, result.ebx, result.ecx, result.edx);
+#endif
+            return result;
+        }
+
+        auto get_enabled_state() noexcept -> u64 {
+#ifdef KSTD_COMPILER_MSVC
+            return _xgetbv(0);
+#else
+            u32 low = 0;
+            u32 high = 0;
+            __asm__ volatile("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+            return (static_cast<u64>(high) << 32) | low;
+#endif
+        }
+
+        auto detect() noexcept -> Features {
+            Features features {};
+            const auto max_leaf = query(0, 0).eax;
+            if(max_leaf < 1) {
+                return features;
+            }
+            const auto basic = query(1, 0);
+            features.has_sse2 = (basic.edx & (1U << 26)) != 0;
+            features.has_ssse3 = (basic.ecx & (1U << 9)) != 0;
+            features.has_sse41 = (basic.ecx & (1U << 19)) != 0;
+            features.has_sse42 = (basic.ecx & (1U << 20)) != 0;
+            features.has_popcnt = (basic.ecx & (1U << 23)) != 0;
+            const auto has_os_xsave = (basic.ecx & (1U << 27)) != 0;
+            // The YMM state (bits 1 and 2) must be enabled by the OS before AVX can be used
+            const auto has_ymm_state = has_os_xsave && (get_enabled_state() & 0x6) == 0x6;
+            if(max_leaf >= 7) {
+                const auto extended = query(7, 0);
+                features.has_avx2 = has_ymm_state && (extended.ebx & (1U << 5)) != 0;
+                features.has_bmi2 = (extended.ebx & (1U << 8)) != 0;
+            }
+            return features;
+        }
+    }// namespace
+
+    auto get_features() noexcept -> const Features& {
+        static const Features features = detect();
+        return features;
+    }
+#else
+    auto get_features() noexcept -> const Features& {
+        static const Features features {};
+        return features;
+    }
+#endif
+}// namespace kstd::cpu
\ No newline at end of file
@@ -0,0 +1,333 @@
+// Copyright 2024 Karma Krafts & associates
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifdef KSTD_PLATFORM_UNIX
+
+#include "kstd/Crash.hpp"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <libunwind.h>
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#ifdef KSTD_PLATFORM_LINUX
+#include <sys/syscall.h>
+#endif
+
+#include "kstd/Atomic.hpp"
+#include "kstd/Defaults.hpp"
+#include "kstd/FixedArray.hpp"
+#include "kstd/Number.hpp"
+#include "kstd/StackTrace.hpp"
+
+namespace kstd::crash {
+    namespace {
+        constexpr usize signal_count = 5;
+        constexpr i32 handled_signals[signal_count] = {SIGSEGV, SIGBUS, SIGILL, SIGFPE, SIGABRT};// NOLINT
+        constexpr usize alternate_stack_size = 64 * 1024;
+        constexpr usize write_buffer_size = 1024;
+        constexpr usize max_line_length = 512;
+
+        Atomic<i32> report_fd {-1};
+        Atomic<bool> is_installed {false};
+        Atomic<usize> reporting_thread {0};
+        struct sigaction previous_actions[signal_count];// NOLINT
+        thread_local void* alternate_stack = nullptr;
+
+        /**
+         * Buffers report text on the stack and writes it with plain write calls,
+         * which is all a signal handler is allowed to do.
+         */
+        class ReportWriter final {
+            i32 _fd;
+            usize _size;
+            FixedArray<char, write_buffer_size> _buffer;
+
+        public:
+            explicit ReportWriter(const i32 fd) noexcept
+                : _fd(fd)
+                , _size(0) {
+            }
+
+            KSTD_NO_MOVE_COPY(ReportWriter, ReportWriter)
+
+            ~ReportWriter() noexcept {
+                flush();
+            }
+
+            auto flush() noexcept -> void {
+                usize offset = 0;
+                while(offset < _size) {
+                    const auto result = ::write(_fd, _buffer.data() + offset, _size - offset);
+                    if(result < 0) {
+                        if(errno == EINTR) {
+                            continue;
+                        }
+                        break;// Nothing left to do if the report can't be written
+                    }
+                    offset += static_cast<usize>(result);
+                }
+                _size = 0;
+            }
+
+            auto write(const char* data, const usize size) noexcept -> ReportWriter& {
+                for(usize i = 0; i < size; ++i) {
+                    if(_size == write_buffer_size) {
+                        flush();
+                    }
+                    _buffer[_size++] = data[i];
+                }
+                return *this;
+            }
+
+            auto write(const char* text) noexcept -> ReportWriter& {
+                usize size = 0;
+                while(text[size] != '\0') {
+                    ++size;
+                }
+                return write(text, size);
+            }
+
+            auto write_decimal(const u64 value) noexcept -> ReportWriter& {
+                char digits[number::max_chars<u64>];// NOLINT
+                return write(digits, to_chars(digits, value));
+            }
+
+            auto write_hex(const usize value) noexcept -> ReportWriter& {
+                char digits[2 + sizeof(usize) * 2];// NOLINT
+                usize size = sizeof(digits);
+                auto remaining = value;
+                do {
+                    digits[--size] = "0123456789abcdef"[remaining & 0xF];
+                    remaining >>= 4;
+                } while(remaining != 0);
+                digits[--size] = 'x';
+                digits[--size] = '0';
+                return write(digits + size, sizeof(digits) - size);
+            }
+        };
+
+        [[nodiscard]] auto get_thread_id() noexcept -> usize {
+#ifdef KSTD_PLATFORM_LINUX
+            return static_cast<usize>(syscall(SYS_gettid));
+#else
+            return reinterpret_cast<usize>(pthread_self());
+#endif
+        }
+
+        [[nodiscard]] auto get_signal_name(const i32 signal) noexcept -> const char* {
+            switch(signal) {
+                case SIGSEGV: return "SIGSEGV";
+                case SIGBUS: return "SIGBUS";
+                case SIGILL: return "SIGILL";
+                case SIGFPE: return "SIGFPE";
+                case SIGABRT: return "SIGABRT";
+                default: return "Unknown signal";
+            }
+        }
+
+        /**
+         * Walks the stack of the calling thread, libunwind steps through signal frames as well.
+         */
+        [[nodiscard]] auto capture_frames(void** frames) noexcept -> usize {
+            unw_context_t context;
+            unw_cursor_t cursor;
+            if(unw_getcontext(&context) != UNW_ESUCCESS || unw_init_local(&cursor, &context) != UNW_ESUCCESS) {
+                return 0;
+            }
+            usize count = 0;
+            while(count < max_frames && unw_step(&cursor) > 0) {
+                unw_word_t address;
+                if(unw_get_reg(&cursor, UNW_REG_IP, &address) != UNW_ESUCCESS) {
+                    break;
+                }
+                frames[count++] = reinterpret_cast<void*>(address);
+            }
+            return count;
+        }
+
+        /**
+         * Copies the executable mappings of the process, which lets offline tools
+         * turn the raw addresses into binaries and offsets.
+         */
+        auto write_modules(ReportWriter& writer) noexcept -> void {
+#ifdef KSTD_PLATFORM_LINUX
+            const auto fd = ::open("/proc/self/maps", O_RDONLY | O_CLOEXEC);
+            if(fd < 0) {
+                return;
+            }
+            writer.write("modules:\n");
+            FixedArray<char, write_buffer_size> buffer {};
+            FixedArray<char, max_line_length> line {};
+            usize line_length = 0;
+            while(true) {
+                const auto result = ::read(fd, buffer.data(), write_buffer_size);
+                if(result < 0 && errno == EINTR) {
+                    continue;
+                }
+                if(result <= 0) {
+                    break;
+                }
+                for(usize i = 0; i < static_cast<usize>(result); ++i) {
+                    if(buffer[i] != '\n') {
+                        if(line_length < max_line_length) {
+                            line[line_length++] = buffer[i];
+                        }
+                        continue;
+                    }
+                    // Lines look like "start-end perms offset device inode path", keep executable ones
+                    usize perms = 0;
+                    while(perms < line_length && line[perms] != ' ') {
+                        ++perms;
+                    }
+                    if(perms + 3 < line_length && line[perms + 3] == 'x') {
+                        writer.write(line.data(), line_length).write("\n");
+                    }
+                    line_length = 0;
+                }
+            }
+            ::close(fd);
+#else
+            static_cast<void>(writer);
+#endif
+        }
+
+        auto handle_signal(const i32 signal, siginfo_t* info, void* context) noexcept -> void {
+            static_cast<void>(context);
+            const auto saved_errno = errno;
+
+            FixedArray<char, 64> reason {};
+            usize length = 0;
+            for(const auto* name = get_signal_name(signal); *name != '\0'; ++name) {
+                reason[length++] = *name;
+            }
+            if(signal == SIGSEGV || signal == SIGBUS) {
+                constexpr char prefix[] = " at 0x";// NOLINT
+                for(usize i = 0; i < sizeof(prefix) - 1; ++i) {
+                    reason[length++] = prefix[i];
+                }
+                const auto address = reinterpret_cast<usize>(info->si_addr);
+                for(auto shift = static_cast<i32>(sizeof(usize) * 8) - 4; shift >= 0; shift -= 4) {
+                    reason[length++] = "0123456789abcdef"[(address >> shift) & 0xF];
+                }
+            }
+            reason[length] = '\0';
+            write_report(reason.data());
+
+            // Let the previous disposition terminate the process, which usually also dumps core
+            for(usize i = 0; i < signal_count; ++i) {
+                if(handled_signals[i] == signal) {
+                    sigaction(signal, &previous_actions[i], nullptr);
+                }
+            }
+            if(info->si_code <= 0) {
+                raise(signal);// Sent by kill or raise, returning would not deliver it again
+            }
+            errno = saved_errno;
+        }
+    }// namespace
+
+    auto install(const i32 fd) noexcept -> bool {
+        report_fd.store(fd, std::memory_order_release);
+        if(!install_thread()) {
+            return false;
+        }
+        if(is_installed.exchange(true, std::memory_order_acq_rel)) {
+            return true;
+        }
+        struct sigaction action {};
+        action.sa_sigaction = &handle_signal;
+        action.sa_flags = SA_SIGINFO | SA_ONSTACK;
+        sigemptyset(&action.sa_mask);
+        auto result = true;
+        for(usize i = 0; i < signal_count; ++i) {
+            result &= sigaction(handled_signals[i], &action, &previous_actions[i]) == 0;
+        }
+        return result;
+    }
+
+    auto install(const char* path) noexcept -> bool {
+        const auto fd = ::open(path, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+        if(fd < 0) {
+            return false;
+        }
+        return install(fd);
+    }
+
+    auto install_thread() noexcept -> bool {
+        if(alternate_stack != nullptr) {
+            return true;
+        }
+        StackTrace::prepare_thread();
+        auto* memory = mmap(nullptr, alternate_stack_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if(memory == MAP_FAILED) {
+            return false;
+        }
+        stack_t stack {};
+        stack.ss_sp = memory;
+        stack.ss_size = alternate_stack_size;
+        stack.ss_flags = 0;
+        if(sigaltstack(&stack, nullptr) != 0) {
+            munmap(memory, alternate_stack_size);
+            return false;
+        }
+        alternate_stack = memory;
+        return true;
+    }
+
+    auto uninstall() noexcept -> void {
+        if(!is_installed.exchange(false, std::memory_order_acq_rel)) {
+            return;
+        }
+        for(usize i = 0; i < signal_count; ++i) {
+            sigaction(handled_signals[i], &previous_actions[i], nullptr);
+        }
+        report_fd.store(-1, std::memory_order_release);
+    }
+
+    auto write_report(const char* reason) noexcept -> void {
+        // Only one thread reports at a time, a crash while reporting drops the nested report
+        const auto thread_id = get_thread_id();
+        auto expected = static_cast<usize>(0);
+        while(!reporting_thread.compare_exchange_weak(expected, thread_id, std::memory_order_acquire)) {
+            if(expected == thread_id) {
+                return;
+            }
+            expected = 0;
+            sched_yield();
+        }
+
+        void* frames[max_frames];// NOLINT
+        const auto frame_count = capture_frames(frames);
+        const auto fd = report_fd.load(std::memory_order_acquire);
+        {
+            ReportWriter writer(fd < 0 ? STDERR_FILENO : fd);
+            writer.write("*** kstd crash report ***\nreason: ").write(reason).write("\nprocess: ").write_decimal(static_cast<u64>(getpid()));
+            writer.write("\nthread: ").write_decimal(thread_id).write("\nframes:\n");
+            for(usize i = 0; i < frame_count; ++i) {
+                writer.write("#").write_decimal(i).write(" ").write_hex(reinterpret_cast<usize>(frames[i])).write("\n");
+            }
+            write_modules(writer);
+            writer.write("*** end of crash report ***\n");
+        }
+
+        reporting_thread.store(0, std::memory_order_release);
+    }
+}// namespace kstd::crash
+
+#endif//KSTD_PLATFORM_UNIX
\ No newline at end of file
@@ -0,0 +1,144 @@
+// Copyright 2024 Karma Krafts & associates
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifdef KSTD_PLATFORM_WINDOWS
+
+#include "kstd/Crash.hpp"
+
+#include <Windows.h>
+#include <fcntl.h>
+#include <io.h>
+
+#include "kstd/Atomic.hpp"
+#include "kstd/Number.hpp"
+
+namespace kstd::crash {
+    namespace {
+        constexpr ULONG stack_guarantee = 64 * 1024;
+
+        Atomic<i32> report_fd {-1};
+        Atomic<bool> is_installed {false};
+        Atomic<DWORD> reporting_thread {0};
+        LPTOP_LEVEL_EXCEPTION_FILTER previous_filter = nullptr;
+
+        auto write_text(const i32 fd, const char* data, const usize size) noexcept -> void {
+            static_cast<void>(_write(fd, data, static_cast<unsigned int>(size)));
+        }
+
+        auto write_text(const i32 fd, const char* text) noexcept -> void {
+            write_text(fd, text, strlen(text));
+        }
+
+        auto write_number(const i32 fd, const u64 value) noexcept -> void {
+            char digits[number::max_chars<u64>];// NOLINT
+            write_text(fd, digits, to_chars(digits, value));
+        }
+
+        auto write_hex(const i32 fd, const usize value) noexcept -> void {
+            char digits[2 + sizeof(usize) * 2];// NOLINT
+            usize size = sizeof(digits);
+            auto remaining = value;
+            do {
+                digits[--size] = "0123456789abcdef"[remaining & 0xF];
+                remaining >>= 4;
+            } while(remaining != 0);
+            digits[--size] = 'x';
+            digits[--size] = '0';
+            write_text(fd, digits + size, sizeof(digits) - size);
+        }
+
+        auto WINAPI handle_exception(EXCEPTION_POINTERS* pointers) -> LONG {
+            char reason[32] = "Exception 0x";// NOLINT
+            const auto code = static_cast<u32>(pointers->ExceptionRecord->ExceptionCode);
+            for(usize i = 0; i < 8; ++i) {
+                reason[12 + i] = "0123456789abcdef"[(code >> ((7 - i) * 4)) & 0xF];
+            }
+            reason[20] = '\0';
+            write_report(reason);
+            return previous_filter != nullptr ? previous_filter(pointers) : EXCEPTION_CONTINUE_SEARCH;
+        }
+    }// namespace
+
+    auto install(const i32 fd) noexcept -> bool {
+        report_fd.store(fd, std::memory_order_release);
+        if(!install_thread()) {
+            return false;
+        }
+        if(!is_installed.exchange(true, std::memory_order_acq_rel)) {
+            previous_filter = SetUnhandledExceptionFilter(&handle_exception);
+        }
+        return true;
+    }
+
+    auto install(const char* path) noexcept -> bool {
+        const auto fd = _open(path, _O_WRONLY | _O_CREAT | _O_APPEND | _O_BINARY, _S_IREAD | _S_IWRITE);
+        if(fd < 0) {
+            return false;
+        }
+        return install(fd);
+    }
+
+    auto install_thread() noexcept -> bool {
+        // Keeps enough stack around to report a stack overflow
+        auto size = stack_guarantee;
+        return SetThreadStackGuarantee(&size) != 0;
+    }
+
+    auto uninstall() noexcept -> void {
+        if(!is_installed.exchange(false, std::memory_order_acq_rel)) {
+            return;
+        }
+        SetUnhandledExceptionFilter(previous_filter);
+        report_fd.store(-1, std::memory_order_release);
+    }
+
+    auto write_report(const char* reason) noexcept -> void {
+        // Only one thread reports at a time, a crash while reporting drops the nested report
+        const auto thread_id = GetCurrentThreadId();
+        auto expected = static_cast<DWORD>(0);
+        while(!reporting_thread.compare_exchange_weak(expected, thread_id, std::memory_order_acquire)) {
+            if(expected == thread_id) {
+                return;
+            }
+            expected = 0;
+            SwitchToThread();
+        }
+
+        void* frames[max_frames];// NOLINT
+        const auto frame_count = CaptureStackBackTrace(0, static_cast<DWORD>(max_frames), frames, nullptr);
+        auto fd = report_fd.load(std::memory_order_acquire);
+        if(fd < 0) {
+            fd = 2;
+        }
+        write_text(fd, "*** kstd crash report ***\nreason: ");
+        write_text(fd, reason);
+        write_text(fd, "\nprocess: ");
+        write_number(fd, GetCurrentProcessId());
+        write_text(fd, "\nthread: ");
+        write_number(fd, thread_id);
+        write_text(fd, "\nframes:\n");
+        for(usize i = 0; i < frame_count; ++i) {
+            write_text(fd, "#");
+            write_number(fd, i);
+            write_text(fd, " ");
+            write_hex(fd, reinterpret_cast<usize>(frames[i]));
+            write_text(fd, "\n");
+        }
+        write_text(fd, "*** end of crash report ***\n");
+
+        reporting_thread.store(0, std::memory_order_release);
+    }
+}// namespace kstd::crash
+
+#endif//KSTD_PLATFORM_WINDOWS
\ No newline at end of file
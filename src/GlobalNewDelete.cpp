@@ -11,8 +11,112 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+
 #ifdef KSTD_GLOBAL_MIMALLOC
 
-#include <mimalloc-new-delete.h>
+#include <mimalloc.h>
+#include <new>
+
+#include "kstd/HeapProfiler.hpp"
+
+// Equivalent to mimalloc-new-delete.h, with the heap profiler hooks added
+namespace {
+    inline auto on_allocate(void* memory, const std::size_t size) noexcept -> void* {
+        kstd::profiler::heap::on_allocate(memory, size);
+        return memory;
+    }
+}// namespace
+
+void operator delete(void* memory) noexcept {
+    kstd::profiler::heap::on_free(memory);
+    mi_free(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+    kstd::profiler::heap::on_free(memory);
+    mi_free(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept {
+    kstd::profiler::heap::on_free(memory);
+    mi_free(memory);
+}
+
+void operator delete[](void* memory, const std::nothrow_t&) noexcept {
+    kstd::profiler::heap::on_free(memory);
+    mi_free(memory);
+}
+
+void operator delete(void* memory, const std::size_t size) noexcept {
+    kstd::profiler::heap::on_free(memory);
+    mi_free_size(memory, size);
+}
+
+void operator delete[](void* memory, const std::size_t size) noexcept {
+    kstd::profiler::heap::on_free(memory);
+    mi_free_size(memory, size);
+}
+
+void operator delete(void* memory, const std::align_val_t alignment) noexcept {
+    kstd::profiler::heap::on_free(memory);
+    mi_free_aligned(memory, static_cast<std::size_t>(alignment));
+}
+
+void operator delete[](void* memory, const std::align_val_t alignment) noexcept {
+    kstd::profiler::heap::on_free(memory);
+    mi_free_aligned(memory, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* memory, const std::size_t size, const std::align_val_t alignment) noexcept {
+    kstd::profiler::heap::on_free(memory);
+    mi_free_size_aligned(memory, size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete[](void* memory, const std::size_t size, const std::align_val_t alignment) noexcept {
+    kstd::profiler::heap::on_free(memory);
+    mi_free_size_aligned(memory, size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* memory, const std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    kstd::profiler::heap::on_free(memory);
+    mi_free_aligned(memory, static_cast<std::size_t>(alignment));
+}
+
+void operator delete[](void* memory, const std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    kstd::profiler::heap::on_free(memory);
+    mi_free_aligned(memory, static_cast<std::size_t>(alignment));
+}
+
+void* operator new(const std::size_t size) noexcept(false) {
+    return on_allocate(mi_new(size), size);
+}
+
+void* operator new[](const std::size_t size) noexcept(false) {
+    return on_allocate(mi_new(size), size);
+}
+
+void* operator new(const std::size_t size, const std::nothrow_t&) noexcept {
+    return on_allocate(mi_new_nothrow(size), size);
+}
+
+void* operator new[](const std::size_t size, const std::nothrow_t&) noexcept {
+    return on_allocate(mi_new_nothrow(size), size);
+}
+
+void* operator new(const std::size_t size, const std::align_val_t alignment) noexcept(false) {
+    return on_allocate(mi_new_aligned(size, static_cast<std::size_t>(alignment)), size);
+}
+
+void* operator new[](const std::size_t size, const std::align_val_t alignment) noexcept(false) {
+    return on_allocate(mi_new_aligned(size, static_cast<std::size_t>(alignment)), size);
+}
+
+void* operator new(const std::size_t size, const std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return on_allocate(mi_new_aligned_nothrow(size, static_cast<std::size_t>(alignment)), size);
+}
+
+void* operator new[](const std::size_t size, const std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return on_allocate(mi_new_aligned_nothrow(size, static_cast<std::size_t>(alignment)), size);
+}
 
 #endif//KSTD_GLOBAL_MIMALLOC
\ No newline at end of file
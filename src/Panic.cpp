@@ -18,11 +18,11 @@
 #include <stdlib.h>
 // NOLINTEND
 
-#include "kstd/StackTrace.hpp"
+#include "kstd/Crash.hpp"
 
 namespace kstd {
     auto panic(const char* message) noexcept -> void {
-        const auto trace = StackTrace::get_current(100, 2);
+        crash::write_report(message);
         exit(1);
     }
 }// namespace kstd
\ No newline at end of file
@@ -0,0 +1,1111 @@
+// Copyright 2024 Karma Krafts & associates
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+#ifdef KSTD_PLATFORM_UNIX
+
+#include "kstd/Profiler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <errno.h>
+#include <fcntl.h>
+#include <mutex>
+#include <pthread.h>
+#include <signal.h>
+#include <sys/time.h>
+#include <thread>
+#include <time.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+#ifdef KSTD_PLATFORM_LINUX
+#include <sys/syscall.h>
+#ifndef sigev_notify_thread_id
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+#endif
+
+#include "kstd/Array.hpp"
+#include "kstd/Atomic.hpp"
+#include "kstd/Bytes.hpp"
+#include "kstd/Defaults.hpp"
+#include "kstd/FixedArray.hpp"
+#include "kstd/Hash.hpp"
+#include "kstd/HeapProfiler.hpp"
+#include "kstd/Interner.hpp"
+#include "kstd/Math.hpp"
+#include "kstd/Number.hpp"
+#include "kstd/StackTrace.hpp"
+#include "kstd/StringView.hpp"
+
+namespace kstd::profiler {
+    namespace {
+        // The signal handler and the signal trampoline are captured before the interrupted frame
+        constexpr usize handler_depth = 4;
+        constexpr usize capture_depth = max_depth + handler_depth;
+        constexpr usize initial_slot_count = 64;
+        constexpr u32 no_index = static_cast<u32>(-1);
+        constexpr u64 nanoseconds_per_second = 1000000000;
+        constexpr auto drain_interval = std::chrono::milliseconds(10);
+
+        static_assert(capture_depth <= StackTrace::max_depth);
+
+        template<usize TValueCount>
+        struct StackEntry final {
+            u64 hash;
+            u32 first_frame;
+            u32 depth;
+            FixedArray<u64, TValueCount> values;
+        };
+
+        /**
+         * Sums values per unique stack. The frames of all stacks are stored back to back
+         * and looked up through an open addressing table keyed by their hash.
+         */
+        template<usize TValueCount>
+        class StackTable final {
+            using entry_type = StackEntry<TValueCount>;
+
+            Array<void*> _frames;
+            Array<entry_type> _entries;
+            Array<u32> _slots;
+            usize _sample_count;
+
+            auto rehash(const usize slot_count) noexcept -> void {
+                _slots.clear();
+                _slots.resize(slot_count);
+                for(usize i = 0; i < slot_count; ++i) {
+                    _slots[i] = no_index;
+                }
+                const auto mask = slot_count - 1;
+                for(usize i = 0; i < _entries.size(); ++i) {
+                    auto slot = static_cast<usize>(_entries[i].hash) & mask;
+                    while(_slots[slot] != no_index) {
+                        slot = (slot + 1) & mask;
+                    }
+                    _slots[slot] = static_cast<u32>(i);
+                }
+            }
+
+            [[nodiscard]] auto is_same_stack(const entry_type& entry, void* const* frames, const usize depth) const noexcept -> bool {
+                if(entry.depth != depth) {
+                    return false;
+                }
+                for(usize i = 0; i < depth; ++i) {
+                    if(_frames[entry.first_frame + i] != frames[i]) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+        public:
+            StackTable() noexcept
+                : _frames()
+                , _entries()
+                , _slots()
+                , _sample_count(0) {
+                rehash(initial_slot_count);
+            }
+
+            KSTD_DEFAULT_MOVE_COPY(StackTable, StackTable)
+            ~StackTable() noexcept = default;
+
+            /**
+             * @return The index of the entry of the given stack, which stays the same until the table is cleared.
+             */
+            auto add(void* const* frames, const usize depth, const u64* values) noexcept -> u32 {
+                ++_sample_count;
+                const auto hash = hash_elements(reinterpret_cast<const usize*>(frames), depth);
+                const auto mask = _slots.size() - 1;
+                auto slot = static_cast<usize>(hash) & mask;
+                while(_slots[slot] != no_index) {
+                    const auto index = _slots[slot];
+                    auto& entry = _entries[index];
+                    if(entry.hash == hash && is_same_stack(entry, frames, depth)) {
+                        for(usize i = 0; i < TValueCount; ++i) {
+                            entry.values[i] += values[i];
+                        }
+                        return index;
+                    }
+                    slot = (slot + 1) & mask;
+                }
+
+                const auto first_frame = _frames.size();
+                _frames.reserve_amortized(first_frame + depth);
+                for(usize i = 0; i < depth; ++i) {
+                    _frames.push_back(frames[i]);
+                }
+                const auto index = static_cast<u32>(_entries.size());
+                _slots[slot] = index;
+                entry_type entry {hash, static_cast<u32>(first_frame), static_cast<u32>(depth), {}};
+                for(usize i = 0; i < TValueCount; ++i) {
+                    entry.values[i] = values[i];
+                }
+                _entries.reserve_amortized(_entries.size() + 1);
+                _entries.push_back(entry);
+                // Keep the load factor at or below one half
+                if(_entries.size() * 2 > _slots.size()) {
+                    rehash(_slots.size() * 2);
+                }
+                return index;
+            }
+
+            auto clear() noexcept -> void {
+                _frames.clear();
+                _entries.clear();
+                _sample_count = 0;
+                rehash(initial_slot_count);
+            }
+
+            [[nodiscard]] auto get_entries() const noexcept -> const Array<entry_type>& {
+                return _entries;
+            }
+
+            [[nodiscard]] auto get_frames(const entry_type& entry) const noexcept -> Slice<void*> {
+                return {_frames.data() + entry.first_frame, entry.depth};
+            }
+
+            [[nodiscard]] auto get_frames(const u32 index) const noexcept -> Slice<void*> {
+                return get_frames(_entries[index]);
+            }
+
+            [[nodiscard]] auto get_all_frames() const noexcept -> const Array<void*>& {
+                return _frames;
+            }
+
+            [[nodiscard]] auto get_sample_count() const noexcept -> usize {
+                return _sample_count;
+            }
+        };
+
+        /**
+         * The symbolized locations of the given addresses, stored in
+         * address order. Each location has one line per inlined function, innermost first.
+         */
+        class SymbolTable final {
+        public:
+            struct Line final {
+                u32 name;
+                u32 file;
+                u32 line;
+            };
+
+            struct Location final {
+                u32 first_line;
+                u32 line_count;
+            };
+
+        private:
+            Interner _strings;
+            Array<void*> _addresses;
+            Array<Location> _locations;
+            Array<Line> _lines;
+
+        public:
+            explicit SymbolTable(const Array<void*>& frames) noexcept
+                : _strings()
+                , _addresses(frames)
+                , _locations()
+                , _lines() {
+                std::sort(_addresses.begin(), _addresses.end());
+                _addresses.resize(static_cast<usize>(std::unique(_addresses.begin(), _addresses.end()) - _addresses.begin()));
+                _locations.reserve(_addresses.size());
+                for(auto* address : _addresses) {
+                    const auto trace = StackTrace::from_addresses(&address, 1);
+                    const auto first_line = _lines.size();
+                    for(const auto& element : trace.get_elements(0)) {
+                        if(element.get_function_name().is_empty()) {
+                            continue;
+                        }
+                        _lines.reserve_amortized(_lines.size() + 1);
+                        _lines.push_back({_strings.intern(element.get_function_name()).get_id(),
+                                          _strings.intern(element.get_file_name()).get_id(),
+                                          static_cast<u32>(element.get_line())});
+                    }
+                    _locations.push_back({static_cast<u32>(first_line), static_cast<u32>(_lines.size() - first_line)});
+                }
+            }
+
+            KSTD_NO_MOVE_COPY(SymbolTable, SymbolTable)
+            ~SymbolTable() noexcept = default;
+
+            [[nodiscard]] auto find(void* address) const noexcept -> usize {
+                return static_cast<usize>(std::lower_bound(_addresses.begin(), _addresses.end(), address) - _addresses.begin());
+            }
+
+            [[nodiscard]] auto get_addresses() const noexcept -> const Array<void*>& {
+                return _addresses;
+            }
+
+            [[nodiscard]] auto get_lines(const usize location) const noexcept -> Slice<Line> {
+                const auto& entry = _locations[location];
+                return {_lines.data() + entry.first_line, entry.line_count};
+            }
+
+            [[nodiscard]] auto get_strings() noexcept -> Interner& {
+                return _strings;
+            }
+        };
+
+        /**
+         * Encodes protobuf messages field by field, nested messages are encoded
+         * separately and copied in, since their size has to precede them.
+         */
+        class ProtoWriter final {
+            BytesMut _buffer;
+
+            static constexpr u32 varint_type = 0;
+            static constexpr u32 length_type = 2;
+
+            auto write_varint(u64 value) noexcept -> void {
+                while(value >= 0x80) {
+                    _buffer.push_back(static_cast<u8>(value | 0x80));
+                    value >>= 7;
+                }
+                _buffer.push_back(static_cast<u8>(value));
+            }
+
+            auto write_length(const u32 field, const u8* data, const usize size) noexcept -> void {
+                write_varint((field << 3) | length_type);
+                write_varint(size);
+                _buffer.append(data, size);
+            }
+
+        public:
+            ProtoWriter() noexcept = default;
+            KSTD_NO_MOVE_COPY(ProtoWriter, ProtoWriter)
+            ~ProtoWriter() noexcept = default;
+
+            auto write_uint(const u32 field, const u64 value) noexcept -> ProtoWriter& {
+                write_varint((field << 3) | varint_type);
+                write_varint(value);
+                return *this;
+            }
+
+            auto write_string(const u32 field, const StringView& value) noexcept -> ProtoWriter& {
+                write_length(field, reinterpret_cast<const u8*>(value.data()), value.length());
+                return *this;
+            }
+
+            auto write_message(const u32 field, const ProtoWriter& message) noexcept -> ProtoWriter& {
+                write_length(field, message.data(), message.size());
+                return *this;
+            }
+
+            auto clear() noexcept -> void {
+                _buffer.clear();
+            }
+
+            [[nodiscard]] auto data() const noexcept -> const u8* {
+                return _buffer.data();
+            }
+
+            [[nodiscard]] auto size() const noexcept -> usize {
+                return _buffer.size();
+            }
+        };
+
+        auto write_file(const char* path, const u8* data, const usize size) noexcept -> bool {
+            const auto fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+            if(fd < 0) {
+                return false;
+            }
+            usize offset = 0;
+            while(offset < size) {
+                const auto result = ::write(fd, data + offset, size - offset);
+                if(result < 0) {
+                    if(errno == EINTR) {
+                        continue;
+                    }
+                    break;
+                }
+                offset += static_cast<usize>(result);
+            }
+            return ::close(fd) == 0 && offset == size;
+        }
+
+        auto append_hex(BytesMut& buffer, const usize value) noexcept -> void {
+            char digits[2 + sizeof(usize) * 2];// NOLINT
+            usize size = sizeof(digits);
+            auto remaining = value;
+            do {
+                digits[--size] = "0123456789abcdef"[remaining & 0xF];
+                remaining >>= 4;
+            } while(remaining != 0);
+            digits[--size] = 'x';
+            digits[--size] = '0';
+            buffer.append(reinterpret_cast<const u8*>(digits + size), sizeof(digits) - size);
+        }
+
+        struct ValueType final {
+            StringView type;
+            StringView unit;
+        };
+
+        /**
+         * Writes one "outer;...;inner value" line per stack with a non-zero value.
+         */
+        template<usize TValueCount>
+        auto write_folded_stacks(const char* path, const StackTable<TValueCount>& stacks, const usize value_index) noexcept -> bool {
+            SymbolTable symbols(stacks.get_all_frames());
+            auto& strings = symbols.get_strings();
+
+            BytesMut buffer {};
+            char digits[number::max_chars<u64>];// NOLINT
+            for(const auto& entry : stacks.get_entries()) {
+                const auto value = entry.values[value_index];
+                const auto frames = stacks.get_frames(entry);
+                if(value == 0 || frames.size() == 0) {
+                    continue;
+                }
+                // Folded stacks start at the outermost frame
+                for(usize i = frames.size(); i > 0; --i) {
+                    const auto location = symbols.find(frames[i - 1]);
+                    const auto lines = symbols.get_lines(location);
+                    if(lines.size() == 0) {
+                        append_hex(buffer, reinterpret_cast<usize>(frames[i - 1]));
+                        buffer.push_back(';');
+                        continue;
+                    }
+                    for(usize j = lines.size(); j > 0; --j) {
+                        buffer.append(strings.resolve(lines[j - 1].name).get_view());
+                        buffer.push_back(';');
+                    }
+                }
+                buffer.data()[buffer.size() - 1] = ' ';
+                buffer.append(reinterpret_cast<const u8*>(digits), to_chars(digits, value));
+                buffer.push_back('\n');
+            }
+            return write_file(path, buffer.data(), buffer.size());
+        }
+
+        /**
+         * Writes an uncompressed pprof profile with one sample value per value of the table.
+         */
+        template<usize TValueCount>
+        auto write_pprof_profile(const char* path,
+                                 const StackTable<TValueCount>& stacks,
+                                 const ValueType* sample_types,
+                                 const ValueType& period_type,
+                                 const u64 period,
+                                 const u64 duration) noexcept -> bool {
+            SymbolTable symbols(stacks.get_all_frames());
+            auto& strings = symbols.get_strings();
+
+            ProtoWriter profile {};
+            ProtoWriter message {};
+            ProtoWriter nested {};
+            // Profile.sample_type
+            for(usize i = 0; i < TValueCount; ++i) {
+                message.write_uint(1, strings.intern(sample_types[i].type).get_id());
+                message.write_uint(2, strings.intern(sample_types[i].unit).get_id());
+                profile.write_message(1, message);
+                message.clear();
+            }
+
+            // Profile.sample, location ids are leaf first just like the captured frames
+            for(const auto& entry : stacks.get_entries()) {
+                for(auto* address : stacks.get_frames(entry)) {
+                    message.write_uint(1, symbols.find(address) + 1);
+                }
+                for(usize i = 0; i < TValueCount; ++i) {
+                    message.write_uint(2, entry.values[i]);
+                }
+                profile.write_message(2, message);
+                message.clear();
+            }
+
+            // Functions are identified by their name and file
+            const auto& addresses = symbols.get_addresses();
+            Array<u64> functions {};
+            for(usize i = 0; i < addresses.size(); ++i) {
+                for(const auto& line : symbols.get_lines(i)) {
+                    functions.reserve_amortized(functions.size() + 1);
+                    functions.push_back((static_cast<u64>(line.name) << 32) | line.file);
+                }
+            }
+            std::sort(functions.begin(), functions.end());
+            functions.resize(static_cast<usize>(std::unique(functions.begin(), functions.end()) - functions.begin()));
+
+            // Profile.location, with one line per inlined function and innermost first
+            for(usize i = 0; i < addresses.size(); ++i) {
+                message.write_uint(1, i + 1).write_uint(3, reinterpret_cast<usize>(addresses[i]));
+                for(const auto& line : symbols.get_lines(i)) {
+                    const auto key = (static_cast<u64>(line.name) << 32) | line.file;
+                    const auto function = std::lower_bound(functions.begin(), functions.end(), key) - functions.begin();
+                    nested.write_uint(1, static_cast<u64>(function) + 1).write_uint(2, line.line);
+                    message.write_message(4, nested);
+                    nested.clear();
+                }
+                profile.write_message(4, message);
+                message.clear();
+            }
+
+            // Profile.function, the name doubles as the system name
+            for(usize i = 0; i < functions.size(); ++i) {
+                const auto name = functions[i] >> 32;
+                message.write_uint(1, i + 1).write_uint(2, name).write_uint(3, name).write_uint(4, functions[i] & 0xFFFFFFFF);
+                profile.write_message(5, message);
+                message.clear();
+            }
+
+            // Profile.duration_nanos, period_type and period
+            profile.write_uint(10, duration);
+            message.write_uint(1, strings.intern(period_type.type).get_id());
+            message.write_uint(2, strings.intern(period_type.unit).get_id());
+            profile.write_message(11, message);
+            profile.write_uint(12, period);
+
+            // Profile.string_table, the interner assigns dense ids starting with the empty string
+            for(usize i = 0; i < strings.size(); ++i) {
+                profile.write_string(6, strings.resolve(static_cast<u32>(i)).get_view());
+            }
+            return write_file(path, profile.data(), profile.size());
+        }
+
+        struct Sample final {
+            usize depth;
+            FixedArray<void*, max_depth> frames;
+        };
+
+        /**
+         * A single-producer single-consumer queue. It is written by the signal handler
+         * of the owning thread and read by the aggregator, so neither side ever blocks.
+         */
+        struct SampleRing final {
+            Atomic<usize> head {0};
+            Atomic<usize> tail {0};
+            FixedArray<Sample, ring_capacity> samples;
+
+            auto push(void* const* frames, const usize depth) noexcept -> bool {
+                const auto index = head.load(std::memory_order_relaxed);
+                if(index - tail.load(std::memory_order_acquire) == ring_capacity) {
+                    return false;
+                }
+                auto& sample = samples[index % ring_capacity];
+                sample.depth = depth;
+                for(usize i = 0; i < depth; ++i) {
+                    sample.frames[i] = frames[i];
+                }
+                head.store(index + 1, std::memory_order_release);
+                return true;
+            }
+
+            template<typename F>
+            auto drain(F&& function) noexcept -> void {
+                auto index = tail.load(std::memory_order_relaxed);
+                const auto end = head.load(std::memory_order_acquire);
+                for(; index != end; ++index) {
+                    const auto& sample = samples[index % ring_capacity];
+                    function(sample.frames.data(), sample.depth);
+                }
+                tail.store(index, std::memory_order_release);
+            }
+        };
+
+        struct ThreadState final {
+            SampleRing ring;
+#ifdef KSTD_PLATFORM_LINUX
+            pid_t thread_id;
+            clockid_t clock;
+            timer_t timer;
+            bool has_timer;
+#endif
+        };
+
+        Atomic<bool> is_sampling {false};
+        Atomic<usize> dropped_count {0};
+        thread_local ThreadState* current_thread = nullptr;
+
+        // Guards everything below, the signal handler never touches any of it
+        std::mutex mutex;// NOLINT
+        std::condition_variable wakeup;// NOLINT
+        std::thread aggregator;// NOLINT
+        bool is_stopping = false;
+        Array<ThreadState*> threads;// NOLINT
+        StackTable<2> table;// NOLINT
+        u64 sampling_period = 0;
+        u64 sampled_duration = 0;
+        std::chrono::steady_clock::time_point start_time;// NOLINT
+        struct sigaction previous_action;// NOLINT
+
+        [[nodiscard]] auto get_context_address(void* context) noexcept -> void* {
+            const auto* user_context = static_cast<const ucontext_t*>(context);
+#if defined(KSTD_PLATFORM_LINUX) && defined(__x86_64__)
+            return reinterpret_cast<void*>(user_context->uc_mcontext.gregs[REG_RIP]);
+#elif defined(KSTD_PLATFORM_LINUX) && defined(__aarch64__)
+            return reinterpret_cast<void*>(user_context->uc_mcontext.pc);
+#elif defined(KSTD_PLATFORM_MACOS) && defined(__x86_64__)
+            return reinterpret_cast<void*>(user_context->uc_mcontext->__ss.__rip);
+#elif defined(KSTD_PLATFORM_MACOS) && defined(__aarch64__)
+            return reinterpret_cast<void*>(user_context->uc_mcontext->__ss.__pc);
+#else
+            static_cast<void>(user_context);
+            return nullptr;
+#endif
+        }
+
+        /**
+         * Finds the interrupted frame behind the signal handler and the signal trampoline.
+         * libunwind steps through the signal frame and reports the interrupted address itself,
+         * while frame pointer chains skip from the trampoline to the caller of the interrupted
+         * function, so the address from the signal context is patched in instead.
+         *
+         * @return The index of the interrupted frame.
+         */
+        [[nodiscard]] auto find_interrupted_frame(void** frames, const usize depth, void* address) noexcept -> usize {
+            if(address == nullptr) {
+                return min(depth, static_cast<usize>(2));
+            }
+            for(usize i = 0; i < min(depth, handler_depth); ++i) {
+                if(frames[i] == address) {
+                    return i;
+                }
+            }
+            if(depth < 2) {
+                return depth;
+            }
+            frames[1] = address;
+            return 1;
+        }
+
+        auto handle_signal(const i32 signal, siginfo_t* info, void* context) noexcept -> void {
+            static_cast<void>(signal);
+            static_cast<void>(info);
+            if(!is_sampling.load(std::memory_order_relaxed)) {
+                return;
+            }
+            const auto saved_errno = errno;
+            auto* state = current_thread;
+            if(state == nullptr) {
+                dropped_count.fetch_add(1, std::memory_order_relaxed);
+                errno = saved_errno;
+                return;
+            }
+            FixedArray<void*, capture_depth> frames {};
+            const auto depth = StackTrace::capture(frames.data(), capture_depth);
+            const auto first_frame = find_interrupted_frame(frames.data(), depth, get_context_address(context));
+            if(!state->ring.push(frames.data() + first_frame, min(depth - first_frame, max_depth))) {
+                dropped_count.fetch_add(1, std::memory_order_relaxed);
+            }
+            errno = saved_errno;
+        }
+
+        auto add_sample(void* const* frames, const usize depth) noexcept -> void {
+            const u64 values[] = {1, sampling_period};// NOLINT
+            static_cast<void>(table.add(frames, depth, values));
+        }
+
+        auto drain_threads() noexcept -> void {
+            for(auto* state : threads) {
+                state->ring.drain(add_sample);
+            }
+        }
+
+        auto run_aggregator() noexcept -> void {
+            std::unique_lock lock(mutex);
+            while(!is_stopping) {
+                wakeup.wait_for(lock, drain_interval);
+                drain_threads();
+            }
+        }
+
+        [[nodiscard]] auto get_duration() noexcept -> u64 {
+            if(!is_sampling.load(std::memory_order_relaxed)) {
+                return sampled_duration;
+            }
+            const auto elapsed = std::chrono::steady_clock::now() - start_time;
+            return sampled_duration + static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        }
+
+#ifdef KSTD_PLATFORM_LINUX
+        auto arm_timer(ThreadState& state) noexcept -> bool {
+            sigevent event {};
+            event.sigev_notify = SIGEV_THREAD_ID;
+            event.sigev_signo = SIGPROF;
+            event.sigev_notify_thread_id = state.thread_id;
+            if(timer_create(state.clock, &event, &state.timer) != 0) {
+                return false;
+            }
+            itimerspec spec {};
+            spec.it_interval.tv_sec = static_cast<time_t>(sampling_period / nanoseconds_per_second);
+            spec.it_interval.tv_nsec = static_cast<long>(sampling_period % nanoseconds_per_second);
+            spec.it_value = spec.it_interval;
+            if(timer_settime(state.timer, 0, &spec, nullptr) != 0) {
+                timer_delete(state.timer);
+                return false;
+            }
+            state.has_timer = true;
+            return true;
+        }
+
+        auto disarm_timer(ThreadState& state) noexcept -> void {
+            if(!state.has_timer) {
+                return;
+            }
+            timer_delete(state.timer);
+            state.has_timer = false;
+        }
+#else
+        auto set_process_timer(const u64 period) noexcept -> bool {
+            itimerval value {};
+            value.it_interval.tv_sec = static_cast<time_t>(period / nanoseconds_per_second);
+            value.it_interval.tv_usec = static_cast<suseconds_t>(max<u64>((period % nanoseconds_per_second) / 1000, period == 0 ? 0 : 1));
+            value.it_value = value.it_interval;
+            return setitimer(ITIMER_PROF, &value, nullptr) == 0;
+        }
+#endif
+
+        /**
+         * Copies the aggregate, so symbolization doesn't block the aggregator.
+         */
+        [[nodiscard]] auto get_snapshot(u64& period, u64& duration) noexcept -> StackTable<2> {
+            const std::lock_guard lock(mutex);
+            drain_threads();
+            period = sampling_period;
+            duration = get_duration();
+            return table;
+        }
+    }// namespace
+
+    auto start(const usize frequency) noexcept -> bool {
+        if(frequency == 0) {
+            return false;
+        }
+        const std::lock_guard lock(mutex);
+        if(is_sampling.load(std::memory_order_relaxed)) {
+            return false;
+        }
+        struct sigaction action {};
+        action.sa_sigaction = handle_signal;
+        action.sa_flags = SA_SIGINFO | SA_RESTART;
+        sigemptyset(&action.sa_mask);
+        if(sigaction(SIGPROF, &action, &previous_action) != 0) {
+            return false;
+        }
+        sampling_period = max<u64>(nanoseconds_per_second / frequency, 1);
+        start_time = std::chrono::steady_clock::now();
+        is_sampling.store(true, std::memory_order_relaxed);
+#ifdef KSTD_PLATFORM_LINUX
+        for(auto* state : threads) {
+            static_cast<void>(arm_timer(*state));
+        }
+#else
+        static_cast<void>(set_process_timer(sampling_period));
+#endif
+        is_stopping = false;
+        aggregator = std::thread(run_aggregator);
+        return true;
+    }
+
+    auto stop() noexcept -> void {
+        std::unique_lock lock(mutex);
+        if(!is_sampling.load(std::memory_order_relaxed)) {
+            return;
+        }
+#ifdef KSTD_PLATFORM_LINUX
+        for(auto* state : threads) {
+            disarm_timer(*state);
+        }
+#else
+        static_cast<void>(set_process_timer(0));
+#endif
+        sampled_duration = get_duration();
+        is_sampling.store(false, std::memory_order_relaxed);
+        is_stopping = true;
+        lock.unlock();
+        wakeup.notify_all();
+        aggregator.join();
+        lock.lock();
+        drain_threads();
+        // Signals which are still pending would terminate the process under the default action
+        if(previous_action.sa_handler == SIG_DFL) {
+            previous_action.sa_handler = SIG_IGN;
+        }
+        sigaction(SIGPROF, &previous_action, nullptr);
+    }
+
+    auto is_running() noexcept -> bool {
+        return is_sampling.load(std::memory_order_relaxed);
+    }
+
+    auto register_thread() noexcept -> bool {
+        if(current_thread != nullptr) {
+            return true;
+        }
+        auto* state = new ThreadState();
+#ifdef KSTD_PLATFORM_LINUX
+        state->thread_id = static_cast<pid_t>(syscall(SYS_gettid));
+        state->has_timer = false;
+        if(pthread_getcpuclockid(pthread_self(), &state->clock) != 0) {
+            delete state;
+            return false;
+        }
+#endif
+        // Whatever the unwind mode is now, it may be switched while the thread is sampled
+        StackTrace::prepare_thread();
+
+        const std::lock_guard lock(mutex);
+        threads.reserve_amortized(threads.size() + 1);
+        threads.push_back(state);
+        current_thread = state;
+#ifdef KSTD_PLATFORM_LINUX
+        if(is_sampling.load(std::memory_order_relaxed)) {
+            static_cast<void>(arm_timer(*state));
+        }
+#endif
+        return true;
+    }
+
+    auto unregister_thread() noexcept -> void {
+        auto* state = current_thread;
+        if(state == nullptr) {
+            return;
+        }
+        const std::lock_guard lock(mutex);
+#ifdef KSTD_PLATFORM_LINUX
+        disarm_timer(*state);
+#endif
+        current_thread = nullptr;
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+        state->ring.drain(add_sample);
+        for(usize i = 0; i < threads.size(); ++i) {
+            if(threads[i] != state) {
+                continue;
+            }
+            threads[i] = threads[threads.size() - 1];
+            threads.resize(threads.size() - 1);
+            break;
+        }
+        delete state;
+    }
+
+    auto get_sample_count() noexcept -> usize {
+        const std::lock_guard lock(mutex);
+        drain_threads();
+        return table.get_sample_count();
+    }
+
+    auto get_dropped_count() noexcept -> usize {
+        return dropped_count.load(std::memory_order_relaxed);
+    }
+
+    auto reset() noexcept -> void {
+        const std::lock_guard lock(mutex);
+        drain_threads();
+        table.clear();
+        sampled_duration = 0;
+        start_time = std::chrono::steady_clock::now();
+        dropped_count.store(0, std::memory_order_relaxed);
+    }
+
+    auto write_folded(const char* path) noexcept -> bool {
+        u64 period = 0;
+        u64 duration = 0;
+        return write_folded_stacks(path, get_snapshot(period, duration), 0);
+    }
+
+    auto write_pprof(const char* path) noexcept -> bool {
+        u64 period = 0;
+        u64 duration = 0;
+        const auto stacks = get_snapshot(period, duration);
+        const ValueType sample_types[] = {{"samples"_str, "count"_str}, {"cpu"_str, "nanoseconds"_str}};// NOLINT
+        return write_pprof_profile(path, stacks, sample_types, {"cpu"_str, "nanoseconds"_str}, period, duration);
+    }
+
+    namespace heap {
+        Atomic<bool> is_sampling {false};
+
+        namespace {
+            constexpr usize filter_size = 1 << 16;
+            constexpr usize page_shift = 12;
+            constexpr usize initial_live_slot_count = 256;
+
+            struct LiveAllocation final {
+                void* address;
+                u32 stack;
+                u64 count;
+                u64 size;
+            };
+
+            // Counts the live samples per page hash, so record_free can skip the lock for almost every block
+            Atomic<u32> page_filter[filter_size];// NOLINT
+
+            struct HeapState final {
+                std::mutex mutex;// Guards everything below
+                StackTable<2> allocations;
+                Array<LiveAllocation> live_allocations;
+                usize live_count {0};
+                std::chrono::steady_clock::time_point enable_time;
+            };
+
+            Atomic<usize> sampling_interval {default_interval};
+            thread_local bool is_in_hook = false;
+            thread_local isize bytes_until_sample = 0;
+            thread_local u64 random_state = 0;
+
+            /**
+             * Suppresses sampling on the calling thread, so the profiler's own allocations are neither
+             * sampled nor able to re-enter the profiler while it holds its lock.
+             */
+            class HookScope final {
+            public:
+                HookScope() noexcept {
+                    is_in_hook = true;
+                }
+
+                KSTD_NO_MOVE_COPY(HookScope, HookScope)
+
+                ~HookScope() noexcept {
+                    is_in_hook = false;
+                }
+            };
+
+            /**
+             * The state is never destroyed, since blocks may still be freed while static destructors run.
+             */
+            [[nodiscard]] auto get_state() noexcept -> HeapState& {
+                static auto* state = new HeapState();
+                return *state;
+            }
+
+            [[nodiscard]] auto get_filter_slot(const void* address) noexcept -> Atomic<u32>& {
+                const auto page = static_cast<u64>(reinterpret_cast<usize>(address) >> page_shift);
+                return page_filter[static_cast<usize>(hash::mix(page ^ hash::secret, hash::seed_secret)) & (filter_size - 1)];
+            }
+
+            [[nodiscard]] auto get_home_slot(const void* address, const usize slot_count) noexcept -> usize {
+                const auto value = static_cast<u64>(reinterpret_cast<usize>(address));
+                return static_cast<usize>(hash::mix(value ^ hash::secret, hash::default_seed)) & (slot_count - 1);
+            }
+
+            /**
+             * @return The number of bytes until the next sample, exponentially distributed around the interval.
+             */
+            [[nodiscard]] auto get_sample_distance(const usize interval) noexcept -> isize {
+                if(random_state == 0) {
+                    random_state = hash::mix(reinterpret_cast<usize>(&random_state) ^ hash::secret, hash::default_seed) | 1;
+                }
+                // xorshift64*, the upper 53 bits make a uniform value in (0, 1]
+                random_state ^= random_state >> 12;
+                random_state ^= random_state << 25;
+                random_state ^= random_state >> 27;
+                const auto uniform = static_cast<f64>(((random_state * 0x2545F4914F6CDD1DULL) >> 11) + 1) * 0x1.0p-53;
+                return static_cast<isize>(-std::log(uniform) * static_cast<f64>(interval)) + 1;
+            }
+
+            auto rehash_live(HeapState& state, const usize slot_count) noexcept -> void {
+                const auto previous = move(state.live_allocations);
+                state.live_allocations = Array<LiveAllocation>(slot_count, LiveAllocation {nullptr, 0, 0, 0});
+                for(const auto& allocation : previous) {
+                    if(allocation.address == nullptr) {
+                        continue;
+                    }
+                    auto slot = get_home_slot(allocation.address, state.live_allocations.size());
+                    while(state.live_allocations[slot].address != nullptr) {
+                        slot = (slot + 1) & (slot_count - 1);
+                    }
+                    state.live_allocations[slot] = allocation;
+                }
+            }
+
+            auto insert_live(HeapState& state, const LiveAllocation& allocation) noexcept -> void {
+                if((state.live_count + 1) * 2 > state.live_allocations.size()) {
+                    rehash_live(state, max(state.live_allocations.size() * 2, initial_live_slot_count));
+                }
+                auto slot = get_home_slot(allocation.address, state.live_allocations.size());
+                while(state.live_allocations[slot].address != nullptr) {
+                    slot = (slot + 1) & (state.live_allocations.size() - 1);
+                }
+                state.live_allocations[slot] = allocation;
+                ++state.live_count;
+            }
+
+            /**
+             * Removes the given block with backward shift deletion, which keeps probe sequences intact without tombstones.
+             */
+            [[nodiscard]] auto erase_live(HeapState& state, void* address) noexcept -> bool {
+                if(state.live_count == 0) {
+                    return false;
+                }
+                const auto mask = state.live_allocations.size() - 1;
+                auto slot = get_home_slot(address, state.live_allocations.size());
+                while(state.live_allocations[slot].address != address) {
+                    if(state.live_allocations[slot].address == nullptr) {
+                        return false;
+                    }
+                    slot = (slot + 1) & mask;
+                }
+                auto next = slot;
+                while(true) {
+                    next = (next + 1) & mask;
+                    const auto* candidate = state.live_allocations[next].address;
+                    if(candidate == nullptr) {
+                        break;
+                    }
+                    // Entries whose home slot lies cyclically within (slot, next] have to stay
+                    const auto home = get_home_slot(candidate, state.live_allocations.size());
+                    if(slot <= next ? (slot < home && home <= next) : (slot < home || home <= next)) {
+                        continue;
+                    }
+                    state.live_allocations[slot] = state.live_allocations[next];
+                    slot = next;
+                }
+                state.live_allocations[slot].address = nullptr;
+                --state.live_count;
+                return true;
+            }
+
+            /**
+             * Combines the allocated and the live values per stack into one table, in the pprof heap layout.
+             */
+            [[nodiscard]] auto get_snapshot(u64& duration) noexcept -> StackTable<4> {
+                auto& state = get_state();
+                const std::lock_guard lock(state.mutex);
+                StackTable<4> snapshot {};
+                for(const auto& entry : state.allocations.get_entries()) {
+                    const auto frames = state.allocations.get_frames(entry);
+                    const u64 values[] = {entry.values[0], entry.values[1], 0, 0};// NOLINT
+                    static_cast<void>(snapshot.add(frames.data(), frames.size(), values));
+                }
+                for(const auto& allocation : state.live_allocations) {
+                    if(allocation.address == nullptr) {
+                        continue;
+                    }
+                    const auto frames = state.allocations.get_frames(allocation.stack);
+                    const u64 values[] = {0, 0, allocation.count, allocation.size};// NOLINT
+                    static_cast<void>(snapshot.add(frames.data(), frames.size(), values));
+                }
+                const auto elapsed = std::chrono::steady_clock::now() - state.enable_time;
+                duration = static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+                return snapshot;
+            }
+        }// namespace
+
+        auto enable(const usize interval) noexcept -> bool {
+            if(interval == 0) {
+                return false;
+            }
+            const HookScope scope {};
+            auto& state = get_state();
+            const std::lock_guard lock(state.mutex);
+            sampling_interval.store(interval, std::memory_order_relaxed);
+            if(is_sampling.load(std::memory_order_relaxed)) {
+                return true;
+            }
+            state.allocations.clear();
+            state.live_allocations.clear();
+            state.live_count = 0;
+            rehash_live(state, initial_live_slot_count);
+            for(auto& count : page_filter) {
+                count.store(0, std::memory_order_relaxed);
+            }
+            state.enable_time = std::chrono::steady_clock::now();
+            is_sampling.store(true, std::memory_order_relaxed);
+            return true;
+        }
+
+        auto disable() noexcept -> void {
+            is_sampling.store(false, std::memory_order_relaxed);
+        }
+
+        auto record_allocation(void* memory, const usize size) noexcept -> void {
+            if(memory == nullptr || is_in_hook) {
+                return;
+            }
+            bytes_until_sample -= static_cast<isize>(size);
+            if(bytes_until_sample > 0) {
+                return;
+            }
+            const auto interval = sampling_interval.load(std::memory_order_relaxed);
+            const auto is_first_sample = random_state == 0;
+            bytes_until_sample = get_sample_distance(interval);
+            if(is_first_sample) {
+                return;// The countdown of this thread only started now
+            }
+
+            const HookScope scope {};
+            auto& state = get_state();
+            FixedArray<void*, max_depth> frames {};
+            const auto depth = StackTrace::capture(frames.data(), max_depth, 1);
+            // An allocation of this size is sampled with a probability of 1 - e^(-size / interval)
+            const auto weight = 1.0 / (1.0 - std::exp(-static_cast<f64>(size) / static_cast<f64>(interval)));
+            const auto count = static_cast<u64>(weight + 0.5);
+            const auto bytes = static_cast<u64>(weight * static_cast<f64>(size) + 0.5);
+            const u64 values[] = {count, bytes};// NOLINT
+
+            const std::lock_guard lock(state.mutex);
+            const auto stack = state.allocations.add(frames.data(), depth, values);
+            insert_live(state, {memory, stack, count, bytes});
+            get_filter_slot(memory).fetch_add(1, std::memory_order_relaxed);
+        }
+
+        auto record_free(void* memory) noexcept -> void {
+            if(memory == nullptr || is_in_hook) {
+                return;
+            }
+            auto& filter_slot = get_filter_slot(memory);
+            if(filter_slot.load(std::memory_order_relaxed) == 0) {
+                return;
+            }
+            auto& state = get_state();
+            const std::lock_guard lock(state.mutex);
+            if(erase_live(state, memory)) {
+                filter_slot.fetch_sub(1, std::memory_order_relaxed);
+            }
+        }
+
+        auto get_bytes(const ProfileKind kind) noexcept -> usize {
+            const HookScope scope {};
+            auto& state = get_state();
+            const std::lock_guard lock(state.mutex);
+            u64 bytes = 0;
+            if(kind == ProfileKind::LIVE) {
+                for(const auto& allocation : state.live_allocations) {
+                    bytes += allocation.address != nullptr ? allocation.size : 0;
+                }
+                return static_cast<usize>(bytes);
+            }
+            for(const auto& entry : state.allocations.get_entries()) {
+                bytes += entry.values[1];
+            }
+            return static_cast<usize>(bytes);
+        }
+
+        auto write_folded(const char* path, const ProfileKind kind) noexcept -> bool {
+            const HookScope scope {};
+            u64 duration = 0;
+            return write_folded_stacks(path, get_snapshot(duration), kind == ProfileKind::LIVE ? 3 : 1);
+        }
+
+        auto write_pprof(const char* path) noexcept -> bool {
+            const HookScope scope {};
+            u64 duration = 0;
+            const auto stacks = get_snapshot(duration);
+            const ValueType sample_types[] = {// NOLINT
+                {"alloc_objects"_str, "count"_str},
+                {"alloc_space"_str, "bytes"_str},
+                {"inuse_objects"_str, "count"_str},
+                {"inuse_space"_str, "bytes"_str}};
+            const auto interval = sampling_interval.load(std::memory_order_relaxed);
+            return write_pprof_profile(path, stacks, sample_types, {"space"_str, "bytes"_str}, interval, duration);
+        }
+    }// namespace heap
+}// namespace kstd::profiler
+
+#endif//KSTD_PLATFORM_UNIX
\ No newline at end of file
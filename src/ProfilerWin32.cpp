@@ -0,0 +1,102 @@
+// Copyright 2024 Karma Krafts & associates
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+#ifdef KSTD_PLATFORM_WINDOWS
+
+#include "kstd/HeapProfiler.hpp"
+#include "kstd/Profiler.hpp"
+
+// Windows has no CPU time signals, sampling would need a thread which suspends and walks the others
+namespace kstd::profiler {
+    auto start(const usize frequency) noexcept -> bool {
+        static_cast<void>(frequency);
+        return false;
+    }
+
+    auto stop() noexcept -> void {
+    }
+
+    auto is_running() noexcept -> bool {
+        return false;
+    }
+
+    auto register_thread() noexcept -> bool {
+        return false;
+    }
+
+    auto unregister_thread() noexcept -> void {
+    }
+
+    auto get_sample_count() noexcept -> usize {
+        return 0;
+    }
+
+    auto get_dropped_count() noexcept -> usize {
+        return 0;
+    }
+
+    auto reset() noexcept -> void {
+    }
+
+    auto write_folded(const char* path) noexcept -> bool {
+        static_cast<void>(path);
+        return false;
+    }
+
+    auto write_pprof(const char* path) noexcept -> bool {
+        static_cast<void>(path);
+        return false;
+    }
+
+    // The heap profiler shares its stack tables and profile writers with the Unix CPU profiler
+    namespace heap {
+        Atomic<bool> is_sampling {false};
+
+        auto enable(const usize interval) noexcept -> bool {
+            static_cast<void>(interval);
+            return false;
+        }
+
+        auto disable() noexcept -> void {
+        }
+
+        auto record_allocation(void* memory, const usize size) noexcept -> void {
+            static_cast<void>(memory);
+            static_cast<void>(size);
+        }
+
+        auto record_free(void* memory) noexcept -> void {
+            static_cast<void>(memory);
+        }
+
+        auto get_bytes(const ProfileKind kind) noexcept -> usize {
+            static_cast<void>(kind);
+            return 0;
+        }
+
+        auto write_folded(const char* path, const ProfileKind kind) noexcept -> bool {
+            static_cast<void>(path);
+            static_cast<void>(kind);
+            return false;
+        }
+
+        auto write_pprof(const char* path) noexcept -> bool {
+            static_cast<void>(path);
+            return false;
+        }
+    }// namespace heap
+}// namespace kstd::profiler
+
+#endif//KSTD_PLATFORM_WINDOWS
\ No newline at end of file
@@ -0,0 +1,114 @@
+// Copyright 2024 Karma Krafts & associates
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "kstd/Search.hpp"
+
+#include "kstd/Bits.hpp"
+#include "kstd/CPU.hpp"
+
+// NOLINTBEGIN
+#if defined(KSTD_CPU_X86_FAMILY)
+#include <immintrin.h>
+#endif
+// NOLINTEND
+
+#ifdef KSTD_COMPILER_MSVC
+#define KSTD_TARGET(x)
+#else
+#define KSTD_TARGET(x) __attribute__((target(x)))
+#endif
+
+namespace kstd::search::simd {
+    namespace {
+        using FindAnyOfKernel = usize (*)(const u8*, usize, const ByteSet&) noexcept;
+
+        [[nodiscard]] auto find_any_of_scalar(const u8* data, const usize size, const ByteSet& set) noexcept -> usize {
+            for(usize index = 0; index < size; ++index) {
+                if(set.contains(data[index])) {
+                    return index;
+                }
+            }
+            return npos;
+        }
+
+#if defined(KSTD_CPU_X86_FAMILY)
+        /**
+         * Looks up the set bits of every byte's low and high nibble in the tables of the set,
+         * a byte is a member if both lookups share a bit.
+         */
+        KSTD_TARGET("ssse3")
+        [[nodiscard]] auto find_any_of_ssse3(const u8* data, const usize size, const ByteSet& set) noexcept -> usize {
+            constexpr usize vector_size = sizeof(__m128i);
+            usize index = 0;
+            if(set.is_nibble_exact()) {
+                const auto low_table = _mm_loadu_si128(reinterpret_cast<const __m128i*>(set.get_low_table()));
+                const auto high_table = _mm_loadu_si128(reinterpret_cast<const __m128i*>(set.get_high_table()));
+                const auto nibble_mask = _mm_set1_epi8(0x0F);
+                for(; index + vector_size <= size; index += vector_size) {
+                    const auto input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + index));
+                    const auto low = _mm_shuffle_epi8(low_table, _mm_and_si128(input, nibble_mask));
+                    const auto high = _mm_shuffle_epi8(high_table, _mm_and_si128(_mm_srli_epi16(input, 4), nibble_mask));
+                    const auto non_members = _mm_cmpeq_epi8(_mm_and_si128(low, high), _mm_setzero_si128());
+                    const auto mask = ~static_cast<u32>(_mm_movemask_epi8(non_members)) & 0xFFFF;
+                    if(mask != 0) {
+                        return index + bits::count_trailing_zeros(mask);
+                    }
+                }
+            }
+            const auto result = find_any_of_scalar(data + index, size - index, set);
+            return result == npos ? npos : result + index;
+        }
+
+        KSTD_TARGET("avx2")
+        [[nodiscard]] auto find_any_of_avx2(const u8* data, const usize size, const ByteSet& set) noexcept -> usize {
+            constexpr usize vector_size = sizeof(__m256i);
+            usize index = 0;
+            if(set.is_nibble_exact()) {
+                const auto low_table = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(set.get_low_table())));
+                const auto high_table = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(set.get_high_table())));
+                const auto nibble_mask = _mm256_set1_epi8(0x0F);
+                for(; index + vector_size <= size; index += vector_size) {
+                    const auto input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + index));
+                    const auto low = _mm256_shuffle_epi8(low_table, _mm256_and_si256(input, nibble_mask));
+                    const auto high = _mm256_shuffle_epi8(high_table, _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble_mask));
+                    const auto non_members = _mm256_cmpeq_epi8(_mm256_and_si256(low, high), _mm256_setzero_si256());
+                    const auto mask = ~static_cast<u32>(_mm256_movemask_epi8(non_members));
+                    if(mask != 0) {
+                        return index + bits::count_trailing_zeros(mask);
+                    }
+                }
+            }
+            const auto result = find_any_of_scalar(data + index, size - index, set);
+            return result == npos ? npos : result + index;
+        }
+#endif
+
+        [[nodiscard]] auto select_find_any_of_kernel() noexcept -> FindAnyOfKernel {
+#if defined(KSTD_CPU_X86_FAMILY)
+            const auto& features = cpu::get_features();
+            if(features.has_avx2) {
+                return &find_any_of_avx2;
+            }
+            if(features.has_ssse3) {
+                return &find_any_of_ssse3;
+            }
+#endif
+            return &find_any_of_scalar;
+        }
+    }// namespace
+
+    auto find_any_of(const u8* data, const usize size, const ByteSet& set) noexcept -> usize {
+        static const auto kernel = select_find_any_of_kernel();
+        return kernel(data, size, set);
+    }
+}// namespace kstd::search::simd
\ No newline at end of file
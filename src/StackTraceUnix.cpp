@@ -15,24 +15,39 @@
 
 #include "kstd/StackTrace.hpp"
 
+#include <algorithm>
 #include <cxxabi.h>
 #include <dlfcn.h>
+#include <fcntl.h>
 #include <libdwarf/dwarf.h>
 #include <libdwarf/libdwarf.h>
 #include <libunwind.h>
+#include <link.h>
+#include <mutex>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include "kstd/Array.hpp"
+#include "kstd/Atomic.hpp"
 #include "kstd/FixedArray.hpp"
-#include "kstd/Functional.hpp"
+#include "kstd/Interner.hpp"
 #include "kstd/Math.hpp"
-#include "kstd/Queue.hpp"
-#include "kstd/Tuple.hpp"
+#include "kstd/String.hpp"
+#include "kstd/StringView.hpp"
+#include "kstd/SymbolCache.hpp"
 
 namespace kstd {
     // Make sure the pointer size matches the unwind word size
     static_assert(sizeof(unw_word_t) >= sizeof(void*));
 
-    constexpr usize MAX_NAME_SIZE = 4096;
+    constexpr usize MAX_ORIGIN_DEPTH = 4;// How many abstract origins/specifications are followed to find a name
+    constexpr usize MAX_INLINE_DEPTH = 64;
+    constexpr usize MAX_BUILD_ID_SIZE = 64;
+    constexpr u64 SYMBOL_INDEX_MAGIC = 0x314D59534454534BULL;// "KSTDSYM1" in little endian byte order
+    constexpr u32 SYMBOL_INDEX_VERSION = 1;
+    constexpr u32 NO_INDEX = static_cast<u32>(-1);
 
     using DWARFDie = Dwarf_Die_s;
     using DWARFObject = Dwarf_Debug_s;
@@ -43,24 +58,55 @@ namespace kstd {
     using DWARFUnsigned = Dwarf_Unsigned;
     using DWARFBool = Dwarf_Bool;
     using DWARFOff = Dwarf_Off;
+    using DWARFAddr = Dwarf_Addr;
 
-    [[nodiscard]] inline auto demangle(const String& name) noexcept -> String {
+    /**
+     * @return The given null-terminated name, interned into the symbol cache.
+     */
+    [[nodiscard]] inline auto intern(const char* name) noexcept -> StringView {
+        return get_symbol_cache().intern({name, strlen(name)});
+    }
+
+    /**
+     * Invokes the given function with the demangled name, or with the name itself if it can't be demangled.
+     */
+    template<typename TFunction>
+    [[nodiscard]] auto with_demangled(const char* name, TFunction&& function) noexcept -> decltype(auto) {
         int status;
-        auto* memory = abi::__cxa_demangle(name.c_str(), nullptr, nullptr, &status);
+        auto* memory = abi::__cxa_demangle(name, nullptr, nullptr, &status);
         if(status != 0 || memory == nullptr) {
-            return name;
+            return function(StringView(name, strlen(name)));
         }
-        String result(memory);
+        auto result = function(StringView(memory, strlen(memory)));
         free(memory);// This is heap memory allocated by __cxa_demangle when the output buffer is specified as nullptr
         return result;
     }
 
-    [[nodiscard]] inline auto get_binary(const void* address) noexcept -> String {
+    /**
+     * @return The demangled name, interned into the symbol cache.
+     */
+    [[nodiscard]] inline auto demangle(const char* name) noexcept -> StringView {
+        return with_demangled(name, [](const StringView& value) {
+            return get_symbol_cache().intern(value);
+        });
+    }
+
+    /**
+     * The binary containing an address and the offset it was loaded at, which has to
+     * be subtracted from runtime addresses to get the addresses used in its debug information.
+     */
+    struct BinaryInfo final {
+        StringView path;// Interned, so it is null-terminated
+        usize load_bias;
+    };
+
+    [[nodiscard]] inline auto get_binary(const void* address) noexcept -> BinaryInfo {
         Dl_info symbol_info;
-        if(dladdr(address, &symbol_info) > 0 && symbol_info.dli_fname) {
-            return String(symbol_info.dli_fname);
+        link_map* map = nullptr;
+        if(dladdr1(address, &symbol_info, reinterpret_cast<void**>(&map), RTLD_DL_LINKMAP) > 0 && symbol_info.dli_fname) {
+            return {intern(symbol_info.dli_fname), map != nullptr ? static_cast<usize>(map->l_addr) : 0};
         }
-        return "";
+        return {StringView(), 0};
     }
 
     [[nodiscard]] inline auto get_attrib(DWARFDie* die, const u16 attribute) noexcept -> DWARFAttribute* {
@@ -76,216 +122,1450 @@ namespace kstd {
         return attrib;
     }
 
-    template<typename T, decltype(auto) TFormer, DWARFHalf... TForms>
-    requires(is_callable<decltype(TFormer), DWARFAttribute*, T*, DWARFError**>)
-    [[nodiscard]] auto get_attrib_value(DWARFObject* object, DWARFDie* die, const DWARFHalf attribute) noexcept
-        -> Pair<DWARFAttribute*, T> {
+    [[nodiscard]] inline auto get_unsigned_attrib(DWARFDie* die, const u16 attribute, DWARFUnsigned& value) noexcept -> bool {
         auto* attrib = get_attrib(die, attribute);
         if(attrib == nullptr) {
-            return {nullptr, {}};
+            return false;
         }
         DWARFError* error = nullptr;
-        DWARFHalf form;
-        if(dwarf_whatform(attrib, &form, &error) != DW_DLV_OK || ((form != TForms) && ...)) {
-            dwarf_dealloc(object, attrib, DW_DLA_ATTR);
-            return {nullptr, {}};
-        }
-        T value {};
-        if(TFormer(attrib, &value, &error) != DW_DLV_OK) {
-            dwarf_dealloc(object, attrib, DW_DLA_ATTR);
-            return {nullptr, {}};
-        }
-        return {attrib, value};
-    }
-
-    inline auto extract_die_information(DWARFObject* object,
-                                        DWARFDie* die,
-                                        String& file_name,
-                                        usize& line,
-                                        usize& column,
-                                        const Array<String>& file_names) noexcept -> void {
-        // Extract source file name
-        const auto [file_attrib, file_index] =
-            get_attrib_value<DWARFUnsigned, &dwarf_formudata, DW_FORM_udata, DW_FORM_sdata, DW_FORM_implicit_const, DW_FORM_data1,
-                             DW_FORM_data2, DW_FORM_data4, DW_FORM_data8, DW_FORM_data16>(object, die, DW_AT_decl_file);
-        if(file_attrib != nullptr) {
-            file_name = file_names[file_index];
-            dwarf_dealloc(object, file_attrib, DW_DLA_ATTR);
-        }
-        // Extract line number
-        const auto [line_attrib, line_no] =
-            get_attrib_value<DWARFUnsigned, &dwarf_formudata, DW_FORM_udata, DW_FORM_sdata, DW_FORM_implicit_const, DW_FORM_data1,
-                             DW_FORM_data2, DW_FORM_data4, DW_FORM_data8, DW_FORM_data16>(object, die, DW_AT_decl_line);
-        if(line_attrib != nullptr) {
-            line = line_no;
-            dwarf_dealloc(object, line_attrib, DW_DLA_ATTR);
-        }
-        // Extract column number
-        const auto [column_attrib, column_no] =
-            get_attrib_value<DWARFUnsigned, &dwarf_formudata, DW_FORM_udata, DW_FORM_sdata, DW_FORM_implicit_const, DW_FORM_data1,
-                             DW_FORM_data2, DW_FORM_data4, DW_FORM_data8, DW_FORM_data16>(object, die, DW_AT_decl_column);
-        if(column_attrib != nullptr) {
-            column = column_no;
-            dwarf_dealloc(object, column_attrib, DW_DLA_ATTR);
-        }
-    }
-
-    [[nodiscard]] inline auto process_die(DWARFObject* object,
-                                          DWARFDie* die,
-                                          const String& mangled_name,
-                                          String& file_name,
-                                          usize& line,
-                                          usize& column,
-                                          Queue<DWARFDie*>& queue,
-                                          const Array<String>& file_names) noexcept -> bool {// NOLINT
-        // Check if our current DIE is a subprogram aka. function
-        DWARFHalf tag;
+        const auto result = dwarf_formudata(attrib, &value, &error) == DW_DLV_OK;
+        dwarf_dealloc_attribute(attrib);
+        return result;
+    }
+
+    /**
+     * @return The string value of the given attribute, which is owned by the DWARF object, or null.
+     */
+    [[nodiscard]] inline auto get_string_attrib(DWARFDie* die, const u16 attribute) noexcept -> const char* {
+        auto* attrib = get_attrib(die, attribute);
+        if(attrib == nullptr) {
+            return nullptr;
+        }
         DWARFError* error = nullptr;
-        if(dwarf_tag(die, &tag, &error) == DW_DLV_OK && tag == DW_TAG_subprogram) {
-            char* name;
-            if(dwarf_diename(die, &name, &error) != DW_DLV_OK || name == nullptr) {
+        char* value = nullptr;
+        if(dwarf_formstring(attrib, &value, &error) != DW_DLV_OK) {
+            value = nullptr;
+        }
+        dwarf_dealloc_attribute(attrib);
+        return value;
+    }
+
+    /**
+     * The raw name of a function, which is owned by the DWARF object.
+     */
+    struct DWARFName final {
+        const char* value;
+        bool is_mangled;
+    };
+
+    /**
+     * Resolves the name of a function DIE, following abstract origins and specifications
+     * since inlined and out-of-line instances usually don't carry a name themselves.
+     * Demangling is left to the first lookup which actually hits the function.
+     */
+    [[nodiscard]] inline auto get_function_name(DWARFObject* object, DWARFDie* die, const usize depth = 0) noexcept -> DWARFName {// NOLINT
+        auto* linkage_name = get_string_attrib(die, DW_AT_linkage_name);
+        if(linkage_name == nullptr) {
+            linkage_name = get_string_attrib(die, DW_AT_MIPS_linkage_name);
+        }
+        if(linkage_name != nullptr) {
+            return {linkage_name, true};
+        }
+        if(auto* name = get_string_attrib(die, DW_AT_name); name != nullptr) {
+            return {name, false};
+        }
+        if(depth == MAX_ORIGIN_DEPTH) {
+            return {nullptr, false};
+        }
+        for(const auto attribute : {DW_AT_abstract_origin, DW_AT_specification}) {
+            auto* attrib = get_attrib(die, attribute);
+            if(attrib == nullptr) {
+                continue;
+            }
+            DWARFError* error = nullptr;
+            DWARFOff offset = 0;
+            DWARFDie* origin = nullptr;
+            const auto has_origin = dwarf_global_formref(attrib, &offset, &error) == DW_DLV_OK &&
+                                    dwarf_offdie_b(object, offset, true, &origin, &error) == DW_DLV_OK && origin != nullptr;
+            dwarf_dealloc_attribute(attrib);
+            if(!has_origin) {
+                continue;
+            }
+            auto name = get_function_name(object, origin, depth + 1);
+            dwarf_dealloc_die(origin);
+            return name;
+        }
+        return {nullptr, false};
+    }
+
+    /**
+     * A half-open range of addresses which belongs to the element at the given index.
+     */
+    struct DWARFAddressRange final {
+        DWARFAddr low;
+        DWARFAddr high;
+        u32 index;
+
+        [[nodiscard]] auto contains(const DWARFAddr address) const noexcept -> bool {
+            return address >= low && address < high;
+        }
+    };
+
+    /**
+     * @return The index of the range in the given array, sorted by low address, which contains
+     * the given address, or NO_INDEX if there is none.
+     */
+    [[nodiscard]] inline auto find_range(const Array<DWARFAddressRange>& ranges, const DWARFAddr address) noexcept -> u32 {
+        const auto* range = std::upper_bound(ranges.begin(), ranges.end(), address,
+                                             [](const DWARFAddr value, const DWARFAddressRange& element) {
+                                                 return value < element.low;
+                                             });
+        if(range == ranges.begin() || !(--range)->contains(address)) {
+            return NO_INDEX;
+        }
+        return range->index;
+    }
+
+    /**
+     * Collects the code ranges of a DIE from either its low/high PC pair or its range list.
+     *
+     * @param base The base address of the compilation unit, which DWARF 4 range lists are relative to.
+     * @param version The DWARF version of the compilation unit.
+     */
+    inline auto get_die_ranges(DWARFObject* object,
+                               DWARFDie* die,
+                               const DWARFAddr base,
+                               const DWARFHalf version,
+                               const u32 index,
+                               Array<DWARFAddressRange>& ranges) noexcept -> bool {
+        DWARFError* error = nullptr;
+        DWARFAddr low = 0;
+        if(dwarf_lowpc(die, &low, &error) == DW_DLV_OK) {
+            DWARFAddr high = 0;
+            DWARFHalf form = 0;
+            Dwarf_Form_Class form_class = DW_FORM_CLASS_UNKNOWN;
+            if(dwarf_highpc_b(die, &high, &form, &form_class, &error) != DW_DLV_OK) {
                 return false;
             }
-            // If the DIE name matches the mangled name, this is an unmangled exported function
-            if(mangled_name == name) {
-                extract_die_information(object, die, file_name, line, column, file_names);
-                dwarf_dealloc(object, name, DW_DLA_STRING);// Deallocate name string when we're done
-                return true;                               // Probably an unmangled libc function
-            }
-            dwarf_dealloc(object, name, DW_DLA_STRING);// Deallocate name string when we're done
-            // If the linkage name matches the mangled name, this is a mangled (likely C++) function and we found it
-            const auto [linkage_name_attrib, linkage_name] =
-                get_attrib_value<char*, &dwarf_formstring, DW_FORM_strp, DW_FORM_string, DW_FORM_strx, DW_FORM_strx1, DW_FORM_strx2,
-                                 DW_FORM_strx3, DW_FORM_strx4>(object, die, DW_AT_linkage_name);
-            if(linkage_name_attrib != nullptr && linkage_name != nullptr && mangled_name == linkage_name) {
-                extract_die_information(object, die, file_name, line, column, file_names);
-                dwarf_dealloc(object, linkage_name, DW_DLA_STRING);
-                dwarf_dealloc(object, linkage_name_attrib, DW_DLA_ATTR);
-                return true;
+            if(form_class == DW_FORM_CLASS_CONSTANT) {
+                high += low;// Since DWARF 4, the high PC may be an offset from the low PC
+            }
+            if(high <= low) {
+                return false;
             }
+            ranges.push_back({low, high, index});
+            return true;
+        }
+
+        auto* attrib = get_attrib(die, DW_AT_ranges);
+        if(attrib == nullptr) {
             return false;
         }
-        // Check if we have any children and if we do, add them to the queue before we return
-        DWARFDie* child_die = nullptr;
-        if(dwarf_child(die, &child_die, &error) == DW_DLV_OK && child_die != nullptr) {
-            do {
-                queue.push(child_die);
-            } while(dwarf_siblingof(object, child_die, &child_die, &error) == DW_DLV_OK && child_die != nullptr);
+        DWARFHalf form = 0;
+        DWARFUnsigned offset = 0;
+        auto result = dwarf_whatform(attrib, &form, &error) == DW_DLV_OK;
+        if(result) {
+            result = form == DW_FORM_rnglistx ? dwarf_formudata(attrib, &offset, &error) == DW_DLV_OK
+                                              : dwarf_global_formref(attrib, &offset, &error) == DW_DLV_OK;
+        }
+        const auto previous_size = ranges.size();
+        if(result && version >= 5) {
+            Dwarf_Rnglists_Head head = nullptr;
+            DWARFUnsigned count = 0;
+            DWARFUnsigned global_offset = 0;
+            if(dwarf_rnglists_get_rle_head(attrib, form, offset, &head, &count, &global_offset, &error) == DW_DLV_OK) {
+                for(DWARFUnsigned i = 0; i < count; ++i) {
+                    unsigned int length = 0;
+                    unsigned int kind = 0;
+                    DWARFUnsigned raw_low = 0;
+                    DWARFUnsigned raw_high = 0;
+                    DWARFBool is_unavailable = 0;
+                    DWARFUnsigned entry_low = 0;
+                    DWARFUnsigned entry_high = 0;
+                    if(dwarf_get_rnglists_entry_fields_a(head, i, &length, &kind, &raw_low, &raw_high, &is_unavailable, &entry_low,
+                                                         &entry_high, &error) != DW_DLV_OK) {
+                        break;
+                    }
+                    if(kind == DW_RLE_end_of_list) {
+                        break;
+                    }
+                    if(kind == DW_RLE_base_address || kind == DW_RLE_base_addressx || is_unavailable || entry_high <= entry_low) {
+                        continue;// Base address selections are already applied to the cooked values
+                    }
+                    ranges.push_back({entry_low, entry_high, index});
+                }
+                dwarf_dealloc_rnglists_head(head);
+            }
+        }
+        else if(result) {
+            Dwarf_Ranges* entries = nullptr;
+            DWARFSigned count = 0;
+            DWARFUnsigned byte_count = 0;
+            DWARFOff real_offset = 0;
+            if(dwarf_get_ranges_b(object, offset, die, &real_offset, &entries, &count, &byte_count, &error) == DW_DLV_OK) {
+                auto current_base = base;
+                for(DWARFSigned i = 0; i < count; ++i) {
+                    const auto& entry = entries[i];
+                    if(entry.dwr_type == DW_RANGES_END) {
+                        break;
+                    }
+                    if(entry.dwr_type == DW_RANGES_ADDRESS_SELECTION) {
+                        current_base = entry.dwr_addr2;
+                        continue;
+                    }
+                    if(entry.dwr_addr2 > entry.dwr_addr1) {
+                        ranges.push_back({current_base + entry.dwr_addr1, current_base + entry.dwr_addr2, index});
+                    }
+                }
+                dwarf_dealloc_ranges(object, entries, count);
+            }
         }
-        return false;
+        dwarf_dealloc_attribute(attrib);
+        return ranges.size() > previous_size;
     }
 
-    [[nodiscard]] inline auto get_source_info(const String& binary, const String& mangled_name) noexcept -> Tuple<String, usize, usize> {
-        // Initialize DWARF debug object
-        DWARFObject* object = nullptr;
-        if(dwarf_init_path(binary.c_str(), nullptr, 0, DW_GROUPNUMBER_ANY, 0, nullptr, nullptr, &object, nullptr, 0, nullptr, nullptr) !=
-           DW_DLV_OK) {
-            return {"", 0, 0};
+    /**
+     * A subprogram or an inlined subroutine. Scopes are stored in DIE pre-order,
+     * so all scopes nested into a scope directly follow it up to its subtree end.
+     */
+    struct DWARFScope final {
+        DWARFName name;
+        StringView function_name;// Interned from the name on first use
+        u32 call_file;// The file the scope was inlined from, NO_INDEX for subprograms
+        usize call_line;
+        usize call_column;
+        u32 first_range;
+        u32 range_count;
+        u32 subtree_end;
+    };
+
+    /**
+     * A row of the line number program, which applies from its address up to the next row.
+     */
+    struct DWARFLineRow final {
+        DWARFAddr address;
+        u32 file;
+        u32 line;
+        u32 column;
+        bool is_end_sequence;
+    };
+
+    /**
+     * A compilation unit of a cached binary. Its scopes and line table are indexed on the
+     * first lookup of an address inside of it, so binaries are only indexed as a whole
+     * to persist their symbol index.
+     */
+    struct DWARFUnit final {
+        DWARFOff offset;// The global offset of the root DIE
+        DWARFHalf version;
+        Array<StringView> source_files;// Interned
+        bool is_indexed;
+        Array<DWARFScope> scopes;
+        Array<DWARFAddressRange> scope_ranges;// Indexed by the scopes, in scope order
+        Array<DWARFAddressRange> functions;   // The ranges of all subprograms, sorted by low address
+        Array<DWARFLineRow> lines;            // Sorted by address
+
+        /**
+         * @param index A file index as found in call_file attributes and line rows.
+         */
+        [[nodiscard]] auto get_source_file_index(const usize index) const noexcept -> u32 {
+            // File indices are 1-based before DWARF 5
+            const usize offset = version >= 5 ? 0 : 1;
+            if(index < offset || index - offset >= source_files.size()) {
+                return NO_INDEX;
+            }
+            return static_cast<u32>(index - offset);
         }
-        // Iterate through compilation units
-        DWARFError* error = nullptr;
-        DWARFUnsigned cu_header_length;
-        DWARFHalf cu_header_version;
-        DWARFOff cu_abbrev_offset;
-        DWARFHalf cu_address_size;
-        DWARFUnsigned cu_next_header_offset;
-        String file_name {};
+
+        /**
+         * @param index A file index as found in call_file attributes and line rows.
+         */
+        [[nodiscard]] auto get_source_file(const usize index) const noexcept -> StringView {
+            const auto file_index = get_source_file_index(index);
+            return file_index != NO_INDEX ? source_files[file_index] : StringView();
+        }
+
+        [[nodiscard]] auto get_scope_name(const u32 index) noexcept -> StringView {
+            auto& scope = scopes[index];
+            if(scope.name.value != nullptr) {
+                scope.function_name = scope.name.is_mangled ? demangle(scope.name.value) : intern(scope.name.value);
+                scope.name.value = nullptr;
+            }
+            return scope.function_name;
+        }
+
+        [[nodiscard]] auto get_subtree_end(const u32 index) const noexcept -> u32 {
+            return scopes[index].subtree_end;
+        }
+
+        auto get_call_site(const u32 index, StringView& file_name, usize& line, usize& column) const noexcept -> void {
+            const auto& scope = scopes[index];
+            file_name = scope.call_file != NO_INDEX ? get_source_file(scope.call_file) : StringView();
+            line = scope.call_line;
+            column = scope.call_column;
+        }
+
+        [[nodiscard]] auto contains(const u32 index, const DWARFAddr address) const noexcept -> bool {
+            const auto& scope = scopes[index];
+            for(u32 i = 0; i < scope.range_count; ++i) {
+                if(scope_ranges[scope.first_range + i].contains(address)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        auto index_scopes(DWARFObject* object, DWARFDie* parent, const DWARFAddr base) noexcept -> void {// NOLINT
+            DWARFError* error = nullptr;
+            DWARFDie* die = nullptr;
+            if(dwarf_child(parent, &die, &error) != DW_DLV_OK || die == nullptr) {
+                return;
+            }
+            while(die != nullptr) {
+                DWARFHalf tag = 0;
+                if(dwarf_tag(die, &tag, &error) != DW_DLV_OK) {
+                    tag = 0;
+                }
+                if(tag == DW_TAG_subprogram || tag == DW_TAG_inlined_subroutine) {
+                    const auto index = static_cast<u32>(scopes.size());
+                    const auto first_range = static_cast<u32>(scope_ranges.size());
+                    // Declarations and scopes without code can't contain any other code either
+                    if(get_die_ranges(object, die, base, version, index, scope_ranges)) {
+                        DWARFScope scope {get_function_name(object, die), {}, NO_INDEX, 0, 0, first_range,
+                                          static_cast<u32>(scope_ranges.size()) - first_range, 0};
+                        if(tag == DW_TAG_inlined_subroutine) {
+                            DWARFUnsigned value = 0;
+                            if(get_unsigned_attrib(die, DW_AT_call_file, value)) {
+                                scope.call_file = static_cast<u32>(value);
+                            }
+                            if(get_unsigned_attrib(die, DW_AT_call_line, value)) {
+                                scope.call_line = value;
+                            }
+                            if(get_unsigned_attrib(die, DW_AT_call_column, value)) {
+                                scope.call_column = value;
+                            }
+                        }
+                        else {
+                            for(auto i = first_range; i < scope_ranges.size(); ++i) {
+                                functions.push_back(scope_ranges[i]);
+                            }
+                        }
+                        scopes.push_back(kstd::move(scope));
+                        index_scopes(object, die, base);
+                        scopes[index].subtree_end = static_cast<u32>(scopes.size());
+                    }
+                }
+                else {
+                    index_scopes(object, die, base);// Namespaces, classes and lexical blocks
+                }
+                DWARFDie* sibling = nullptr;
+                if(dwarf_siblingof(object, die, &sibling, &error) != DW_DLV_OK) {
+                    sibling = nullptr;
+                }
+                dwarf_dealloc_die(die);
+                die = sibling;
+            }
+        }
+
+        auto index_lines(DWARFDie* die) noexcept -> void {
+            DWARFError* error = nullptr;
+            DWARFUnsigned line_version = 0;
+            Dwarf_Small table_count = 0;
+            Dwarf_Line_Context context = nullptr;
+            if(dwarf_srclines_b(die, &line_version, &table_count, &context, &error) != DW_DLV_OK) {
+                return;
+            }
+            Dwarf_Line* rows = nullptr;
+            DWARFSigned count = 0;
+            if(dwarf_srclines_from_linecontext(context, &rows, &count, &error) == DW_DLV_OK) {
+                lines.reserve(static_cast<usize>(count));
+                for(DWARFSigned i = 0; i < count; ++i) {
+                    DWARFAddr address = 0;
+                    DWARFUnsigned file = 0;
+                    DWARFUnsigned line = 0;
+                    DWARFUnsigned column = 0;
+                    DWARFBool is_end_sequence = 0;
+                    if(dwarf_lineaddr(rows[i], &address, &error) != DW_DLV_OK) {
+                        continue;
+                    }
+                    dwarf_line_srcfileno(rows[i], &file, &error);
+                    dwarf_lineno(rows[i], &line, &error);
+                    dwarf_lineoff_b(rows[i], &column, &error);
+                    dwarf_lineendsequence(rows[i], &is_end_sequence, &error);
+                    lines.push_back({address, static_cast<u32>(file), static_cast<u32>(line), static_cast<u32>(column),
+                                     is_end_sequence != 0});
+                }
+            }
+            dwarf_srclines_dealloc_b(context);
+            // A sequence may start where the previous one ends, the end marker has to come first
+            std::stable_sort(lines.begin(), lines.end(), [](const DWARFLineRow& lhs, const DWARFLineRow& rhs) {
+                return lhs.address < rhs.address || (lhs.address == rhs.address && lhs.is_end_sequence && !rhs.is_end_sequence);
+            });
+        }
+
+        auto index(DWARFObject* object) noexcept -> void {
+            is_indexed = true;
+            DWARFError* error = nullptr;
+            DWARFDie* die = nullptr;
+            if(dwarf_offdie_b(object, offset, true, &die, &error) != DW_DLV_OK || die == nullptr) {
+                return;
+            }
+            DWARFAddr base = 0;
+            if(dwarf_lowpc(die, &base, &error) != DW_DLV_OK) {
+                base = 0;
+            }
+            index_scopes(object, die, base);
+            std::sort(functions.begin(), functions.end(), [](const DWARFAddressRange& lhs, const DWARFAddressRange& rhs) {
+                return lhs.low < rhs.low;
+            });
+            index_lines(die);
+            dwarf_dealloc_die(die);
+        }
+
+        [[nodiscard]] auto find_line(const DWARFAddr address) const noexcept -> const DWARFLineRow* {
+            const auto* row = std::upper_bound(lines.begin(), lines.end(), address, [](const DWARFAddr value, const DWARFLineRow& element) {
+                return value < element.address;
+            });
+            if(row == lines.begin() || (--row)->is_end_sequence) {
+                return nullptr;
+            }
+            return row;
+        }
+    };
+
+    /**
+     * Appends the elements of the innermost scope containing the given address and of all scopes
+     * it was inlined into, up to the given function. The unit is either a DWARFUnit or a unit of
+     * a mapped SymbolIndex, which both provide the same lookups.
+     */
+    template<typename TUnit>
+    auto append_scope_chain(TUnit& unit,
+                            const u32 function_index,
+                            void* address,
+                            const DWARFAddr pc,
+                            const StringView& binary,
+                            Array<StackTraceElement>& elements) noexcept -> void {
+        // Descend into the innermost inlined subroutine containing the address
+        FixedArray<u32, MAX_INLINE_DEPTH> chain {};
+        usize chain_size = 1;
+        chain[0] = function_index;
+        auto current = function_index + 1;
+        while(current < unit.get_subtree_end(chain[chain_size - 1]) && chain_size < MAX_INLINE_DEPTH) {
+            if(unit.contains(current, pc)) {
+                chain[chain_size++] = current++;
+                continue;
+            }
+            current = unit.get_subtree_end(current);
+        }
+        // The line table locates the innermost scope, every scope's call site locates its caller
+        StringView file_name {};
         usize line = 0;
         usize column = 0;
-        bool found = false;
-        while(dwarf_next_cu_header(object, &cu_header_length, &cu_header_version, &cu_abbrev_offset, &cu_address_size,
-                                   &cu_next_header_offset, &error) == DW_DLV_OK) {
-            // Retrieve compilation unit root DIE
-            DWARFDie* die;
-            if(dwarf_siblingof(object, nullptr, &die, &error) != DW_DLV_OK || die == nullptr) {
-                continue;
+        if(const auto* row = unit.find_line(pc); row != nullptr) {
+            file_name = unit.get_source_file(row->file);
+            line = row->line;
+            column = row->column;
+        }
+        for(auto i = chain_size; i > 0; --i) {
+            const auto scope = chain[i - 1];
+            elements.emplace_back(address, binary, file_name, unit.get_scope_name(scope), line, column, i > 1);
+            unit.get_call_site(scope, file_name, line, column);
+        }
+    }
+
+    /**
+     * The GNU build-id of a loaded binary, which identifies its exact contents.
+     */
+    struct BuildId final {
+        FixedArray<u8, MAX_BUILD_ID_SIZE> data;
+        usize size;
+    };
+
+    /**
+     * Reads the build-id note from the program headers of the loaded binary containing the given address.
+     *
+     * @return False if the binary was linked without a build-id.
+     */
+    [[nodiscard]] inline auto get_build_id(const void* address, BuildId& build_id) noexcept -> bool {
+        struct Query final {
+            usize address;
+            BuildId& build_id;
+        } query {reinterpret_cast<usize>(address), build_id};
+        build_id.size = 0;
+        dl_iterate_phdr(
+            [](dl_phdr_info* info, const usize, void* data) -> int {
+                auto& query = *static_cast<Query*>(data);
+                auto is_containing = false;
+                for(usize i = 0; i < info->dlpi_phnum && !is_containing; ++i) {
+                    const auto& header = info->dlpi_phdr[i];
+                    const auto start = static_cast<usize>(info->dlpi_addr + header.p_vaddr);
+                    is_containing = header.p_type == PT_LOAD && query.address >= start && query.address - start < header.p_memsz;
+                }
+                if(!is_containing) {
+                    return 0;
+                }
+                for(usize i = 0; i < info->dlpi_phnum; ++i) {
+                    const auto& header = info->dlpi_phdr[i];
+                    if(header.p_type != PT_NOTE) {
+                        continue;
+                    }
+                    const auto* position = reinterpret_cast<const u8*>(info->dlpi_addr + header.p_vaddr);
+                    const auto* end = position + header.p_memsz;
+                    while(static_cast<usize>(end - position) >= sizeof(ElfW(Nhdr))) {
+                        const auto* note = reinterpret_cast<const ElfW(Nhdr)*>(position);
+                        const auto* name = position + sizeof(ElfW(Nhdr));
+                        const auto* descriptor = name + ((note->n_namesz + 3) & ~3U);
+                        position = descriptor + ((note->n_descsz + 3) & ~3U);
+                        if(position > end) {
+                            break;
+                        }
+                        if(note->n_type == NT_GNU_BUILD_ID && note->n_namesz == 4 && memcmp(name, "GNU", 4) == 0 &&
+                           note->n_descsz > 0 && note->n_descsz <= MAX_BUILD_ID_SIZE) {
+                            memcpy(query.build_id.data.data(), descriptor, note->n_descsz);
+                            query.build_id.size = note->n_descsz;
+                            return 1;
+                        }
+                    }
+                }
+                return 1;// The binary was found, but it has no build-id
+            },
+            &query);
+        return build_id.size > 0;
+    }
+
+    /**
+     * The header of a persisted symbol index. The sections follow the header in declaration order,
+     * each aligned to 8 bytes. All indices are global across the compilation units of the binary,
+     * and all names are offsets of null-terminated strings in the string section.
+     */
+    struct SymbolIndexHeader final {
+        u64 magic;
+        u32 version;
+        u32 build_id_size;
+        u8 build_id[MAX_BUILD_ID_SIZE];
+        u64 file_size;
+        u32 function_count;
+        u32 scope_count;
+        u32 range_count;
+        u32 unit_count;
+        u32 line_count;
+        u32 file_count;
+        u64 string_size;
+    };
+
+    struct SymbolIndexFunction final {
+        DWARFAddr low;
+        DWARFAddr high;
+        u32 scope;
+        u32 unit;
+    };
+
+    struct SymbolIndexScope final {
+        u32 name;
+        u32 call_file;
+        u32 call_line;
+        u32 call_column;
+        u32 first_range;
+        u32 range_count;
+        u32 subtree_end;
+        u32 padding;
+    };
+
+    struct SymbolIndexUnit final {
+        u32 first_line;
+        u32 line_count;
+    };
+
+    /**
+     * The offsets of all sections of a symbol index, computed from the counts in its header.
+     */
+    struct SymbolIndexLayout final {
+        usize functions;  // SymbolIndexFunction, sorted by low address
+        usize scopes;     // SymbolIndexScope, in DIE pre-order per unit
+        usize ranges;     // DWARFAddressRange, indexed by the scopes
+        usize units;      // SymbolIndexUnit
+        usize lines;      // DWARFLineRow, sorted by address per unit
+        usize files;      // u32 name offsets
+        usize strings;    // char
+        usize size;
+
+        explicit SymbolIndexLayout(const SymbolIndexHeader& header) noexcept {
+            auto offset = sizeof(SymbolIndexHeader);
+            const auto add_section = [&offset](const usize size) -> usize {
+                const auto start = (offset + 7) & ~static_cast<usize>(7);
+                offset = start + size;
+                return start;
+            };
+            functions = add_section(header.function_count * sizeof(SymbolIndexFunction));
+            scopes = add_section(header.scope_count * sizeof(SymbolIndexScope));
+            ranges = add_section(header.range_count * sizeof(DWARFAddressRange));
+            units = add_section(header.unit_count * sizeof(SymbolIndexUnit));
+            lines = add_section(header.line_count * sizeof(DWARFLineRow));
+            files = add_section(header.file_count * sizeof(u32));
+            strings = add_section(header.string_size);
+            size = offset;
+        }
+    };
+
+    /**
+     * A persisted index of all functions, inlined scopes and line rows of a binary, which is mapped
+     * into memory instead of parsing the debug information. Names are interned into the symbol cache
+     * when they are looked up, so the mapping never outlives any element.
+     */
+    class SymbolIndex final {
+        u8* _memory;
+        usize _size;
+        const SymbolIndexHeader* _header;
+        const SymbolIndexFunction* _functions;
+        const SymbolIndexScope* _scopes;
+        const DWARFAddressRange* _ranges;
+        const SymbolIndexUnit* _units;
+        const DWARFLineRow* _lines;
+        const u32* _files;
+        const char* _strings;
+
+        [[nodiscard]] auto get_string(const u32 offset) const noexcept -> StringView {
+            return offset < _header->string_size ? intern(_strings + offset) : StringView();
+        }
+
+        /**
+         * A compilation unit of the index, with the same lookups as DWARFUnit.
+         */
+        struct Unit final {
+            const SymbolIndex& index;
+            const SymbolIndexUnit& unit;
+
+            [[nodiscard]] auto get_subtree_end(const u32 scope) const noexcept -> u32 {
+                return index._scopes[scope].subtree_end;
+            }
+
+            [[nodiscard]] auto contains(const u32 scope, const DWARFAddr address) const noexcept -> bool {
+                const auto& entry = index._scopes[scope];
+                for(u32 i = 0; i < entry.range_count; ++i) {
+                    if(index._ranges[entry.first_range + i].contains(address)) {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            [[nodiscard]] auto find_line(const DWARFAddr address) const noexcept -> const DWARFLineRow* {
+                const auto* begin = index._lines + unit.first_line;
+                const auto* row = std::upper_bound(begin, begin + unit.line_count, address,
+                                                   [](const DWARFAddr value, const DWARFLineRow& element) {
+                                                       return value < element.address;
+                                                   });
+                if(row == begin || (--row)->is_end_sequence) {
+                    return nullptr;
+                }
+                return row;
+            }
+
+            [[nodiscard]] auto get_source_file(const u32 file) const noexcept -> StringView {
+                return file < index._header->file_count ? index.get_string(index._files[file]) : StringView();
+            }
+
+            [[nodiscard]] auto get_scope_name(const u32 scope) const noexcept -> StringView {
+                return index.get_string(index._scopes[scope].name);
+            }
+
+            auto get_call_site(const u32 scope, StringView& file_name, usize& line, usize& column) const noexcept -> void {
+                const auto& entry = index._scopes[scope];
+                file_name = get_source_file(entry.call_file);
+                line = entry.call_line;
+                column = entry.call_column;
+            }
+        };
+
+        [[nodiscard]] auto is_valid(const BuildId& build_id) const noexcept -> bool {
+            if(_size < sizeof(SymbolIndexHeader)) {
+                return false;
+            }
+            const auto& header = *reinterpret_cast<const SymbolIndexHeader*>(_memory);
+            if(header.magic != SYMBOL_INDEX_MAGIC || header.version != SYMBOL_INDEX_VERSION || header.file_size != _size ||
+               header.build_id_size != build_id.size || memcmp(header.build_id, build_id.data.data(), build_id.size) != 0) {
+                return false;
             }
-            // Extract source file name table
-            Array<String> source_files {};
-            char** file_names = nullptr;
-            DWARFSigned num_file_names = 0;
-            if(dwarf_srcfiles(die, &file_names, &num_file_names, &error) == DW_DLV_OK && file_names != nullptr) {
-                source_files.reserve(num_file_names);
-                for(usize i = 0; i < num_file_names; ++i) {
-                    source_files.emplace_back(file_names[i]);
+            const SymbolIndexLayout layout(header);
+            if(layout.size != _size) {
+                return false;
+            }
+            // Every index has to stay in bounds, so a corrupted index can't make lookups read past the mapping,
+            // and every subtree has to end behind its root, so walking the scopes always makes progress
+            const auto* scopes = reinterpret_cast<const SymbolIndexScope*>(_memory + layout.scopes);
+            for(u32 i = 0; i < header.scope_count; ++i) {
+                const auto& scope = scopes[i];
+                if(scope.subtree_end <= i || scope.subtree_end > header.scope_count || scope.first_range > header.range_count ||
+                   scope.range_count > header.range_count - scope.first_range) {
+                    return false;
+                }
+            }
+            const auto* functions = reinterpret_cast<const SymbolIndexFunction*>(_memory + layout.functions);
+            for(u32 i = 0; i < header.function_count; ++i) {
+                if(functions[i].scope >= header.scope_count || functions[i].unit >= header.unit_count) {
+                    return false;
+                }
+            }
+            const auto* units = reinterpret_cast<const SymbolIndexUnit*>(_memory + layout.units);
+            for(u32 i = 0; i < header.unit_count; ++i) {
+                if(units[i].first_line > header.line_count || units[i].line_count > header.line_count - units[i].first_line) {
+                    return false;
                 }
-                dwarf_dealloc(object, file_names, DW_DLA_LIST);
-            }
-            // Use heap recursion to find our desired function
-            Queue<DWARFDie*> queue {};
-            queue.push(die);
-            while(!queue.empty()) {
-                auto* current_die = queue.front();
-                if(process_die(object, current_die, mangled_name, file_name, line, column, queue, source_files)) {
-                    // Make sure we free all remaining DIEs
-                    while(!queue.empty()) {
-                        dwarf_dealloc_die(queue.front());
-                        queue.pop();
+            }
+            return header.string_size > 0 && _memory[layout.strings + header.string_size - 1] == '\0';
+        }
+
+        auto unmap() noexcept -> void {
+            if(_memory != nullptr) {
+                munmap(_memory, _size);
+                _memory = nullptr;
+                _size = 0;
+            }
+        }
+
+    public:
+        SymbolIndex() noexcept
+            : _memory(nullptr)
+            , _size(0)
+            , _header(nullptr)
+            , _functions(nullptr)
+            , _scopes(nullptr)
+            , _ranges(nullptr)
+            , _units(nullptr)
+            , _lines(nullptr)
+            , _files(nullptr)
+            , _strings(nullptr) {
+        }
+
+        KSTD_NO_MOVE_COPY(SymbolIndex, SymbolIndex)
+
+        ~SymbolIndex() noexcept {
+            unmap();
+        }
+
+        [[nodiscard]] auto is_mapped() const noexcept -> bool {
+            return _memory != nullptr;
+        }
+
+        /**
+         * Maps the index at the given path if it exists and was built for the given build-id.
+         */
+        auto map(const char* path, const BuildId& build_id) noexcept -> bool {
+            const auto fd = open(path, O_RDONLY | O_CLOEXEC);
+            if(fd < 0) {
+                return false;
+            }
+            struct stat status {};
+            if(fstat(fd, &status) != 0 || status.st_size <= 0) {
+                close(fd);
+                return false;
+            }
+            _size = static_cast<usize>(status.st_size);
+            auto* memory = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+            close(fd);
+            if(memory == MAP_FAILED) {
+                _size = 0;
+                return false;
+            }
+            _memory = static_cast<u8*>(memory);
+            if(!is_valid(build_id)) {
+                unmap();
+                return false;
+            }
+            _header = reinterpret_cast<const SymbolIndexHeader*>(_memory);
+            const SymbolIndexLayout layout(*_header);
+            _functions = reinterpret_cast<const SymbolIndexFunction*>(_memory + layout.functions);
+            _scopes = reinterpret_cast<const SymbolIndexScope*>(_memory + layout.scopes);
+            _ranges = reinterpret_cast<const DWARFAddressRange*>(_memory + layout.ranges);
+            _units = reinterpret_cast<const SymbolIndexUnit*>(_memory + layout.units);
+            _lines = reinterpret_cast<const DWARFLineRow*>(_memory + layout.lines);
+            _files = reinterpret_cast<const u32*>(_memory + layout.files);
+            _strings = reinterpret_cast<const char*>(_memory + layout.strings);
+            return true;
+        }
+
+        /**
+         * Appends the same elements as DWARFSession::symbolize.
+         */
+        auto symbolize(void* address, const DWARFAddr pc, const StringView& binary, Array<StackTraceElement>& elements) const noexcept
+            -> bool {
+            const auto* end = _functions + _header->function_count;
+            const auto* function = std::upper_bound(_functions, end, pc, [](const DWARFAddr value, const SymbolIndexFunction& element) {
+                return value < element.low;
+            });
+            if(function == _functions || (--function)->high <= pc) {
+                return false;
+            }
+            const Unit unit {*this, _units[function->unit]};
+            append_scope_chain(unit, function->scope, address, pc, binary, elements);
+            return true;
+        }
+    };
+
+    /**
+     * An opened DWARF object of a single binary, which is kept open for all later lookups,
+     * or the mapped symbol index of the binary, which replaces the DWARF object.
+     */
+    struct DWARFSession final {
+        StringView binary;// Interned, so it is null-terminated
+        DWARFObject* object;
+        Array<DWARFUnit> units;                // Sorted by offset
+        Array<DWARFAddressRange> unit_ranges;  // Sorted by low address
+        SymbolIndex index;
+
+        DWARFSession(const StringView& binary, DWARFObject* object) noexcept
+            : binary(binary)
+            , object(object) {
+        }
+
+        KSTD_NO_MOVE_COPY(DWARFSession, DWARFSession)
+
+        ~DWARFSession() noexcept {
+            close_object();
+        }
+
+        /**
+         * Closes the DWARF object and drops all units, once the symbol index took over their lookups.
+         */
+        auto close_object() noexcept -> void {
+            if(object != nullptr) {
+                DWARFError* error = nullptr;
+                dwarf_finish(object, &error);
+                object = nullptr;
+            }
+            units.clear();
+            unit_ranges.clear();
+        }
+
+        [[nodiscard]] auto find_unit(const DWARFOff offset) const noexcept -> u32 {
+            const auto* unit = std::lower_bound(units.begin(), units.end(), offset, [](const DWARFUnit& element, const DWARFOff value) {
+                return element.offset < value;
+            });
+            if(unit == units.end() || unit->offset != offset) {
+                return NO_INDEX;
+            }
+            return static_cast<u32>(unit - units.begin());
+        }
+
+        /**
+         * Maps addresses to compilation units through .debug_aranges.
+         *
+         * @return False if the binary has no address ranges table.
+         */
+        auto load_aranges() noexcept -> bool {
+            DWARFError* error = nullptr;
+            Dwarf_Arange* aranges = nullptr;
+            DWARFSigned count = 0;
+            if(dwarf_get_aranges(object, &aranges, &count, &error) != DW_DLV_OK) {
+                return false;
+            }
+            for(DWARFSigned i = 0; i < count; ++i) {
+                DWARFUnsigned segment = 0;
+                DWARFUnsigned segment_entry_size = 0;
+                DWARFAddr start = 0;
+                DWARFUnsigned length = 0;
+                DWARFOff unit_offset = 0;
+                if(dwarf_get_arange_info_b(aranges[i], &segment, &segment_entry_size, &start, &length, &unit_offset, &error) ==
+                   DW_DLV_OK) {
+                    const auto index = find_unit(unit_offset);
+                    if(index != NO_INDEX && length > 0) {
+                        unit_ranges.push_back({start, start + length, index});
                     }
-                    found = true;
-                    break;
                 }
-                dwarf_dealloc_die(current_die);// Deallocate die after we're done
-                queue.pop();
+                dwarf_dealloc(object, aranges[i], DW_DLA_ARANGE);
             }
-            if(found) {
-                break;
+            dwarf_dealloc(object, aranges, DW_DLA_LIST);
+            return unit_ranges.size() > 0;
+        }
+
+        /**
+         * Scans the compilation units once, so lookups never re-read the CU headers or file tables.
+         */
+        auto load_units() noexcept -> void {
+            DWARFError* error = nullptr;
+            DWARFUnsigned cu_header_length;
+            DWARFHalf cu_header_version;
+            DWARFOff cu_abbrev_offset;
+            DWARFHalf cu_address_size;
+            DWARFUnsigned cu_next_header_offset;
+            Array<DWARFAddressRange> root_ranges {};
+            while(dwarf_next_cu_header(object, &cu_header_length, &cu_header_version, &cu_abbrev_offset, &cu_address_size,
+                                       &cu_next_header_offset, &error) == DW_DLV_OK) {
+                DWARFDie* die;
+                if(dwarf_siblingof(object, nullptr, &die, &error) != DW_DLV_OK || die == nullptr) {
+                    continue;
+                }
+                DWARFUnit unit {};
+                unit.version = cu_header_version;
+                if(dwarf_dieoffset(die, &unit.offset, &error) != DW_DLV_OK) {
+                    dwarf_dealloc_die(die);
+                    continue;
+                }
+                char** file_names = nullptr;
+                DWARFSigned num_file_names = 0;
+                if(dwarf_srcfiles(die, &file_names, &num_file_names, &error) == DW_DLV_OK && file_names != nullptr) {
+                    unit.source_files.reserve(num_file_names);
+                    for(usize i = 0; i < static_cast<usize>(num_file_names); ++i) {
+                        unit.source_files.push_back(intern(file_names[i]));
+                        dwarf_dealloc(object, file_names[i], DW_DLA_STRING);
+                    }
+                    dwarf_dealloc(object, file_names, DW_DLA_LIST);
+                }
+                // Keep the ranges of the root DIE in case the binary comes without .debug_aranges
+                DWARFAddr base = 0;
+                if(dwarf_lowpc(die, &base, &error) != DW_DLV_OK) {
+                    base = 0;
+                }
+                get_die_ranges(object, die, base, unit.version, static_cast<u32>(units.size()), root_ranges);
+                dwarf_dealloc_die(die);
+                units.push_back(kstd::move(unit));
+            }
+            if(!load_aranges()) {
+                unit_ranges = kstd::move(root_ranges);
             }
+            std::sort(unit_ranges.begin(), unit_ranges.end(), [](const DWARFAddressRange& lhs, const DWARFAddressRange& rhs) {
+                return lhs.low < rhs.low;
+            });
         }
 
-        dwarf_finish(object, &error);
-        return {kstd::move(file_name), line, column};
+        /**
+         * Appends one element for the given address and one for every function which was inlined at it,
+         * innermost first.
+         *
+         * @param address The runtime address of the frame.
+         * @param pc The address to look up, relative to the binary.
+         * @return True if a function was found for the given address.
+         */
+        auto symbolize(void* address, const DWARFAddr pc, Array<StackTraceElement>& elements) noexcept -> bool {
+            if(index.is_mapped()) {
+                return index.symbolize(address, pc, binary, elements);
+            }
+            const auto unit_index = find_range(unit_ranges, pc);
+            if(unit_index == NO_INDEX) {
+                return false;
+            }
+            auto& unit = units[unit_index];
+            if(!unit.is_indexed) {
+                unit.index(object);
+            }
+            const auto function_index = find_range(unit.functions, pc);
+            if(function_index == NO_INDEX) {
+                return false;
+            }
+            append_scope_chain(unit, function_index, address, pc, binary, elements);
+            return true;
+        }
+    };
+
+    /**
+     * @return The id of the name of the given scope in the given interner, demangling it if needed.
+     */
+    [[nodiscard]] inline auto intern_scope_name(Interner& names, const DWARFScope& scope) noexcept -> u32 {
+        if(scope.name.value == nullptr) {
+            return names.intern(scope.function_name).get_id();// Already resolved by a lookup, or unnamed
+        }
+        if(!scope.name.is_mangled) {
+            return names.intern({scope.name.value, strlen(scope.name.value)}).get_id();
+        }
+        return with_demangled(scope.name.value, [&names](const StringView& value) {
+            return names.intern(value).get_id();
+        });
     }
 
-    auto StackTrace::get_current(const usize depth, const usize skip) noexcept -> StackTrace {
-        if(depth == 0) {
-            return StackTrace {};
+    [[nodiscard]] inline auto write_all(const int fd, const void* data, usize size) noexcept -> bool {
+        const auto* position = static_cast<const u8*>(data);
+        while(size > 0) {
+            const auto count = write(fd, position, size);
+            if(count < 0) {
+                if(errno == EINTR) {
+                    continue;
+                }
+                return false;
+            }
+            position += count;
+            size -= static_cast<usize>(count);
         }
-        unw_context_t context;
-        if(unw_getcontext(&context) != UNW_ESUCCESS) {
-            return StackTrace {};
+        return true;
+    }
+
+    /**
+     * Pads the file with zeros up to the given offset and writes the section there.
+     */
+    [[nodiscard]] inline auto write_section(const int fd, usize& position, const usize offset, const void* data, const usize size) noexcept
+        -> bool {
+        constexpr u8 padding[8] {};
+        if(offset < position || offset - position > sizeof(padding) || !write_all(fd, padding, offset - position)) {
+            return false;
         }
+        position = offset + size;
+        return write_all(fd, data, size);
+    }
 
-        unw_cursor_t cursor;
-        if(unw_init_local(&cursor, &context) != UNW_ESUCCESS) {
-            return StackTrace {};
+    /**
+     * Indexes all compilation units of the given session and writes them to the given path. The index
+     * is written to a temporary file first and renamed into place, so concurrent processes never map
+     * a partially written index.
+     */
+    inline auto write_symbol_index(DWARFSession& session, const String& path, const BuildId& build_id) noexcept -> bool {
+        usize function_count = 0;
+        usize scope_count = 0;
+        usize range_count = 0;
+        usize line_count = 0;
+        usize file_count = 0;
+        for(auto& unit : session.units) {
+            if(!unit.is_indexed) {
+                unit.index(session.object);
+            }
+            function_count += unit.functions.size();
+            scope_count += unit.scopes.size();
+            range_count += unit.scope_ranges.size();
+            line_count += unit.lines.size();
+            file_count += unit.source_files.size();
+        }
+        if(max(max(function_count, scope_count), max(max(range_count, line_count), file_count)) >= NO_INDEX) {
+            return false;
         }
 
-        FixedArray<char, MAX_NAME_SIZE> name_buffer {};
-        Array<StackTraceElement> stack_frames {};
-        usize index = 0;
+        Interner names {};
+        Array<SymbolIndexFunction> functions {};
+        Array<SymbolIndexScope> scopes {};
+        Array<DWARFAddressRange> ranges {};
+        Array<SymbolIndexUnit> units {};
+        Array<DWARFLineRow> lines {};
+        Array<u32> files {};
+        functions.reserve(function_count);
+        scopes.reserve(scope_count);
+        ranges.reserve(range_count);
+        units.reserve(session.units.size());
+        lines.reserve(line_count);
+        files.reserve(file_count);
+        // Names and files refer to interned ids until the string offsets are known
+        for(usize unit_index = 0; unit_index < session.units.size(); ++unit_index) {
+            const auto& unit = session.units[unit_index];
+            const auto scope_base = static_cast<u32>(scopes.size());
+            const auto range_base = static_cast<u32>(ranges.size());
+            const auto file_base = static_cast<u32>(files.size());
+            const auto get_file = [&unit, file_base](const usize file) -> u32 {
+                const auto index = unit.get_source_file_index(file);
+                return index != NO_INDEX ? file_base + index : NO_INDEX;
+            };
+            for(const auto& scope : unit.scopes) {
+                scopes.push_back({intern_scope_name(names, scope), scope.call_file != NO_INDEX ? get_file(scope.call_file) : NO_INDEX,
+                                  static_cast<u32>(scope.call_line), static_cast<u32>(scope.call_column), range_base + scope.first_range,
+                                  scope.range_count, scope_base + scope.subtree_end, 0});
+            }
+            for(const auto& range : unit.scope_ranges) {
+                ranges.push_back({range.low, range.high, scope_base + range.index});
+            }
+            for(const auto& function : unit.functions) {
+                functions.push_back({function.low, function.high, scope_base + function.index, static_cast<u32>(unit_index)});
+            }
+            units.push_back({static_cast<u32>(lines.size()), static_cast<u32>(unit.lines.size())});
+            for(const auto& row : unit.lines) {
+                lines.push_back({row.address, get_file(row.file), row.line, row.column, row.is_end_sequence});
+            }
+            for(const auto& file : unit.source_files) {
+                files.push_back(names.intern(file).get_id());
+            }
+        }
+        std::sort(functions.begin(), functions.end(), [](const SymbolIndexFunction& lhs, const SymbolIndexFunction& rhs) {
+            return lhs.low < rhs.low;
+        });
 
-        while(unw_step(&cursor) > 0) {
-            if(index == depth - 1) {
-                break;// If we reached the maximum specified depth, stop
+        // Lay out the strings in id order, the empty string comes first
+        Array<u32> offsets(names.size(), 0);
+        usize string_size = 0;
+        for(u32 id = 0; id < names.size(); ++id) {
+            offsets[id] = static_cast<u32>(string_size);
+            string_size += names.resolve(id).length() + 1;
+            if(string_size >= NO_INDEX) {
+                return false;
             }
-            if(index < static_cast<usize>(min<isize>(0, static_cast<isize>(skip) - 1))) {
-                ++index;
+        }
+        Array<char> strings(string_size, '\0');
+        for(u32 id = 0; id < names.size(); ++id) {
+            const auto name = names.resolve(id);
+            memcpy(strings.data() + offsets[id], name.data(), name.length());
+        }
+        for(auto& scope : scopes) {
+            scope.name = offsets[scope.name];
+        }
+        for(auto& file : files) {
+            file = offsets[file];
+        }
+
+        SymbolIndexHeader header {};
+        header.magic = SYMBOL_INDEX_MAGIC;
+        header.version = SYMBOL_INDEX_VERSION;
+        header.build_id_size = static_cast<u32>(build_id.size);
+        memcpy(header.build_id, build_id.data.data(), build_id.size);
+        header.function_count = static_cast<u32>(functions.size());
+        header.scope_count = static_cast<u32>(scopes.size());
+        header.range_count = static_cast<u32>(ranges.size());
+        header.unit_count = static_cast<u32>(units.size());
+        header.line_count = static_cast<u32>(lines.size());
+        header.file_count = static_cast<u32>(files.size());
+        header.string_size = string_size;
+        const SymbolIndexLayout layout(header);
+        header.file_size = layout.size;
+
+        String temporary_path(path);
+        temporary_path += ".XXXXXX";
+        const auto fd = mkstemp(temporary_path.data());
+        if(fd < 0) {
+            return false;
+        }
+        usize position = 0;
+        auto result = fchmod(fd, 0644) == 0 && write_section(fd, position, 0, &header, sizeof(header)) &&
+                      write_section(fd, position, layout.functions, functions.data(), functions.size() * sizeof(SymbolIndexFunction)) &&
+                      write_section(fd, position, layout.scopes, scopes.data(), scopes.size() * sizeof(SymbolIndexScope)) &&
+                      write_section(fd, position, layout.ranges, ranges.data(), ranges.size() * sizeof(DWARFAddressRange)) &&
+                      write_section(fd, position, layout.units, units.data(), units.size() * sizeof(SymbolIndexUnit)) &&
+                      write_section(fd, position, layout.lines, lines.data(), lines.size() * sizeof(DWARFLineRow)) &&
+                      write_section(fd, position, layout.files, files.data(), files.size() * sizeof(u32)) &&
+                      write_section(fd, position, layout.strings, strings.data(), string_size);
+        result = close(fd) == 0 && result;
+        if(!result || rename(temporary_path.c_str(), path.c_str()) != 0) {
+            unlink(temporary_path.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @return $KSTD_SYMBOL_INDEX_DIR, or an empty path which disables the index if it is not set.
+     */
+    [[nodiscard]] inline auto get_default_index_directory() noexcept -> String {
+        const auto* path = getenv("KSTD_SYMBOL_INDEX_DIR");
+        return path != nullptr ? String(path) : String();
+    }
+
+    /**
+     * Creates the given directory and all of its parents.
+     *
+     * @return True if the directory exists and is writable afterwards.
+     */
+    [[nodiscard]] inline auto create_directories(const String& path) noexcept -> bool {
+        String current(path);
+        for(usize i = 1; i < current.size(); ++i) {
+            if(current[i] != '/') {
                 continue;
             }
-            void* ip;
-            if(unw_get_reg(&cursor, UNW_REG_IP, reinterpret_cast<unw_word_t*>(&ip)) != UNW_ESUCCESS || ip == nullptr) {
-                stack_frames.emplace_back();
-                ++index;
-                continue;
+            current[i] = '\0';
+            mkdir(current.c_str(), 0755);// Fails for existing directories, which is fine
+            current[i] = '/';
+        }
+        mkdir(current.c_str(), 0755);
+        return access(current.c_str(), W_OK) == 0;
+    }
+
+    [[nodiscard]] inline auto get_index_path(const String& directory, const BuildId& build_id) noexcept -> String {
+        constexpr char digits[] = "0123456789abcdef";
+        String result(directory);
+        result += '/';
+        for(usize i = 0; i < build_id.size; ++i) {
+            result += digits[build_id.data[i] >> 4];
+            result += digits[build_id.data[i] & 0xF];
+        }
+        result += ".idx";
+        return result;
+    }
+
+    /**
+     * A process-wide cache of opened DWARF sessions keyed by binary path.
+     * libdwarf objects are not thread-safe, so every lookup runs under the cache lock.
+     * Sessions are dropped whenever a shared object was unloaded since the last check,
+     * since its path may be reused by a different binary.
+     *
+     * If an index directory is set, binaries with a build-id are indexed as a whole on their first
+     * lookup and the index is persisted there, so later processes map it without opening the DWARF object.
+     */
+    class DWARFSessionCache final {
+        std::mutex _mutex;
+        Array<DWARFSession*> _sessions;
+        Atomic<u64> _unload_count;
+        String _index_directory;
+
+        [[nodiscard]] static auto get_unload_count() noexcept -> u64 {
+            u64 count = 0;
+            dl_iterate_phdr(
+                [](dl_phdr_info* info, const usize size, void* data) -> int {
+                    if(size >= offsetof(dl_phdr_info, dlpi_subs) + sizeof(info->dlpi_subs)) {
+                        *static_cast<u64*>(data) = info->dlpi_subs;
+                    }
+                    return 1;// The counter is the same for every entry, stop after the first one
+                },
+                &count);
+            return count;
+        }
+
+        auto clear() noexcept -> void {
+            for(auto* session : _sessions) {
+                delete session;
             }
-            unw_word_t offset;
-            if(unw_get_proc_name(&cursor, name_buffer.data(), MAX_NAME_SIZE, &offset) != UNW_ESUCCESS) {
-                stack_frames.emplace_back();
-                ++index;
-                continue;
+            _sessions.clear();
+        }
+
+        /**
+         * @param address An address inside of the binary, to locate its build-id.
+         */
+        [[nodiscard]] auto get_session(const StringView& binary, const void* address) noexcept -> DWARFSession* {
+            for(auto* session : _sessions) {
+                if(session->binary == binary) {
+                    return session;
+                }
+            }
+            auto* session = new DWARFSession(binary, nullptr);
+            _sessions.push_back(session);// Remember binaries without debug information as well
+            BuildId build_id {};
+            String index_path {};
+            if(!_index_directory.is_empty() && get_build_id(address, build_id)) {
+                index_path = get_index_path(_index_directory, build_id);
+                if(session->index.map(index_path.c_str(), build_id)) {
+                    return session;
+                }
+            }
+            if(dwarf_init_path(binary.data(), nullptr, 0, DW_GROUPNUMBER_ANY, 0, nullptr, nullptr, &session->object, nullptr, 0,
+                               nullptr, nullptr) != DW_DLV_OK) {
+                session->object = nullptr;
+                return session;
+            }
+            session->load_units();
+            if(!index_path.is_empty() && create_directories(_index_directory) && write_symbol_index(*session, index_path, build_id) &&
+               session->index.map(index_path.c_str(), build_id)) {
+                session->close_object();
+            }
+            return session;
+        }
+
+    public:
+        DWARFSessionCache() noexcept
+            : _unload_count(get_unload_count())
+            , _index_directory(get_default_index_directory()) {
+        }
+
+        KSTD_NO_MOVE_COPY(DWARFSessionCache, DWARFSessionCache)
+
+        ~DWARFSessionCache() noexcept {
+            clear();
+        }
+
+        /**
+         * Drops all sessions if any shared object was closed since the last call.
+         * Only takes the lock if the unload counter changed.
+         *
+         * @return True if the sessions were dropped by this call.
+         */
+        auto invalidate_unloaded() noexcept -> bool {
+            const auto unload_count = get_unload_count();
+            if(unload_count == _unload_count.load(std::memory_order_acquire)) {
+                return false;
+            }
+            const std::lock_guard guard(_mutex);
+            if(unload_count == _unload_count.load(std::memory_order_relaxed)) {
+                return false;// Another thread dropped the sessions in the meantime
+            }
+            clear();
+            _unload_count.store(unload_count, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * Sets the directory of persisted indices, an empty path disables them. All sessions are
+         * dropped, so every binary is opened with the new directory on its next lookup.
+         */
+        auto set_index_directory(const StringView& path) noexcept -> void {
+            const std::lock_guard guard(_mutex);
+            _index_directory = String(path);
+            clear();
+        }
+
+        /**
+         * Invokes the given function with the session of the given binary while holding the cache lock.
+         * The function is not invoked if the binary has no debug information.
+         */
+        template<typename TFunction>
+        auto with_session(const StringView& binary, const void* address, TFunction&& function) noexcept -> void {
+            const std::lock_guard guard(_mutex);
+            auto* session = get_session(binary, address);
+            if(session->object != nullptr || session->index.is_mapped()) {
+                function(*session);
+            }
+        }
+    };
+
+    [[nodiscard]] inline auto get_session_cache() noexcept -> DWARFSessionCache& {
+        static DWARFSessionCache cache {};
+        return cache;
+    }
+
+    /**
+     * Resolves the elements of the given address without consulting the symbol cache.
+     */
+    inline auto resolve_address(DWARFSessionCache& session_cache, void* address, Array<StackTraceElement>& elements) noexcept -> void {
+        // Return addresses point behind the call, look up the call instruction itself
+        const auto binary = get_binary(address);
+        const auto pc = static_cast<DWARFAddr>(reinterpret_cast<usize>(address) - binary.load_bias - 1);
+        auto found = false;
+        if(!binary.path.is_empty()) {
+            session_cache.with_session(binary.path, address, [&](DWARFSession& session) {
+                found = session.symbolize(address, pc, elements);
+            });
+        }
+        if(found) {
+            return;
+        }
+        // Fall back to the dynamic symbol table for binaries without debug information
+        Dl_info symbol_info;
+        StringView function_name {};
+        if(dladdr(address, &symbol_info) > 0 && symbol_info.dli_sname != nullptr) {
+            function_name = demangle(symbol_info.dli_sname);
+        }
+        elements.emplace_back(address, binary.path, StringView(), function_name, 0, 0);
+    }
+
+    auto StackTrace::set_symbol_index_directory(const StringView& path) noexcept -> void {
+        get_session_cache().set_index_directory(path);
+        get_symbol_cache().invalidate();// Cached addresses would never reach the new index
+    }
+
+    auto StackTrace::invalidate_symbols() noexcept -> void {
+        if(get_session_cache().invalidate_unloaded()) {
+            get_symbol_cache().invalidate();// Unloaded addresses may belong to a different binary now
+        }
+    }
+
+    auto StackTrace::symbolize_address(void* address, Array<StackTraceElement>& elements) noexcept -> void {
+        auto& session_cache = get_session_cache();
+        auto& symbol_cache = get_symbol_cache();
+        Slice<StackTraceElement> cached_elements {};
+        if(symbol_cache.find(address, cached_elements)) {
+            for(const auto& element : cached_elements) {
+                elements.push_back(element);
+            }
+            return;
+        }
+        const auto first_element = elements.size();
+        resolve_address(session_cache, address, elements);
+        symbol_cache.insert(address, {elements.data() + first_element, elements.size() - first_element});
+    }
+
+    /**
+     * The stack of the calling thread, which every frame pointer has to point into.
+     */
+    struct StackBounds final {
+        usize low;
+        usize high;
+    };
+
+    static Atomic<UnwindMode> unwind_mode {UnwindMode::LIBUNWIND};
+    static thread_local StackBounds stack_bounds {0, 0};
+
+    /**
+     * Looks up the stack bounds of the calling thread once. This is not async-signal-safe, since
+     * glibc parses /proc/self/maps for the main thread, so capture never calls it.
+     */
+    inline auto init_stack_bounds() noexcept -> void {
+        if(stack_bounds.high != 0) {
+            return;
+        }
+#ifdef KSTD_PLATFORM_MACOS
+        const auto high = reinterpret_cast<usize>(pthread_get_stackaddr_np(pthread_self()));
+        stack_bounds = {high - pthread_get_stacksize_np(pthread_self()), high};
+#else
+        pthread_attr_t attributes;
+        if(pthread_getattr_np(pthread_self(), &attributes) == 0) {
+            void* address = nullptr;
+            usize size = 0;
+            if(pthread_attr_getstack(&attributes, &address, &size) == 0) {
+                stack_bounds = {reinterpret_cast<usize>(address), reinterpret_cast<usize>(address) + size};
+            }
+            pthread_attr_destroy(&attributes);
+        }
+#endif
+    }
+
+    /**
+     * Follows the chain of saved frame pointers, where every frame starts with the previous
+     * frame pointer followed by the return address. The first entry is the return address into
+     * the caller, like unw_backtrace does. Stops at the first pointer which leaves the stack of
+     * the calling thread or doesn't move towards its base, whose bounds have to be initialized.
+     *
+     * @param frame The frame address of the caller, taking it there makes sure the caller
+     * keeps a frame pointer even if the library is built without them.
+     */
+    [[gnu::noinline]] static auto walk_frame_pointers(void** buffer, const usize capacity, usize frame) noexcept -> usize {
+        if(capacity == 0) {
+            return 0;
+        }
+        const auto& bounds = stack_bounds;
+        buffer[0] = __builtin_return_address(0);
+        usize count = 1;
+        while(count < capacity) {
+            if(frame < bounds.low || frame + 2 * sizeof(void*) > bounds.high || (frame & (sizeof(void*) - 1)) != 0) {
+                break;
+            }
+            auto* const* slots = reinterpret_cast<void* const*>(frame);
+            if(slots[1] == nullptr) {
+                break;
+            }
+            buffer[count++] = slots[1];
+            const auto next = reinterpret_cast<usize>(slots[0]);
+            if(next <= frame) {
+                break;
             }
+            frame = next;
+        }
+        return count;
+    }
+
+    auto StackTrace::set_unwind_mode(const UnwindMode mode) noexcept -> void {
+        unwind_mode.store(mode, std::memory_order_relaxed);
+    }
+
+    auto StackTrace::get_unwind_mode() noexcept -> UnwindMode {
+        return unwind_mode.load(std::memory_order_relaxed);
+    }
 
-            const String mangled_name(name_buffer.data());
-            auto function_name = demangle(mangled_name);
-            auto binary = get_binary(ip);
-            auto source_info = get_source_info(binary, mangled_name);
-            stack_frames.emplace_back(ip, kstd::move(binary), get<0>(source_info), kstd::move(function_name), get<1>(source_info),
-                                      get<2>(source_info));
-            ++index;
+    // Inlined into its caller so the first captured address belongs to that function, with and without frame pointers
+    [[gnu::always_inline]] inline static auto capture_addresses(void** buffer, const usize capacity, const usize skip, const usize frame) noexcept -> usize {
+        const auto capture_depth = min(capacity + skip, StackTrace::max_depth);
+        if(capacity == 0 || skip >= capture_depth) {
+            return 0;
+        }
+        FixedArray<void*, StackTrace::max_depth> addresses {};
+        usize count = 0;
+        // Threads which were never prepared fall back to the unwind tables, their stack bounds are unknown
+        if(StackTrace::get_unwind_mode() == UnwindMode::FRAME_POINTER && stack_bounds.high != 0) {
+            count = walk_frame_pointers(addresses.data(), capture_depth, frame);
+        }
+        else {
+            count = static_cast<usize>(max(unw_backtrace(addresses.data(), static_cast<int>(capture_depth)), 0));
         }
+        if(count <= skip) {
+            return 0;
+        }
+        count -= skip;
+        memcpy(buffer, addresses.data() + skip, count * sizeof(void*));
+        return count;
+    }
 
-        return StackTrace(move(stack_frames));
+    auto StackTrace::prepare_thread() noexcept -> void {
+        init_stack_bounds();
+        // Run the unwinder once, so its lazy initialization never happens in a signal handler
+        FixedArray<void*, 8> addresses {};
+        static_cast<void>(unw_backtrace(addresses.data(), static_cast<int>(addresses.size())));
+    }
+
+    auto StackTrace::capture(void** buffer, const usize capacity, const usize skip) noexcept -> usize {
+        return capture_addresses(buffer, capacity, skip + 1, reinterpret_cast<usize>(__builtin_frame_address(0)));
+    }
+
+    auto StackTrace::get_current(const usize depth, const usize skip) noexcept -> StackTrace {
+        init_stack_bounds();
+        StackTrace trace {};
+        trace._depth = capture_addresses(trace._addresses.data(), min(depth, max_depth), skip, reinterpret_cast<usize>(__builtin_frame_address(0)));
+        return trace;
     }
 }// namespace kstd
 
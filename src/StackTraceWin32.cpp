@@ -19,6 +19,8 @@
 #include <DbgHelp.h>
 
 #include "kstd/Atomic.hpp"
+#include "kstd/Math.hpp"
+#include "kstd/SymbolCache.hpp"
 
 namespace kstd {
     static atomic_bool initialized {false};
@@ -86,63 +88,102 @@ namespace kstd {
         return initialized = true;
     }
 
-    auto StackTrace::get_current(const usize depth, const usize skip) noexcept -> StackTrace {
+    auto StackTrace::invalidate_symbols() noexcept -> void {
+        // Module unloads are not tracked on Windows, so cached addresses are never dropped
+    }
+
+    auto StackTrace::symbolize_address(void* address, Array<StackTraceElement>& elements) noexcept -> void {
+        auto& symbol_cache = get_symbol_cache();
+        Slice<StackTraceElement> cached_elements {};
+        if(symbol_cache.find(address, cached_elements)) {
+            for(const auto& element : cached_elements) {
+                elements.push_back(element);
+            }
+            return;
+        }
         if(!ensure_init()) {
-            return StackTrace {};
+            return;
         }
 
-        Array<void*> backtrace(depth, nullptr);
-        const auto num_frames = static_cast<usize>(CaptureStackBackTrace(static_cast<ULONG>(skip), static_cast<DWORD>(depth), backtrace.data(), nullptr));
+        const auto offset = reinterpret_cast<usize>(address);
+
+        String name;
 
-        Array<StackTraceElement> stack_frames(num_frames);
+        ULONG name_size;
+        auto result = debug_symbols->GetNameByOffset(offset, nullptr, 0, &name_size, nullptr);
+        if(SUCCEEDED(result)) {
+            name.resize(name_size);
 
-        for(usize i = 0; i < num_frames; i++) {
-            const auto address = reinterpret_cast<usize>(backtrace[i]);
+            result = debug_symbols->GetNameByOffset(offset, name.data(), name_size, nullptr, nullptr);
+            if(FAILED(result)) {
+                name = "";
+            }
+        }
 
-            String name;
+        String file;
+        ULONG file_size;
+        ULONG line = 0;
 
-            ULONG name_size;
-            auto result = debug_symbols->GetNameByOffset(address, nullptr, 0, &name_size, nullptr);
-            if(SUCCEEDED(result)) {
-                name.resize(name_size);
+        result = debug_symbols->GetLineByOffset(offset, nullptr, nullptr, 0, &file_size, nullptr);
+        if(SUCCEEDED(result)) {
+            file.resize(file_size);
 
-                result = debug_symbols->GetNameByOffset(address, name.data(), name_size, nullptr, nullptr);
-                if(FAILED(result)) {
-                    name = "";
-                }
+            result = debug_symbols->GetLineByOffset(offset, &line, file.data(), file_size, nullptr, nullptr);
+            if(FAILED(result)) {
+                file = "";
+                line = 0;
             }
+        }
 
-            String file;
-            ULONG file_size;
-            ULONG line = 0;
+        String binary;
+        String function_name;
 
-            result = debug_symbols->GetLineByOffset(address, nullptr, nullptr, 0, &file_size, nullptr);
-            if(SUCCEEDED(result)) {
-                file.resize(file_size);
+        const auto delim_index = name.find('!');
+        if(delim_index == String::npos) {
+            function_name = kstd::move(name);
+        }
+        else {
+            binary = name.substr(0, delim_index);
+            function_name = name.substr(delim_index + 1);
+        }
 
-                result = debug_symbols->GetLineByOffset(address, &line, file.data(), file_size, nullptr, nullptr);
-                if(FAILED(result)) {
-                    file = "";
-                    line = 0;
-                }
-            }
+        const StackTraceElement element(address, symbol_cache.intern(binary), symbol_cache.intern(file),
+                                        symbol_cache.intern(function_name), line, 0);
+        elements.push_back(element);
+        symbol_cache.insert(address, {&element, 1});
+    }
 
-            String binary;
-            String function_name;
+    static Atomic<UnwindMode> unwind_mode {UnwindMode::LIBUNWIND};
 
-            const auto delim_index = name.find_first_of('!');
-            if(delim_index == String::npos) {
-                function_name = kstd::move(name);
-            }
-            else {
-                binary = name.substr(0, delim_index);
-                function_name = name.substr(delim_index + 1);
-            }
+    auto StackTrace::set_unwind_mode(const UnwindMode mode) noexcept -> void {
+        unwind_mode.store(mode, std::memory_order_relaxed);// CaptureStackBackTrace is used either way
+    }
+
+    auto StackTrace::get_unwind_mode() noexcept -> UnwindMode {
+        return unwind_mode.load(std::memory_order_relaxed);
+    }
 
-            stack_frames[i] = StackTraceElement {backtrace[i], binary, file, function_name, line, 0};
+    auto StackTrace::set_symbol_index_directory([[maybe_unused]] const StringView& path) noexcept -> void {
+        // DbgHelp keeps its own symbol cache, there is no index to persist
+    }
+
+    auto StackTrace::prepare_thread() noexcept -> void {
+        // CaptureStackBackTrace needs no per-thread state
+    }
+
+    auto StackTrace::capture(void** buffer, const usize capacity, const usize skip) noexcept -> usize {
+        const auto capture_depth = min(capacity, max_depth);
+        if(capture_depth == 0) {
+            return 0;
         }
+        // Leave out this function as well
+        return static_cast<usize>(CaptureStackBackTrace(static_cast<ULONG>(skip + 1), static_cast<DWORD>(capture_depth), buffer, nullptr));
+    }
 
-        return StackTrace {kstd::move(stack_frames)};
+    auto StackTrace::get_current(const usize depth, const usize skip) noexcept -> StackTrace {
+        StackTrace trace {};
+        trace._depth = capture(trace._addresses.data(), min(depth, max_depth), skip);
+        return trace;
     }
 
 }// namespace kstd
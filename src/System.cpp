@@ -0,0 +1,249 @@
+// Copyright 2024 Karma Krafts & associates
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "kstd/System.hpp"
+
+#include "kstd/Bits.hpp"
+#include "kstd/CPU.hpp"
+
+// NOLINTBEGIN
+#if defined(KSTD_CPU_X86_FAMILY)
+#include <immintrin.h>
+#endif
+// NOLINTEND
+
+#ifdef KSTD_COMPILER_MSVC
+#define KSTD_TARGET(x)
+#define KSTD_NO_SANITIZE_ADDRESS
+#else
+#define KSTD_TARGET(x) __attribute__((target(x)))
+#define KSTD_NO_SANITIZE_ADDRESS __attribute__((no_sanitize_address))
+#endif
+
+namespace kstd::system {
+    namespace {
+        template<typename T>
+        using LengthKernel = usize (*)(const T*) noexcept;
+
+        template<typename T>
+        using CompareKernel = i32 (*)(const T*, const T*) noexcept;
+
+        // Loads never cross into the next page, which is what makes reading past the terminator safe
+        constexpr usize page_size = 4096;
+
+        template<typename T>
+        [[nodiscard]] auto compare_units(const T lhs, const T rhs) noexcept -> i32 {
+            return lhs < rhs ? -1 : (lhs > rhs ? 1 : 0);
+        }
+
+        template<typename T>
+        [[nodiscard]] auto get_length_scalar(const T* str) noexcept -> usize {
+            const auto* ptr = str;
+            while(*ptr != 0) {
+                ++ptr;
+            }
+            return static_cast<usize>(ptr - str);
+        }
+
+        template<typename T>
+        [[nodiscard]] auto compare_scalar(const T* lhs, const T* rhs) noexcept -> i32 {
+            while(*lhs != 0 && *lhs == *rhs) {
+                ++lhs;
+                ++rhs;
+            }
+            return compare_units(*lhs, *rhs);
+        }
+
+#if defined(KSTD_CPU_X86_FAMILY)
+        template<typename T>
+        KSTD_TARGET("sse2")
+        [[nodiscard]] inline auto compare_equal_sse2(const __m128i lhs, const __m128i rhs) noexcept -> __m128i {
+            if constexpr(sizeof(T) == 2) {
+                return _mm_cmpeq_epi16(lhs, rhs);
+            }
+            else {
+                return _mm_cmpeq_epi32(lhs, rhs);
+            }
+        }
+
+        template<typename T>
+        KSTD_TARGET("avx2")
+        [[nodiscard]] inline auto compare_equal_avx2(const __m256i lhs, const __m256i rhs) noexcept -> __m256i {
+            if constexpr(sizeof(T) == 2) {
+                return _mm256_cmpeq_epi16(lhs, rhs);
+            }
+            else {
+                return _mm256_cmpeq_epi32(lhs, rhs);
+            }
+        }
+
+        /**
+         * Scans aligned blocks, so no load ever touches a page the string does not reach into.
+         * Lanes in front of the string in the first block are masked out.
+         */
+        template<typename T>
+        KSTD_TARGET("sse2")
+        KSTD_NO_SANITIZE_ADDRESS [[nodiscard]] auto get_length_sse2(const T* str) noexcept -> usize {
+            constexpr usize vector_size = sizeof(__m128i);
+            const auto address = reinterpret_cast<usize>(str);
+            if((address & (sizeof(T) - 1)) != 0) {
+                return get_length_scalar(str);
+            }
+            const auto zero = _mm_setzero_si128();
+            const auto* block = reinterpret_cast<const __m128i*>(address & ~(vector_size - 1));
+            auto mask = static_cast<u32>(_mm_movemask_epi8(compare_equal_sse2<T>(_mm_load_si128(block), zero)));
+            mask &= ~u32 {0} << (address & (vector_size - 1));
+            while(mask == 0) {
+                ++block;
+                mask = static_cast<u32>(_mm_movemask_epi8(compare_equal_sse2<T>(_mm_load_si128(block), zero)));
+            }
+            const auto end = reinterpret_cast<usize>(block) + bits::count_trailing_zeros(mask);
+            return (end - address) / sizeof(T);
+        }
+
+        template<typename T>
+        KSTD_TARGET("avx2")
+        KSTD_NO_SANITIZE_ADDRESS [[nodiscard]] auto get_length_avx2(const T* str) noexcept -> usize {
+            constexpr usize vector_size = sizeof(__m256i);
+            const auto address = reinterpret_cast<usize>(str);
+            if((address & (sizeof(T) - 1)) != 0) {
+                return get_length_scalar(str);
+            }
+            const auto zero = _mm256_setzero_si256();
+            const auto* block = reinterpret_cast<const __m256i*>(address & ~(vector_size - 1));
+            auto mask = static_cast<u32>(_mm256_movemask_epi8(compare_equal_avx2<T>(_mm256_load_si256(block), zero)));
+            mask &= ~u32 {0} << (address & (vector_size - 1));
+            while(mask == 0) {
+                ++block;
+                mask = static_cast<u32>(_mm256_movemask_epi8(compare_equal_avx2<T>(_mm256_load_si256(block), zero)));
+            }
+            const auto end = reinterpret_cast<usize>(block) + bits::count_trailing_zeros(mask);
+            return (end - address) / sizeof(T);
+        }
+
+        template<usize TVectorSize>
+        [[nodiscard]] inline auto is_near_page_end(const void* address) noexcept -> bool {
+            return (reinterpret_cast<usize>(address) & (page_size - 1)) > page_size - TVectorSize;
+        }
+
+        /**
+         * Compares a vector of units at a time. Close to the end of a page either string
+         * might end, so those units are compared one by one until both pointers passed it.
+         */
+        template<typename T>
+        KSTD_TARGET("sse2")
+        KSTD_NO_SANITIZE_ADDRESS [[nodiscard]] auto compare_sse2(const T* lhs, const T* rhs) noexcept -> i32 {
+            constexpr usize vector_size = sizeof(__m128i);
+            const auto zero = _mm_setzero_si128();
+            while(true) {
+                if(is_near_page_end<vector_size>(lhs) || is_near_page_end<vector_size>(rhs)) {
+                    if(*lhs == 0 || *lhs != *rhs) {
+                        return compare_units(*lhs, *rhs);
+                    }
+                    ++lhs;
+                    ++rhs;
+                    continue;
+                }
+                const auto lhs_vector = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs));
+                const auto rhs_vector = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs));
+                const auto equal_mask = static_cast<u32>(_mm_movemask_epi8(compare_equal_sse2<T>(lhs_vector, rhs_vector)));
+                const auto zero_mask = static_cast<u32>(_mm_movemask_epi8(compare_equal_sse2<T>(lhs_vector, zero)));
+                const auto stop_mask = (~equal_mask & 0xFFFF) | zero_mask;
+                if(stop_mask != 0) {
+                    const auto index = bits::count_trailing_zeros(stop_mask) / sizeof(T);
+                    return compare_units(lhs[index], rhs[index]);
+                }
+                lhs += vector_size / sizeof(T);
+                rhs += vector_size / sizeof(T);
+            }
+        }
+
+        template<typename T>
+        KSTD_TARGET("avx2")
+        KSTD_NO_SANITIZE_ADDRESS [[nodiscard]] auto compare_avx2(const T* lhs, const T* rhs) noexcept -> i32 {
+            constexpr usize vector_size = sizeof(__m256i);
+            const auto zero = _mm256_setzero_si256();
+            while(true) {
+                if(is_near_page_end<vector_size>(lhs) || is_near_page_end<vector_size>(rhs)) {
+                    if(*lhs == 0 || *lhs != *rhs) {
+                        return compare_units(*lhs, *rhs);
+                    }
+                    ++lhs;
+                    ++rhs;
+                    continue;
+                }
+                const auto lhs_vector = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs));
+                const auto rhs_vector = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs));
+                const auto equal_mask = static_cast<u32>(_mm256_movemask_epi8(compare_equal_avx2<T>(lhs_vector, rhs_vector)));
+                const auto zero_mask = static_cast<u32>(_mm256_movemask_epi8(compare_equal_avx2<T>(lhs_vector, zero)));
+                const auto stop_mask = ~equal_mask | zero_mask;
+                if(stop_mask != 0) {
+                    const auto index = bits::count_trailing_zeros(stop_mask) / sizeof(T);
+                    return compare_units(lhs[index], rhs[index]);
+                }
+                lhs += vector_size / sizeof(T);
+                rhs += vector_size / sizeof(T);
+            }
+        }
+#endif
+
+        template<typename T>
+        [[nodiscard]] auto select_length_kernel() noexcept -> LengthKernel<T> {
+#if defined(KSTD_CPU_X86_FAMILY)
+            const auto& features = cpu::get_features();
+            if(features.has_avx2) {
+                return &get_length_avx2<T>;
+            }
+            if(features.has_sse2) {
+                return &get_length_sse2<T>;
+            }
+#endif
+            return &get_length_scalar<T>;
+        }
+
+        template<typename T>
+        [[nodiscard]] auto select_compare_kernel() noexcept -> CompareKernel<T> {
+#if defined(KSTD_CPU_X86_FAMILY)
+            const auto& features = cpu::get_features();
+            if(features.has_avx2) {
+                return &compare_avx2<T>;
+            }
+            if(features.has_sse2) {
+                return &compare_sse2<T>;
+            }
+#endif
+            return &compare_scalar<T>;
+        }
+    }// namespace
+
+    auto get_wide_string_length(const u16* str) noexcept -> usize {
+        static const auto kernel = select_length_kernel<u16>();
+        return kernel(str);
+    }
+
+    auto get_wide_string_length(const u32* str) noexcept -> usize {
+        static const auto kernel = select_length_kernel<u32>();
+        return kernel(str);
+    }
+
+    auto compare_wide_string(const u16* lhs, const u16* rhs) noexcept -> i32 {
+        static const auto kernel = select_compare_kernel<u16>();
+        return kernel(lhs, rhs);
+    }
+
+    auto compare_wide_string(const u32* lhs, const u32* rhs) noexcept -> i32 {
+        static const auto kernel = select_compare_kernel<u32>();
+        return kernel(lhs, rhs);
+    }
+}// namespace kstd::system
\ No newline at end of file
@@ -0,0 +1,480 @@
+// Copyright 2024 Karma Krafts & associates
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "kstd/Unicode.hpp"
+
+#include "kstd/Bits.hpp"
+#include "kstd/CPU.hpp"
+
+// NOLINTBEGIN
+#if defined(KSTD_CPU_X86_FAMILY)
+#include <immintrin.h>
+#endif
+// NOLINTEND
+
+#ifdef KSTD_COMPILER_MSVC
+#define KSTD_TARGET(x)
+#else
+#define KSTD_TARGET(x) __attribute__((target(x)))
+#endif
+
+namespace kstd::unicode::simd {
+    namespace {
+        using ValidateKernel = bool (*)(const u8*, usize) noexcept;
+        using CountKernel = usize (*)(const u8*, usize) noexcept;
+
+        template<typename T>
+        using WidenKernel = usize (*)(const u8*, usize, T*) noexcept;
+
+        template<typename T>
+        using NarrowKernel = usize (*)(const T*, usize, u8*) noexcept;
+
+        [[nodiscard]] auto is_valid_utf8_scalar(const u8* data, const usize size) noexcept -> bool {
+            usize index = 0;
+            while(index < size) {
+                if(data[index] < 0x80) {
+                    ++index;
+                    continue;
+                }
+                char32_t value = 0;
+                const auto length = decode_utf8(data + index, size - index, value);
+                if(length == 0) {
+                    return false;
+                }
+                index += length;
+            }
+            return true;
+        }
+
+        [[nodiscard]] auto count_utf8_code_points_scalar(const u8* data, const usize size) noexcept -> usize {
+            usize count = 0;
+            for(usize index = 0; index < size; ++index) {
+                count += (data[index] & 0xC0) != 0x80 ? 1 : 0;
+            }
+            return count;
+        }
+
+        template<typename T>
+        auto widen_ascii_scalar(const u8* src, const usize size, T* dst) noexcept -> usize {
+            usize index = 0;
+            for(; index < size && src[index] < 0x80; ++index) {
+                dst[index] = src[index];
+            }
+            return index;
+        }
+
+        template<typename T>
+        auto narrow_ascii_scalar(const T* src, const usize size, u8* dst) noexcept -> usize {
+            usize index = 0;
+            for(; index < size && src[index] < 0x80; ++index) {
+                dst[index] = static_cast<u8>(src[index]);
+            }
+            return index;
+        }
+
+#if defined(KSTD_CPU_X86_FAMILY)
+        // Every byte is classified by a three-way table lookup over its own high nibble and the nibbles of its
+        // predecessor, which flags all invalid two-byte combinations at once; 3- and 4-byte sequences are then
+        // checked by matching the expected continuation positions against the lookup result.
+        constexpr u8 too_short = 1 << 0;        // 11______ 0_______
+        constexpr u8 too_long = 1 << 1;         // 0_______ 10______
+        constexpr u8 overlong_3 = 1 << 2;       // 11100000 100_____
+        constexpr u8 too_large = 1 << 3;        // 11110100 1001____ and above
+        constexpr u8 surrogate = 1 << 4;        // 11101101 101_____
+        constexpr u8 overlong_2 = 1 << 5;       // 1100000_ 10______
+        constexpr u8 too_large_1000 = 1 << 6;   // 11110101 1000____ and above
+        constexpr u8 overlong_4 = 1 << 6;       // 11110000 1000____
+        constexpr u8 two_continuations = 1 << 7;// 10______ 10______
+        constexpr u8 carry = too_short | too_long | two_continuations;
+
+        // clang-format off
+        alignas(16) constexpr u8 byte_1_high_table[16] = {
+            too_long, too_long, too_long, too_long,
+            too_long, too_long, too_long, too_long,
+            two_continuations, two_continuations, two_continuations, two_continuations,
+            too_short | overlong_2,
+            too_short,
+            too_short | overlong_3 | surrogate,
+            too_short | too_large | too_large_1000 | overlong_4};
+
+        alignas(16) constexpr u8 byte_1_low_table[16] = {
+            carry | overlong_3 | overlong_2 | overlong_4,
+            carry | overlong_2,
+            carry, carry,
+            carry | too_large,
+            carry | too_large | too_large_1000, carry | too_large | too_large_1000, carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000, carry | too_large | too_large_1000, carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000, carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000 | surrogate,
+            carry | too_large | too_large_1000, carry | too_large | too_large_1000};
+
+        alignas(16) constexpr u8 byte_2_high_table[16] = {
+            too_short, too_short, too_short, too_short,
+            too_short, too_short, too_short, too_short,
+            too_long | overlong_2 | two_continuations | overlong_3 | too_large_1000 | overlong_4,
+            too_long | overlong_2 | two_continuations | overlong_3 | too_large,
+            too_long | overlong_2 | two_continuations | surrogate | too_large,
+            too_long | overlong_2 | two_continuations | surrogate | too_large,
+            too_short, too_short, too_short, too_short};
+
+        // A lead byte this close to the end of a block needs continuations from the next block,
+        // the 128-bit kernel uses the last 16 limits
+        alignas(32) constexpr u8 incomplete_limits[32] = {
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF0 - 1, 0xE0 - 1, 0xC0 - 1};
+        // clang-format on
+
+        [[nodiscard]] inline auto load_table(const u8* table) noexcept -> __m128i {
+            return _mm_load_si128(reinterpret_cast<const __m128i*>(table));
+        }
+
+        template<int TCount>
+        KSTD_TARGET("ssse3")
+        [[nodiscard]] inline auto get_previous_ssse3(const __m128i input, const __m128i previous) noexcept -> __m128i {
+            return _mm_alignr_epi8(input, previous, 16 - TCount);
+        }
+
+        template<int TCount>
+        KSTD_TARGET("avx2")
+        [[nodiscard]] inline auto get_previous_avx2(const __m256i input, const __m256i previous) noexcept -> __m256i {
+            return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(previous, input, 0x21), 16 - TCount);
+        }
+
+        /**
+         * @return A vector which is non-zero in every lane that starts an invalid byte combination.
+         */
+        KSTD_TARGET("ssse3")
+        [[nodiscard]] inline auto check_block_ssse3(const __m128i input, const __m128i previous) noexcept -> __m128i {
+            const auto nibble_mask = _mm_set1_epi8(0x0F);
+            const auto previous_1 = get_previous_ssse3<1>(input, previous);
+            const auto byte_1_high = _mm_shuffle_epi8(load_table(byte_1_high_table), _mm_and_si128(_mm_srli_epi16(previous_1, 4), nibble_mask));
+            const auto byte_1_low = _mm_shuffle_epi8(load_table(byte_1_low_table), _mm_and_si128(previous_1, nibble_mask));
+            const auto byte_2_high = _mm_shuffle_epi8(load_table(byte_2_high_table), _mm_and_si128(_mm_srli_epi16(input, 4), nibble_mask));
+            const auto special_cases = _mm_and_si128(_mm_and_si128(byte_1_high, byte_1_low), byte_2_high);
+            // Bytes 2 and 3 positions after a 3- or 4-byte lead must be continuations
+            const auto is_third_byte = _mm_subs_epu8(get_previous_ssse3<2>(input, previous), _mm_set1_epi8(0xE0 - 0x80));
+            const auto is_fourth_byte = _mm_subs_epu8(get_previous_ssse3<3>(input, previous), _mm_set1_epi8(0xF0 - 0x80));
+            const auto must_be_continuation = _mm_and_si128(_mm_or_si128(is_third_byte, is_fourth_byte), _mm_set1_epi8(static_cast<char>(0x80)));
+            return _mm_xor_si128(must_be_continuation, special_cases);
+        }
+
+        KSTD_TARGET("avx2")
+        [[nodiscard]] inline auto check_block_avx2(const __m256i input, const __m256i previous) noexcept -> __m256i {
+            const auto nibble_mask = _mm256_set1_epi8(0x0F);
+            const auto previous_1 = get_previous_avx2<1>(input, previous);
+            const auto byte_1_high = _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(load_table(byte_1_high_table)),
+                                                         _mm256_and_si256(_mm256_srli_epi16(previous_1, 4), nibble_mask));
+            const auto byte_1_low = _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(load_table(byte_1_low_table)),
+                                                        _mm256_and_si256(previous_1, nibble_mask));
+            const auto byte_2_high = _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(load_table(byte_2_high_table)),
+                                                         _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble_mask));
+            const auto special_cases = _mm256_and_si256(_mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+            const auto is_third_byte = _mm256_subs_epu8(get_previous_avx2<2>(input, previous), _mm256_set1_epi8(0xE0 - 0x80));
+            const auto is_fourth_byte = _mm256_subs_epu8(get_previous_avx2<3>(input, previous), _mm256_set1_epi8(0xF0 - 0x80));
+            const auto must_be_continuation =
+                _mm256_and_si256(_mm256_or_si256(is_third_byte, is_fourth_byte), _mm256_set1_epi8(static_cast<char>(0x80)));
+            return _mm256_xor_si256(must_be_continuation, special_cases);
+        }
+
+        /**
+         * Checks pure ASCII blocks only for a sequence left open by the previous block. The tail is padded
+         * with ASCII zeros, which also flags any sequence truncated by the end of the input.
+         */
+        KSTD_TARGET("ssse3")
+        [[nodiscard]] auto is_valid_utf8_ssse3(const u8* data, const usize size) noexcept -> bool {
+            constexpr usize vector_size = sizeof(__m128i);
+            const auto limits = load_table(incomplete_limits + 16);
+            auto error = _mm_setzero_si128();
+            auto previous = _mm_setzero_si128();
+            auto previous_incomplete = _mm_setzero_si128();
+            usize index = 0;
+            for(; index + vector_size <= size; index += vector_size) {
+                const auto input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + index));
+                if(_mm_movemask_epi8(input) == 0) {
+                    error = _mm_or_si128(error, previous_incomplete);
+                }
+                else {
+                    error = _mm_or_si128(error, check_block_ssse3(input, previous));
+                    previous_incomplete = _mm_subs_epu8(input, limits);
+                }
+                previous = input;
+            }
+            alignas(__m128i) u8 tail[vector_size] {};
+            for(usize i = 0; index + i < size; ++i) {
+                tail[i] = data[index + i];
+            }
+            error = _mm_or_si128(error, check_block_ssse3(load_table(tail), previous));
+            return _mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) == 0xFFFF;
+        }
+
+        KSTD_TARGET("avx2")
+        [[nodiscard]] auto is_valid_utf8_avx2(const u8* data, const usize size) noexcept -> bool {
+            constexpr usize vector_size = sizeof(__m256i);
+            const auto limits = _mm256_load_si256(reinterpret_cast<const __m256i*>(incomplete_limits));
+            auto error = _mm256_setzero_si256();
+            auto previous = _mm256_setzero_si256();
+            auto previous_incomplete = _mm256_setzero_si256();
+            usize index = 0;
+            for(; index + vector_size <= size; index += vector_size) {
+                const auto input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + index));
+                if(_mm256_movemask_epi8(input) == 0) {
+                    error = _mm256_or_si256(error, previous_incomplete);
+                }
+                else {
+                    error = _mm256_or_si256(error, check_block_avx2(input, previous));
+                    previous_incomplete = _mm256_subs_epu8(input, limits);
+                }
+                previous = input;
+            }
+            alignas(__m256i) u8 tail[vector_size] {};
+            for(usize i = 0; index + i < size; ++i) {
+                tail[i] = data[index + i];
+            }
+            error = _mm256_or_si256(error, check_block_avx2(_mm256_load_si256(reinterpret_cast<const __m256i*>(tail)), previous));
+            return _mm256_testz_si256(error, error) != 0;
+        }
+
+        // Continuation bytes are 0x80 to 0xBF, which is everything below -64 when signed
+        KSTD_TARGET("sse2")
+        [[nodiscard]] auto count_utf8_code_points_sse2(const u8* data, const usize size) noexcept -> usize {
+            constexpr usize vector_size = sizeof(__m128i);
+            const auto threshold = _mm_set1_epi8(-65);
+            usize count = 0;
+            usize index = 0;
+            for(; index + vector_size <= size; index += vector_size) {
+                const auto input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + index));
+                count += bits::count_ones(static_cast<u32>(_mm_movemask_epi8(_mm_cmpgt_epi8(input, threshold))));
+            }
+            return count + count_utf8_code_points_scalar(data + index, size - index);
+        }
+
+        KSTD_TARGET("avx2")
+        [[nodiscard]] auto count_utf8_code_points_avx2(const u8* data, const usize size) noexcept -> usize {
+            constexpr usize vector_size = sizeof(__m256i);
+            const auto threshold = _mm256_set1_epi8(-65);
+            usize count = 0;
+            usize index = 0;
+            for(; index + vector_size <= size; index += vector_size) {
+                const auto input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + index));
+                count += bits::count_ones(static_cast<u32>(_mm256_movemask_epi8(_mm256_cmpgt_epi8(input, threshold))));
+            }
+            return count + count_utf8_code_points_scalar(data + index, size - index);
+        }
+
+        template<typename T>
+        KSTD_TARGET("sse2")
+        auto widen_ascii_sse2(const u8* src, const usize size, T* dst) noexcept -> usize {
+            constexpr usize vector_size = sizeof(__m128i);
+            const auto zero = _mm_setzero_si128();
+            usize index = 0;
+            for(; index + vector_size <= size; index += vector_size) {
+                const auto input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + index));
+                if(_mm_movemask_epi8(input) != 0) {
+                    break;
+                }
+                auto* block = reinterpret_cast<__m128i*>(dst + index);
+                const auto low = _mm_unpacklo_epi8(input, zero);
+                const auto high = _mm_unpackhi_epi8(input, zero);
+                if constexpr(sizeof(T) == 2) {
+                    _mm_storeu_si128(block, low);
+                    _mm_storeu_si128(block + 1, high);
+                }
+                else {
+                    _mm_storeu_si128(block, _mm_unpacklo_epi16(low, zero));
+                    _mm_storeu_si128(block + 1, _mm_unpackhi_epi16(low, zero));
+                    _mm_storeu_si128(block + 2, _mm_unpacklo_epi16(high, zero));
+                    _mm_storeu_si128(block + 3, _mm_unpackhi_epi16(high, zero));
+                }
+            }
+            return index + widen_ascii_scalar(src + index, size - index, dst + index);
+        }
+
+        template<typename T>
+        KSTD_TARGET("avx2")
+        auto widen_ascii_avx2(const u8* src, const usize size, T* dst) noexcept -> usize {
+            constexpr usize vector_size = sizeof(__m256i);
+            usize index = 0;
+            for(; index + vector_size <= size; index += vector_size) {
+                const auto input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + index));
+                if(_mm256_movemask_epi8(input) != 0) {
+                    break;
+                }
+                auto* block = reinterpret_cast<__m256i*>(dst + index);
+                const auto low = _mm256_castsi256_si128(input);
+                const auto high = _mm256_extracti128_si256(input, 1);
+                if constexpr(sizeof(T) == 2) {
+                    _mm256_storeu_si256(block, _mm256_cvtepu8_epi16(low));
+                    _mm256_storeu_si256(block + 1, _mm256_cvtepu8_epi16(high));
+                }
+                else {
+                    _mm256_storeu_si256(block, _mm256_cvtepu8_epi32(low));
+                    _mm256_storeu_si256(block + 1, _mm256_cvtepu8_epi32(_mm_srli_si128(low, 8)));
+                    _mm256_storeu_si256(block + 2, _mm256_cvtepu8_epi32(high));
+                    _mm256_storeu_si256(block + 3, _mm256_cvtepu8_epi32(_mm_srli_si128(high, 8)));
+                }
+            }
+            return index + widen_ascii_scalar(src + index, size - index, dst + index);
+        }
+
+        /**
+         * Narrows a vector of output bytes at a time. Every unit is checked to be ASCII before packing,
+         * so the saturating packs never clamp.
+         */
+        template<typename T>
+        KSTD_TARGET("sse2")
+        auto narrow_ascii_sse2(const T* src, const usize size, u8* dst) noexcept -> usize {
+            constexpr usize vector_size = sizeof(__m128i);
+            const auto zero = _mm_setzero_si128();
+            const auto non_ascii = sizeof(T) == 2 ? _mm_set1_epi16(static_cast<i16>(0xFF80)) : _mm_set1_epi32(static_cast<i32>(0xFFFFFF80));
+            usize index = 0;
+            for(; index + vector_size <= size; index += vector_size) {
+                const auto* block = reinterpret_cast<const __m128i*>(src + index);
+                __m128i units[sizeof(T)];
+                auto combined = zero;
+                for(usize i = 0; i < sizeof(T); ++i) {
+                    units[i] = _mm_loadu_si128(block + i);
+                    combined = _mm_or_si128(combined, units[i]);
+                }
+                if(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(combined, non_ascii), zero)) != 0xFFFF) {
+                    break;
+                }
+                if constexpr(sizeof(T) == 2) {
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + index), _mm_packus_epi16(units[0], units[1]));
+                }
+                else {
+                    const auto low = _mm_packs_epi32(units[0], units[1]);
+                    const auto high = _mm_packs_epi32(units[2], units[3]);
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + index), _mm_packus_epi16(low, high));
+                }
+            }
+            return index + narrow_ascii_scalar(src + index, size - index, dst + index);
+        }
+
+        template<typename T>
+        KSTD_TARGET("avx2")
+        auto narrow_ascii_avx2(const T* src, const usize size, u8* dst) noexcept -> usize {
+            constexpr usize vector_size = sizeof(__m256i);
+            const auto non_ascii = sizeof(T) == 2 ? _mm256_set1_epi16(static_cast<i16>(0xFF80)) : _mm256_set1_epi32(static_cast<i32>(0xFFFFFF80));
+            usize index = 0;
+            for(; index + vector_size <= size; index += vector_size) {
+                const auto* block = reinterpret_cast<const __m256i*>(src + index);
+                __m256i units[sizeof(T)];
+                auto combined = _mm256_setzero_si256();
+                for(usize i = 0; i < sizeof(T); ++i) {
+                    units[i] = _mm256_loadu_si256(block + i);
+                    combined = _mm256_or_si256(combined, units[i]);
+                }
+                if(_mm256_testz_si256(combined, non_ascii) == 0) {
+                    break;
+                }
+                // The packs work within 128-bit lanes, so the 64- or 32-bit groups are put back in order afterwards
+                __m256i result;
+                if constexpr(sizeof(T) == 2) {
+                    result = _mm256_permute4x64_epi64(_mm256_packus_epi16(units[0], units[1]), 0xD8);
+                }
+                else {
+                    const auto low = _mm256_packs_epi32(units[0], units[1]);
+                    const auto high = _mm256_packs_epi32(units[2], units[3]);
+                    result = _mm256_permutevar8x32_epi32(_mm256_packus_epi16(low, high), _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+                }
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + index), result);
+            }
+            return index + narrow_ascii_scalar(src + index, size - index, dst + index);
+        }
+#endif
+
+        [[nodiscard]] auto select_validate_kernel() noexcept -> ValidateKernel {
+#if defined(KSTD_CPU_X86_FAMILY)
+            const auto& features = cpu::get_features();
+            if(features.has_avx2) {
+                return &is_valid_utf8_avx2;
+            }
+            if(features.has_ssse3) {
+                return &is_valid_utf8_ssse3;
+            }
+#endif
+            return &is_valid_utf8_scalar;
+        }
+
+        [[nodiscard]] auto select_count_kernel() noexcept -> CountKernel {
+#if defined(KSTD_CPU_X86_FAMILY)
+            const auto& features = cpu::get_features();
+            if(features.has_avx2) {
+                return &count_utf8_code_points_avx2;
+            }
+            if(features.has_sse2) {
+                return &count_utf8_code_points_sse2;
+            }
+#endif
+            return &count_utf8_code_points_scalar;
+        }
+
+        template<typename T>
+        [[nodiscard]] auto select_widen_kernel() noexcept -> WidenKernel<T> {
+#if defined(KSTD_CPU_X86_FAMILY)
+            const auto& features = cpu::get_features();
+            if(features.has_avx2) {
+                return &widen_ascii_avx2<T>;
+            }
+            if(features.has_sse2) {
+                return &widen_ascii_sse2<T>;
+            }
+#endif
+            return &widen_ascii_scalar<T>;
+        }
+
+        template<typename T>
+        [[nodiscard]] auto select_narrow_kernel() noexcept -> NarrowKernel<T> {
+#if defined(KSTD_CPU_X86_FAMILY)
+            const auto& features = cpu::get_features();
+            if(features.has_avx2) {
+                return &narrow_ascii_avx2<T>;
+            }
+            if(features.has_sse2) {
+                return &narrow_ascii_sse2<T>;
+            }
+#endif
+            return &narrow_ascii_scalar<T>;
+        }
+    }// namespace
+
+    auto is_valid_utf8(const u8* data, const usize size) noexcept -> bool {
+        static const auto kernel = select_validate_kernel();
+        return kernel(data, size);
+    }
+
+    auto count_utf8_code_points(const u8* data, const usize size) noexcept -> usize {
+        static const auto kernel = select_count_kernel();
+        return kernel(data, size);
+    }
+
+    auto widen_ascii(const u8* src, const usize size, u16* dst) noexcept -> usize {
+        static const auto kernel = select_widen_kernel<u16>();
+        return kernel(src, size, dst);
+    }
+
+    auto widen_ascii(const u8* src, const usize size, u32* dst) noexcept -> usize {
+        static const auto kernel = select_widen_kernel<u32>();
+        return kernel(src, size, dst);
+    }
+
+    auto narrow_ascii(const u16* src, const usize size, u8* dst) noexcept -> usize {
+        static const auto kernel = select_narrow_kernel<u16>();
+        return kernel(src, size, dst);
+    }
+
+    auto narrow_ascii(const u32* src, const usize size, u8* dst) noexcept -> usize {
+        static const auto kernel = select_narrow_kernel<u32>();
+        return kernel(src, size, dst);
+    }
+}// namespace kstd::unicode::simd
\ No newline at end of file
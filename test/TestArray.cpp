@@ -99,4 +99,53 @@ TEST(kstd_Array, insert_all_end) {
     values.insert_all(7, 7, 8, 9);
 
     ASSERT_EQ(values, array_of(0, 1, 2, 3, 4, 5, 6, 7, 8, 9));
+}
+
+TEST(kstd_Array, clear) {
+    using namespace kstd;
+
+    auto values = array_of(0, 1, 2, 3);
+    const auto capacity = values.capacity();
+    values.clear();
+
+    ASSERT_EQ(values.size(), 0);
+    ASSERT_EQ(values.capacity(), capacity);
+    values.push_back(4);
+    ASSERT_EQ(values, array_of(4));
+}
+
+TEST(kstd_Array, resize_uninitialized) {
+    using namespace kstd;
+
+    auto values = array_of(0, 1, 2);
+    values.resize_uninitialized(16);
+    ASSERT_EQ(values.size(), 16);
+    ASSERT_GE(values.capacity(), 16);
+    values.resize_uninitialized(3);
+    ASSERT_EQ(values, array_of(0, 1, 2));
+}
+
+TEST(kstd_Array, reserve_amortized) {
+    using namespace kstd;
+
+    Array<i32> values(4);
+    values.reserve_amortized(5);
+    ASSERT_GE(values.capacity(), 8);
+    const auto capacity = values.capacity();
+    values.reserve_amortized(capacity);
+    ASSERT_EQ(values.capacity(), capacity);
+    values.reserve_amortized(capacity * 3);
+    ASSERT_EQ(values.capacity(), capacity * 3);
+}
+
+TEST(kstd_Array, default_does_not_allocate) {
+    using namespace kstd;
+
+    Array<i32> values {};
+    ASSERT_EQ(values.data(), nullptr);
+    ASSERT_EQ(values.capacity(), 0);
+    const auto copy = values;
+    ASSERT_EQ(copy.data(), nullptr);
+    values.push_back(1);
+    ASSERT_EQ(values, array_of(1));
 }
\ No newline at end of file
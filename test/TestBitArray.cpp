@@ -0,0 +1,164 @@
+// Copyright 2024 Karma Krafts & associates
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <kstd/BitArray.hpp>
+#include <kstd/FixedBitArray.hpp>
+
+TEST(kstd_BitArray, set_reset_test) {
+    using namespace kstd;
+
+    BitArray values(200);
+    ASSERT_EQ(values.size(), 200);
+    ASSERT_TRUE(values.none());
+
+    values.set(3);
+    values.set(64);
+    values.set(199);
+    ASSERT_TRUE(values.test(3));
+    ASSERT_TRUE(values.test(64));
+    ASSERT_TRUE(values.test(199));
+    ASSERT_FALSE(values.test(4));
+    ASSERT_EQ(values.count(), 3);
+
+    values.reset(64);
+    ASSERT_FALSE(values.test(64));
+    ASSERT_EQ(values.count(), 2);
+}
+
+TEST(kstd_BitArray, set_all) {
+    using namespace kstd;
+
+    BitArray values(130);
+    values.set_all();
+    ASSERT_EQ(values.count(), 130);
+    values.flip_all();
+    ASSERT_EQ(values.count(), 0);
+}
+
+TEST(kstd_BitArray, find_next_set) {
+    using namespace kstd;
+
+    BitArray values(300);
+    ASSERT_EQ(values.find_first_set(), 300);
+    values.set(70);
+    values.set(257);
+    ASSERT_EQ(values.find_first_set(), 70);
+    ASSERT_EQ(values.find_next_set(71), 257);
+    ASSERT_EQ(values.find_next_set(258), 300);
+}
+
+TEST(kstd_BitArray, get_set_bits) {
+    using namespace kstd;
+
+    BitArray values(1000);
+    for(usize i = 0; i < 1000; i += 7) {
+        values.set(i);
+    }
+    usize expected = 0;
+    for(const auto index : values.get_set_bits()) {
+        ASSERT_EQ(index, expected);
+        expected += 7;
+    }
+    ASSERT_EQ(expected, 1001);
+}
+
+TEST(kstd_BitArray, bulk_operations) {
+    using namespace kstd;
+
+    BitArray lhs(500);
+    BitArray rhs(500);
+    for(usize i = 0; i < 500; i += 2) {
+        lhs.set(i);
+    }
+    for(usize i = 0; i < 500; i += 3) {
+        rhs.set(i);
+    }
+
+    auto result = lhs;
+    result &= rhs;
+    ASSERT_EQ(result.count(), 84);// Multiples of 6
+
+    result = lhs;
+    result |= rhs;
+    ASSERT_EQ(result.count(), 250 + 167 - 84);
+
+    result = lhs;
+    result ^= rhs;
+    ASSERT_EQ(result.count(), 250 + 167 - 2 * 84);
+
+    result = lhs;
+    result.and_not(rhs);
+    ASSERT_EQ(result.count(), 250 - 84);
+
+    // Combining an array with itself aliases both operands
+    result = lhs;
+    result &= result;
+    ASSERT_EQ(result.count(), 250);
+    result ^= result;
+    ASSERT_EQ(result.count(), 0);
+}
+
+TEST(kstd_BitArray, push_back_resize) {
+    using namespace kstd;
+
+    BitArray values {};
+    for(usize i = 0; i < 100; ++i) {
+        values.push_back(i % 3 == 0);
+    }
+    ASSERT_EQ(values.size(), 100);
+    ASSERT_EQ(values.count(), 34);
+
+    values.resize(150, true);
+    ASSERT_EQ(values.count(), 84);
+    values.resize(10);
+    ASSERT_EQ(values.count(), 4);
+}
+
+TEST(kstd_FixedBitArray, set_reset_test) {
+    using namespace kstd;
+
+    FixedBitArray<100> values {};
+    static_assert(decltype(values)::word_count == 2);
+    values.set(0);
+    values.set(99);
+    ASSERT_TRUE(values.test(0));
+    ASSERT_TRUE(values.test(99));
+    ASSERT_EQ(values.count(), 2);
+    ASSERT_EQ(values.find_next_set(1), 99);
+
+    values.set_all();
+    ASSERT_EQ(values.count(), 100);
+    values.reset_all();
+    ASSERT_TRUE(values.none());
+}
+
+TEST(kstd_FixedBitArray, bulk_operations) {
+    using namespace kstd;
+
+    FixedBitArray<256> lhs {};
+    FixedBitArray<256> rhs {};
+    lhs.set(1);
+    lhs.set(200);
+    rhs.set(200);
+    rhs.set(255);
+
+    auto result = lhs;
+    result &= rhs;
+    ASSERT_EQ(result.count(), 1);
+    ASSERT_EQ(result.find_first_set(), 200);
+
+    result = lhs;
+    result |= rhs;
+    ASSERT_EQ(result.count(), 3);
+}
@@ -0,0 +1,150 @@
+// Copyright 2024 Karma Krafts & associates
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+
+#include <gtest/gtest.h>
+#include <kstd/Bytes.hpp>
+
+using namespace kstd;
+
+/**
+ * Hands out memory at a different byte offset every time, like a byte allocator may.
+ */
+struct MisalignedAllocator final {
+    using value_type = u8;
+
+    static inline u8 next_shift = 0;
+
+    [[nodiscard]] auto allocate(const usize count) noexcept -> u8* {
+        const auto shift = next_shift;
+        next_shift = static_cast<u8>((next_shift + 3) % 8);
+        auto* memory = static_cast<u8*>(malloc(count + 8)) + 1 + shift;
+        memory[-1] = shift;
+        return memory;
+    }
+
+    [[nodiscard]] auto reallocate(u8* memory, const usize old_count, const usize count) noexcept -> u8* {
+        auto* result = allocate(count);
+        memcpy(result, memory, min(old_count, count));
+        memset(memory, 0xCD, old_count);// Poison the old block so stale reads show up
+        free(memory);
+        return result;
+    }
+
+    auto free(u8* memory) noexcept -> void {
+        ::free(memory - 1 - memory[-1]);
+    }
+};
+
+TEST(kstd_Bytes, test_copy_from) {
+    const auto bytes = Bytes::copy_from("Hello, World!"_str);
+    ASSERT_EQ(bytes.size(), 13);
+    ASSERT_EQ(bytes.get_ref_count(), 1);
+    ASSERT_EQ(bytes.as_string_view(), "Hello, World!"_str);
+    ASSERT_EQ(bytes[4], 'o');
+}
+
+TEST(kstd_Bytes, test_share) {
+    auto bytes = Bytes::copy_from("Hello, World!"_str);
+    {
+        const auto copy = bytes;
+        ASSERT_EQ(copy.data(), bytes.data());
+        ASSERT_EQ(bytes.get_ref_count(), 2);
+    }
+    ASSERT_EQ(bytes.get_ref_count(), 1);
+    auto moved = move(bytes);
+    ASSERT_TRUE(bytes.is_empty());// NOLINT
+    ASSERT_EQ(moved.get_ref_count(), 1);
+}
+
+TEST(kstd_Bytes, test_slice) {
+    auto bytes = Bytes::copy_from("Hello, World!"_str);
+    const auto world = bytes.slice(7, 12);
+    ASSERT_EQ(world.as_string_view(), "World"_str);
+    ASSERT_EQ(world.data(), bytes.data() + 7);
+    ASSERT_EQ(bytes.get_ref_count(), 2);
+    const auto orl = world.slice(1, 4);
+    ASSERT_EQ(orl.as_string_view(), "orl"_str);
+    ASSERT_EQ(bytes.get_ref_count(), 3);
+    bytes = Bytes();
+    ASSERT_EQ(orl.get_ref_count(), 2);
+    ASSERT_EQ(world.slice(5).size(), 0);
+}
+
+TEST(kstd_Bytes, test_from_static) {
+    const auto bytes = Bytes::from_static("static"_str);
+    ASSERT_EQ(bytes.get_ref_count(), 0);
+    ASSERT_EQ(bytes.slice(1, 3).as_string_view(), "ta"_str);
+    ASSERT_EQ(bytes, Bytes::copy_from("static"_str));
+}
+
+TEST(kstd_Bytes, test_bytes_mut) {
+    BytesMut buffer {};
+    for(usize i = 0; i < 1000; ++i) {
+        buffer.push_back(static_cast<u8>(i));
+    }
+    buffer.append("tail"_str);
+    ASSERT_EQ(buffer.size(), 1004);
+    ASSERT_GE(buffer.capacity(), 1004);
+
+    const auto* data = buffer.data();
+    const auto bytes = buffer.freeze();
+    ASSERT_TRUE(buffer.is_empty());
+    ASSERT_EQ(buffer.capacity(), 0);
+    ASSERT_EQ(bytes.data(), data);
+    ASSERT_EQ(bytes.size(), 1004);
+    ASSERT_EQ(bytes[999], static_cast<u8>(999));
+    ASSERT_EQ(bytes.slice(1000).as_string_view(), "tail"_str);
+}
+
+TEST(kstd_Bytes, test_acquire_commit) {
+    BytesMut buffer(16);
+    auto* data = buffer.acquire(3);
+    data[0] = 'a';
+    data[1] = 'b';
+    buffer.commit(2);
+    ASSERT_EQ(buffer.as_string_view(), "ab"_str);
+    const auto bytes = buffer.freeze();
+    const Slice<u8> slice = bytes;
+    ASSERT_EQ(slice.size(), 2);
+    ASSERT_EQ(slice[1], 'b');
+}
+
+TEST(kstd_Bytes, test_misaligned_allocator) {
+    BasicBytesMut<MisalignedAllocator> buffer {};
+    for(usize i = 0; i < 1000; ++i) {
+        buffer.push_back(static_cast<u8>(i));
+        // The payload follows the header, so it is aligned exactly when the header is
+        ASSERT_EQ(reinterpret_cast<usize>(buffer.data()) % alignof(usize), 0);
+    }
+    const auto bytes = buffer.freeze();
+    const auto copy = bytes;
+    ASSERT_EQ(bytes.get_ref_count(), 2);
+    for(usize i = 0; i < 1000; ++i) {
+        ASSERT_EQ(copy[i], static_cast<u8>(i));
+    }
+}
+
+TEST(kstd_Bytes, test_append_self) {
+    BasicBytesMut<MisalignedAllocator> buffer(64);
+    for(usize i = 0; i < 64; ++i) {
+        buffer.push_back(static_cast<u8>(i));
+    }
+    buffer.append(buffer.data(), buffer.size());
+    ASSERT_EQ(buffer.size(), 128);
+    for(usize i = 0; i < 128; ++i) {
+        ASSERT_EQ(buffer.data()[i], static_cast<u8>(i % 64));
+    }
+}
\ No newline at end of file
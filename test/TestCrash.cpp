@@ -0,0 +1,77 @@
+// Copyright 2024 Karma Krafts & associates
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+
+#ifdef KSTD_PLATFORM_UNIX
+
+#include <gtest/gtest.h>
+#include <kstd/Crash.hpp>
+#include <kstd/String.hpp>
+#include <kstd/StringView.hpp>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace kstd;
+
+static auto read_all(const int fd) -> String {
+    String result {};
+    char buffer[256];
+    ssize_t count;
+    while((count = read(fd, buffer, sizeof(buffer))) > 0) {
+        result += StringView(buffer, static_cast<usize>(count));
+    }
+    return result;
+}
+
+TEST(kstd_Crash, write_report) {
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    ASSERT_TRUE(crash::install(fds[1]));
+    crash::write_report("Test report");
+    crash::uninstall();
+    close(fds[1]);
+
+    const auto report = read_all(fds[0]);
+    close(fds[0]);
+    const StringView view(report.data(), report.size());
+    ASSERT_NE(view.find("*** kstd crash report ***"_str), StringView::npos);
+    ASSERT_NE(view.find("reason: Test report"_str), StringView::npos);
+    ASSERT_NE(view.find("*** end of crash report ***"_str), StringView::npos);
+}
+
+TEST(kstd_Crash, segmentation_fault) {
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    const auto pid = fork();
+    ASSERT_GE(pid, 0);
+    if(pid == 0) {
+        close(fds[0]);
+        crash::install(fds[1]);
+        raise(SIGSEGV);
+        _exit(0);
+    }
+    close(fds[1]);
+    const auto report = read_all(fds[0]);
+    close(fds[0]);
+    int status = 0;
+    ASSERT_EQ(waitpid(pid, &status, 0), pid);
+    ASSERT_TRUE(WIFSIGNALED(status));
+    ASSERT_EQ(WTERMSIG(status), SIGSEGV);
+    const StringView view(report.data(), report.size());
+    ASSERT_NE(view.find("reason: SIGSEGV"_str), StringView::npos);
+}
+
+#endif//KSTD_PLATFORM_UNIX
\ No newline at end of file
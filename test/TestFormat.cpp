@@ -0,0 +1,79 @@
+// Copyright 2024 Karma Krafts & associates
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+
+#include <gtest/gtest.h>
+#include <kstd/Format.hpp>
+
+using namespace kstd;
+
+TEST(kstd_Format, test_format_to_array) {
+    Array<char> buffer {};
+    ASSERT_EQ(format_to(buffer, "Hello {}!", 42), 9);
+    ASSERT_EQ(format_to(buffer, " {:>4}", "ab"), 5);
+    ASSERT_EQ(StringView(buffer.data(), buffer.size()), "Hello 42!   ab"_str);
+}
+
+TEST(kstd_Format, test_format_to_string) {
+    String value("Value: ");
+    format_to(value, "{:.3f}", 3.14159);
+    ASSERT_EQ(value, "Value: 3.142"_str);
+    ASSERT_EQ(value.size(), 12);
+}
+
+TEST(kstd_Format, test_format_large) {
+    String value {};
+    for(usize i = 0; i < 1000; ++i) {
+        format_to(value, "{},", i);
+    }
+    ASSERT_EQ(value.size(), 3890);
+    ASSERT_EQ(StringView(value.data(), 6), "0,1,2,"_str);
+}
+
+TEST(kstd_Format, test_format_into_builder) {
+    StringBuilder builder {};
+    String expected {};
+    for(usize i = 0; i < 200; ++i) {
+        ASSERT_EQ(format_into(builder, "{:08x}|", i), 9);
+        format_to(expected, "{:08x}|", i);
+    }
+    ASSERT_EQ(builder.length(), 1800);
+    ASSERT_EQ(builder.flatten(), expected);
+}
+
+TEST(kstd_Format, test_format_strings) {
+    const auto view = "view"_str;
+    const String string("string");
+    ASSERT_EQ(format("{} {:>8}", view, string), "view   string"_str);
+}
+
+TEST(kstd_Format, test_format_sequences) {
+    const auto array = array_of<i32>(1, 2, 3);
+    ASSERT_EQ(format("{}", array), "[1, 2, 3]"_str);
+    ASSERT_EQ(format("{:02}", Slice<const i32>(array.data(), 2)), "[01, 02]"_str);
+    ASSERT_EQ(format("{}", Array<i32>()), "[]"_str);
+}
+
+TEST(kstd_Format, test_format_source_location) {
+    const SourceLocation location("Test.cpp", "test", 12, 4);
+    ASSERT_EQ(format("{}", location), "Test.cpp:12:4"_str);
+}
+
+TEST(kstd_Format, test_format_stack_trace_element) {
+    const StackTraceElement element(nullptr, "libtest.so"_str, "Test.cpp"_str, "main"_str, 3, 1);
+    ASSERT_EQ(format("{}", element), "0x0 in main at Test.cpp:3:1"_str);
+    const StackTraceElement unresolved(nullptr, "libtest.so"_str, StringView(), StringView(), 0, 0);
+    ASSERT_EQ(format("{}", unresolved), "0x0 in ?? from libtest.so"_str);
+}
\ No newline at end of file
@@ -0,0 +1,165 @@
+// Copyright 2024 Karma Krafts & associates
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <gtest/gtest.h>
+#include <kstd/Interner.hpp>
+
+// NOLINTBEGIN
+#include <thread>
+#include <vector>
+// NOLINTEND
+
+using namespace kstd;
+
+/**
+ * Hands out memory at a different byte offset every time, like a byte allocator may.
+ */
+struct MisalignedAllocator final {
+    using value_type = u8;
+
+    static inline u8 next_shift = 0;
+
+    [[nodiscard]] auto allocate(const usize count) noexcept -> u8* {
+        const auto shift = next_shift;
+        next_shift = static_cast<u8>((next_shift + 3) % 8);
+        auto* memory = static_cast<u8*>(malloc(count + 8)) + 1 + shift;
+        memory[-1] = shift;
+        return memory;
+    }
+
+    [[nodiscard]] auto reallocate(u8* memory, const usize old_count, const usize count) noexcept -> u8* {
+        auto* result = allocate(count);
+        memcpy(result, memory, min(old_count, count));
+        free(memory);
+        return result;
+    }
+
+    auto free(u8* memory) noexcept -> void {
+        ::free(memory - 1 - memory[-1]);
+    }
+};
+
+TEST(kstd_Interner, test_hash) {
+    constexpr auto hash = hash_elements("Hello, World!", 13);
+    static_assert(hash == hash_elements("Hello, World!", 13));
+    ASSERT_EQ(hash, hash_elements("Hello, World!", 13));
+    ASSERT_NE(hash, hash_elements("Hello, World?", 13));
+    ASSERT_NE(hash_elements("a", 1), hash_elements("a", 1, 1));
+    ASSERT_NE(hash_elements("0123456789abcdef0", 17), hash_elements("0123456789abcdef1", 17));
+}
+
+TEST(kstd_Interner, test_intern) {
+    Interner interner {};
+    const auto foo = interner.intern("foo"_str);
+    const auto bar = interner.intern("bar"_str);
+    const auto foo2 = interner.intern(StringView("foobar", 3));
+
+    ASSERT_EQ(foo, foo2);
+    ASSERT_NE(foo, bar);
+    ASSERT_EQ(foo.data(), foo2.data());
+    ASSERT_EQ(foo.length(), 3);
+    ASSERT_STREQ(foo.c_str(), "foo");
+    ASSERT_EQ(foo.get_hash(), hash_elements("foo", 3));
+    ASSERT_EQ(interner.size(), 3);
+    ASSERT_EQ(interner.resolve(foo.get_id()), foo);
+    ASSERT_EQ(interner.resolve(bar.get_id()), bar);
+}
+
+TEST(kstd_Interner, test_empty) {
+    Interner interner {};
+    const auto empty = interner.intern(""_str);
+    ASSERT_EQ(empty, InternedString());
+    ASSERT_EQ(empty.get_id(), 0);
+    ASSERT_TRUE(empty.is_empty());
+    ASSERT_EQ(interner.resolve(0), empty);
+}
+
+TEST(kstd_Interner, test_find) {
+    Interner interner {};
+    InternedString result {};
+    ASSERT_FALSE(interner.find("foo"_str, result));
+    const auto foo = interner.intern("foo"_str);
+    ASSERT_TRUE(interner.find("foo"_str, result));
+    ASSERT_EQ(result, foo);
+}
+
+TEST(kstd_Interner, test_many) {
+    Interner interner {};
+    char buffer[32];
+    for(usize i = 0; i < 10000; ++i) {
+        const auto length = static_cast<usize>(snprintf(buffer, sizeof(buffer), "name_%zu", i));
+        const auto value = interner.intern(StringView(buffer, length));
+        ASSERT_EQ(value.get_id(), i + 1);
+    }
+    ASSERT_EQ(interner.size(), 10001);
+    for(usize i = 0; i < 10000; ++i) {
+        const auto length = static_cast<usize>(snprintf(buffer, sizeof(buffer), "name_%zu", i));
+        const auto value = interner.intern(StringView(buffer, length));
+        ASSERT_EQ(value.get_id(), i + 1);
+        ASSERT_EQ(interner.resolve(value.get_id()), value);
+    }
+}
+
+TEST(kstd_Interner, test_large) {
+    Interner interner {};
+    const auto small = interner.intern("small"_str);
+    char large[Interner::chunk_size];
+    for(usize i = 0; i < sizeof(large); ++i) {
+        large[i] = static_cast<char>('a' + (i % 26));
+    }
+    const auto value = interner.intern(StringView(large, sizeof(large)));
+    ASSERT_EQ(value.length(), sizeof(large));
+    ASSERT_EQ(memcmp(value.data(), large, sizeof(large)), 0);
+    ASSERT_EQ(interner.intern("small"_str), small);
+}
+
+TEST(kstd_Interner, test_misaligned_allocator) {
+    BasicInterner<false, MisalignedAllocator> interner {};
+    char buffer[32];
+    for(usize i = 0; i < 10000; ++i) {
+        const auto length = static_cast<usize>(snprintf(buffer, sizeof(buffer), "name_%zu", i));
+        const auto value = interner.intern(StringView(buffer, length));
+        ASSERT_EQ(reinterpret_cast<usize>(value.data()) % alignof(InternedEntry), 0);
+        ASSERT_EQ(value.get_id(), i + 1);
+    }
+    char large[decltype(interner)::chunk_size];
+    memset(large, 'x', sizeof(large));
+    const auto value = interner.intern(StringView(large, sizeof(large)));
+    ASSERT_EQ(reinterpret_cast<usize>(value.data()) % alignof(InternedEntry), 0);
+    ASSERT_EQ(interner.intern("name_42"_str).get_id(), 43);
+}
+
+TEST(kstd_Interner, test_concurrent) {
+    ConcurrentInterner interner {};
+    constexpr usize thread_count = 4;
+    constexpr usize string_count = 2000;
+    std::vector<std::vector<u32>> ids(thread_count);
+    std::vector<std::thread> threads {};
+    for(usize i = 0; i < thread_count; ++i) {
+        threads.emplace_back([&interner, &ids, i] {
+            char buffer[32];
+            for(usize j = 0; j < string_count; ++j) {
+                const auto length = static_cast<usize>(snprintf(buffer, sizeof(buffer), "key_%zu", j));
+                ids[i].push_back(interner.intern(StringView(buffer, length)).get_id());
+            }
+        });
+    }
+    for(auto& thread : threads) {
+        thread.join();
+    }
+    ASSERT_EQ(interner.size(), string_count + 1);
+    for(usize i = 1; i < thread_count; ++i) {
+        ASSERT_EQ(ids[i], ids[0]);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,115 @@
+// Copyright 2024 Karma Krafts & associates
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <kstd/Array.hpp>
+#include <kstd/FixedMdArray.hpp>
+#include <kstd/MdSlice.hpp>
+
+namespace {
+    auto make_extents(const kstd::usize rows, const kstd::usize columns) noexcept -> kstd::FixedArray<kstd::usize, 2> {
+        kstd::FixedArray<kstd::usize, 2> extents {};
+        extents.insert_all(rows, columns);
+        return extents;
+    }
+}// namespace
+
+TEST(kstd_MdSlice, row_major) {
+    using namespace kstd;
+
+    Array<i32> values(12, 0);
+    for(usize i = 0; i < values.size(); ++i) {
+        values[i] = static_cast<i32>(i);
+    }
+    const MdSlice<i32, 2> view(values.data(), make_extents(3, 4));
+    ASSERT_EQ(view.size(), 12);
+    ASSERT_EQ(view(0, 0), 0);
+    ASSERT_EQ(view(1, 2), 6);
+    ASSERT_EQ(view(2, 3), 11);
+
+    const auto row = view.row(1);
+    ASSERT_EQ(row.size(), 4);
+    ASSERT_EQ(row[0], 4);
+    ASSERT_EQ(row[3], 7);
+}
+
+TEST(kstd_MdSlice, column_major) {
+    using namespace kstd;
+
+    Array<i32> values(12, 0);
+    for(usize i = 0; i < values.size(); ++i) {
+        values[i] = static_cast<i32>(i);
+    }
+    const MdSlice<i32, 2, ColumnMajor> view(values.data(), make_extents(3, 4));
+    ASSERT_EQ(view(1, 0), 1);
+    ASSERT_EQ(view(0, 1), 3);
+    ASSERT_EQ(view(2, 3), 11);
+}
+
+TEST(kstd_MdSlice, sub_view) {
+    using namespace kstd;
+
+    Array<i32> values(16, 0);
+    for(usize i = 0; i < values.size(); ++i) {
+        values[i] = static_cast<i32>(i);
+    }
+    const MdSlice<i32, 2> view(values.data(), make_extents(4, 4));
+    const auto sub_view = view.sub_view(make_extents(1, 1), make_extents(2, 2));
+    ASSERT_EQ(sub_view.size(), 4);
+    ASSERT_EQ(sub_view(0, 0), 5);
+    ASSERT_EQ(sub_view(0, 1), 6);
+    ASSERT_EQ(sub_view(1, 0), 9);
+    ASSERT_EQ(sub_view(1, 1), 10);
+
+    sub_view(1, 1) = -1;
+    ASSERT_EQ(values[10], -1);
+}
+
+TEST(kstd_MdSlice, tiled) {
+    using namespace kstd;
+    using Layout = Tiled<2, 2>;
+
+    Array<i32> values(16, 0);
+    const MdSlice<i32, 2, Layout> view(values.data(), make_extents(4, 4));
+    ASSERT_EQ(view.get_mapping().get_required_size(), 16);
+
+    for(usize row = 0; row < 4; ++row) {
+        for(usize column = 0; column < 4; ++column) {
+            view(row, column) = static_cast<i32>(row * 4 + column);
+        }
+    }
+    // The first tile holds (0, 0), (0, 1), (1, 0), (1, 1) contiguously
+    ASSERT_EQ(values[0], 0);
+    ASSERT_EQ(values[1], 1);
+    ASSERT_EQ(values[2], 4);
+    ASSERT_EQ(values[3], 5);
+
+    const auto tile = view.tile(1, 1);
+    ASSERT_EQ(tile(0, 0), 10);
+    ASSERT_EQ(tile(1, 1), 15);
+}
+
+TEST(kstd_FixedMdArray, index) {
+    using namespace kstd;
+
+    FixedMdArray<i32, 2, 3, 4> values {};
+    static_assert(decltype(values)::buffer_size == 24);
+    static_assert(decltype(values)::get_extent(1) == 3);
+
+    values(1, 2, 3) = 42;
+    ASSERT_EQ(values.data()[23], 42);
+
+    const MdSlice<i32, 3> view = values;
+    ASSERT_EQ(view(1, 2, 3), 42);
+    ASSERT_EQ(view.row(1, 2)[3], 42);
+}
\ No newline at end of file
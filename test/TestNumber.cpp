@@ -0,0 +1,133 @@
+// Copyright 2024 Karma Krafts & associates
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+#include <gtest/gtest.h>
+#include <kstd/Number.hpp>
+#include <kstd/String.hpp>
+
+using namespace kstd;
+
+template<typename T>
+static auto format(const T value) noexcept -> String {
+    char buffer[number::max_chars<T>];
+    return String(buffer, to_chars(buffer, value));
+}
+
+TEST(kstd_Number, test_parse_integer) {
+    ASSERT_EQ(parse<i32>("12345"_str).value, 12345);
+    ASSERT_EQ(parse<i32>("-12345"_str).value, -12345);
+    ASSERT_EQ(parse<u64>("18446744073709551615"_str).value, 18446744073709551615ULL);
+    ASSERT_EQ(parse<i64>("-9223372036854775808"_str).value, INT64_MIN);
+    ASSERT_EQ(parse<u8>("0000000000000000000000255"_str).value, 255);
+    ASSERT_EQ(parse<u64>("12345678901234567xyz"_str).consumed, 17);
+    ASSERT_EQ(parse<i16>("-0"_str).value, 0);
+}
+
+TEST(kstd_Number, test_parse_integer_invalid) {
+    ASSERT_FALSE(parse<i32>(""_str).is_valid());
+    ASSERT_FALSE(parse<i32>("-"_str).is_valid());
+    ASSERT_FALSE(parse<i32>("+1"_str).is_valid());
+    ASSERT_FALSE(parse<u32>("-1"_str).is_valid());
+    ASSERT_FALSE(parse<u8>("256"_str).is_valid());
+    ASSERT_FALSE(parse<i8>("-129"_str).is_valid());
+    ASSERT_FALSE(parse<i64>("9223372036854775808"_str).is_valid());
+    ASSERT_FALSE(parse<u64>("18446744073709551616"_str).is_valid());
+    ASSERT_FALSE(parse<u64>("33446744073709551616"_str).is_valid());
+    ASSERT_FALSE(parse<u64>("123456789012345678901"_str).is_valid());
+}
+
+TEST(kstd_Number, test_format_integer) {
+    ASSERT_EQ(format(0), "0"_str);
+    ASSERT_EQ(format(7), "7"_str);
+    ASSERT_EQ(format(-42), "-42"_str);
+    ASSERT_EQ(format(static_cast<i8>(-128)), "-128"_str);
+    ASSERT_EQ(format(INT64_MIN), "-9223372036854775808"_str);
+    ASSERT_EQ(format(UINT64_MAX), "18446744073709551615"_str);
+    u64 value = 1;
+    for(usize i = 0; i < 19; ++i) {
+        ASSERT_EQ(parse<u64>(format(value)).value, value);
+        ASSERT_EQ(parse<u64>(format(value - 1)).value, value - 1);
+        value *= 10;
+    }
+}
+
+TEST(kstd_Number, test_parse_float) {
+    ASSERT_EQ(parse<f64>("3.14159"_str).value, 3.14159);
+    ASSERT_EQ(parse<f64>("-2.5e-3"_str).value, -2.5e-3);
+    ASSERT_EQ(parse<f64>(".5"_str).value, 0.5);
+    ASSERT_EQ(parse<f64>("1e308"_str).value, 1e308);
+    ASSERT_EQ(parse<f64>("4.9406564584124654e-324"_str).value, 4.9406564584124654e-324);
+    ASSERT_EQ(parse<f64>("1e-400"_str).value, 0.0);
+    ASSERT_EQ(parse<f64>("1e400"_str).value, __builtin_inf());
+    ASSERT_EQ(parse<f32>("3.4028235e38"_str).value, 3.4028235e38f);
+    ASSERT_EQ(parse<f32>("1.17549435e-38"_str).value, 1.17549435e-38f);
+    ASSERT_EQ(parse<f64>("-Infinity"_str).value, -__builtin_inf());
+    ASSERT_TRUE(__builtin_isnan(parse<f64>("NaN"_str).value));
+}
+
+TEST(kstd_Number, test_parse_float_consumed) {
+    ASSERT_EQ(parse<f64>("1.5e"_str).consumed, 3);
+    ASSERT_EQ(parse<f64>("1.5e+x"_str).consumed, 3);
+    ASSERT_EQ(parse<f64>("2.0f"_str).consumed, 3);
+    ASSERT_EQ(parse<f64>("inf"_str).consumed, 3);
+    ASSERT_EQ(parse<f64>("infinity"_str).consumed, 8);
+    ASSERT_FALSE(parse<f64>("."_str).is_valid());
+    ASSERT_FALSE(parse<f64>("e5"_str).is_valid());
+}
+
+TEST(kstd_Number, test_parse_float_long) {
+    // Exactly halfway between 1 and its successor, ties to even
+    ASSERT_EQ(parse<f64>("1.00000000000000011102230246251565404236316680908203125"_str).value, 1.0);
+    ASSERT_EQ(parse<f64>("1.00000000000000011102230246251565404236316680908203126"_str).value, 1.0000000000000002);
+    ASSERT_EQ(parse<f64>("9007199254740993.0000000000000000000000000001"_str).value, 9007199254740994.0);
+    ASSERT_EQ(parse<f64>("123456789012345678901234567890"_str).value, 1.2345678901234568e29);
+}
+
+TEST(kstd_Number, test_format_float) {
+    ASSERT_EQ(format(0.0), "0"_str);
+    ASSERT_EQ(format(-0.0), "-0"_str);
+    ASSERT_EQ(format(1.0), "1"_str);
+    ASSERT_EQ(format(0.1), "0.1"_str);
+    ASSERT_EQ(format(-1.5), "-1.5"_str);
+    ASSERT_EQ(format(123456.789), "123456.789"_str);
+    ASSERT_EQ(format(1e22), "1e+22"_str);
+    ASSERT_EQ(format(1e-7), "1e-07"_str);
+    ASSERT_EQ(format(0.001), "0.001"_str);
+    ASSERT_EQ(format(5e-324), "5e-324"_str);
+    ASSERT_EQ(format(1.7976931348623157e308), "1.7976931348623157e+308"_str);
+    ASSERT_EQ(format(0.1f), "0.1"_str);
+    ASSERT_EQ(format(3.4028235e38f), "3.4028235e+38"_str);
+    ASSERT_EQ(format(__builtin_inf()), "inf"_str);
+    ASSERT_EQ(format(__builtin_nan("")), "nan"_str);
+}
+
+TEST(kstd_Number, test_round_trip) {
+    u64 state = 0x9E3779B97F4A7C15ULL;
+    char buffer[number::max_chars<f64>];
+    for(usize i = 0; i < 100000; ++i) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        f64 value;
+        memcpy(&value, &state, sizeof(f64));
+        if(__builtin_isnan(value)) {
+            continue;
+        }
+        const auto length = to_chars(buffer, value);
+        const auto result = parse<f64>(StringView(buffer, length));
+        ASSERT_EQ(result.consumed, length);
+        ASSERT_EQ(result.value, value);
+    }
+}
\ No newline at end of file
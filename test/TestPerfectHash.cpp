@@ -0,0 +1,155 @@
+// Copyright 2024 Karma Krafts & associates
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+#include <gtest/gtest.h>
+#include <kstd/PerfectHash.hpp>
+
+using namespace kstd;
+
+namespace {
+    enum class Command : u8 {
+        GET,
+        SET,
+        DELETE,
+        PING
+    };
+
+    constexpr PerfectHashMap commands(fixed_array_of("GET"_str, "SET"_str, "DEL"_str, "PING"_str),
+                                      fixed_array_of(Command::GET, Command::SET, Command::DELETE, Command::PING));
+
+    constexpr PerfectHashMap keywords(fixed_array_of(
+        "alignas"_str,
+        "alignof"_str,
+        "and"_str,
+        "and_eq"_str,
+        "asm"_str,
+        "auto"_str,
+        "bitand"_str,
+        "bitor"_str,
+        "bool"_str,
+        "break"_str,
+        "case"_str,
+        "catch"_str,
+        "char"_str,
+        "char8_t"_str,
+        "char16_t"_str,
+        "char32_t"_str,
+        "class"_str,
+        "compl"_str,
+        "concept"_str,
+        "const"_str,
+        "consteval"_str,
+        "constexpr"_str,
+        "constinit"_str,
+        "const_cast"_str,
+        "continue"_str,
+        "co_await"_str,
+        "co_return"_str,
+        "co_yield"_str,
+        "decltype"_str,
+        "default"_str,
+        "delete"_str,
+        "do"_str,
+        "double"_str,
+        "dynamic_cast"_str,
+        "else"_str,
+        "enum"_str,
+        "explicit"_str,
+        "export"_str,
+        "extern"_str,
+        "false"_str,
+        "float"_str,
+        "for"_str,
+        "friend"_str,
+        "goto"_str,
+        "if"_str,
+        "inline"_str,
+        "int"_str,
+        "long"_str,
+        "mutable"_str,
+        "namespace"_str,
+        "new"_str,
+        "noexcept"_str,
+        "not"_str,
+        "not_eq"_str,
+        "nullptr"_str,
+        "operator"_str,
+        "or"_str,
+        "or_eq"_str,
+        "private"_str,
+        "protected"_str,
+        "public"_str,
+        "register"_str,
+        "reinterpret_cast"_str,
+        "requires"_str,
+        "return"_str,
+        "short"_str,
+        "signed"_str,
+        "sizeof"_str,
+        "static"_str,
+        "static_assert"_str,
+        "static_cast"_str,
+        "struct"_str,
+        "switch"_str,
+        "template"_str,
+        "this"_str,
+        "thread_local"_str,
+        "throw"_str,
+        "true"_str,
+        "try"_str,
+        "typedef"_str,
+        "typeid"_str,
+        "typename"_str,
+        "union"_str,
+        "unsigned"_str,
+        "using"_str,
+        "virtual"_str,
+        "void"_str,
+        "volatile"_str,
+        "wchar_t"_str,
+        "while"_str,
+        "xor"_str,
+        "xor_eq"_str),
+        fixed_array_of<usize>(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 62, 63, 64, 65, 66, 67, 68, 69, 70, 71, 72, 73, 74, 75, 76, 77, 78, 79, 80, 81, 82, 83, 84, 85, 86, 87, 88, 89, 90, 91));
+}// namespace
+
+TEST(kstd_PerfectHashMap, test_find) {
+    ASSERT_EQ(*commands.find("GET"_str), Command::GET);
+    ASSERT_EQ(*commands.find("SET"_str), Command::SET);
+    ASSERT_EQ(*commands.find("DEL"_str), Command::DELETE);
+    ASSERT_EQ(*commands.find("PING"_str), Command::PING);
+    ASSERT_EQ(commands.find("PONG"_str), nullptr);
+    ASSERT_EQ(commands.find(""_str), nullptr);
+    ASSERT_FALSE(commands.contains("get"_str));
+}
+
+TEST(kstd_PerfectHashMap, test_constexpr) {
+    static_assert(commands.contains("PING"_str));
+    static_assert(!commands.contains("PONG"_str));
+    static_assert(*commands.find("SET"_str) == Command::SET);
+    static_assert(keywords.find_index("while"_str) == keywords.size() - 3);
+}
+
+TEST(kstd_PerfectHashMap, test_keywords) {
+    ASSERT_EQ(keywords.size(), 92);
+    for(usize i = 0; i < keywords.size(); ++i) {
+        const auto& key = keywords.get_key(i);
+        ASSERT_EQ(keywords.find_index(key), i);
+        ASSERT_EQ(*keywords.find(key), keywords.get_value(i));
+    }
+    ASSERT_FALSE(keywords.contains("main"_str));
+    ASSERT_FALSE(keywords.contains("whilst"_str));
+    ASSERT_FALSE(keywords.contains("in"_str));
+}
\ No newline at end of file
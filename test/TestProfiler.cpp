@@ -0,0 +1,135 @@
+// Copyright 2024 Karma Krafts & associates
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+#ifdef KSTD_PLATFORM_UNIX
+
+#include <fcntl.h>
+#include <gtest/gtest.h>
+#include <kstd/Allocator.hpp>
+#include <kstd/HeapProfiler.hpp>
+#include <kstd/Profiler.hpp>
+#include <kstd/String.hpp>
+#include <kstd/StringView.hpp>
+#include <time.h>
+#include <unistd.h>
+
+using namespace kstd;
+
+static auto read_file(const char* path) -> String {
+    String result {};
+    const auto fd = open(path, O_RDONLY);
+    if(fd < 0) {
+        return result;
+    }
+    char buffer[256];
+    ssize_t count;
+    while((count = read(fd, buffer, sizeof(buffer))) > 0) {
+        result += StringView(buffer, static_cast<usize>(count));
+    }
+    close(fd);
+    return result;
+}
+
+[[gnu::noinline]] static auto spin(const long milliseconds) -> u64 {
+    timespec start {};
+    timespec now {};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &start);
+    volatile u64 value = 0;
+    do {
+        for(usize i = 0; i < 10000; ++i) {
+            value = value * 31 + i;
+        }
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    } while((now.tv_sec - start.tv_sec) * 1000 + (now.tv_nsec - start.tv_nsec) / 1000000 < milliseconds);
+    return value;
+}
+
+TEST(kstd_Profiler, sample_and_write) {
+    ASSERT_TRUE(profiler::register_thread());
+    ASSERT_TRUE(profiler::start(1000));
+    ASSERT_TRUE(profiler::is_running());
+    ASSERT_FALSE(profiler::start(1000));
+    static_cast<void>(spin(200));
+    profiler::stop();
+    ASSERT_FALSE(profiler::is_running());
+    ASSERT_GT(profiler::get_sample_count(), 0);
+
+    char folded_path[] = "/tmp/kstd_profile_XXXXXX";
+    const auto folded_fd = mkstemp(folded_path);
+    ASSERT_GE(folded_fd, 0);
+    close(folded_fd);
+    ASSERT_TRUE(profiler::write_folded(folded_path));
+    const auto folded = read_file(folded_path);
+    unlink(folded_path);
+    ASSERT_FALSE(folded.is_empty());
+    ASSERT_EQ(folded[folded.size() - 1], '\n');
+
+    char pprof_path[] = "/tmp/kstd_profile_XXXXXX";
+    const auto pprof_fd = mkstemp(pprof_path);
+    ASSERT_GE(pprof_fd, 0);
+    close(pprof_fd);
+    ASSERT_TRUE(profiler::write_pprof(pprof_path));
+    const auto pprof = read_file(pprof_path);
+    unlink(pprof_path);
+    ASSERT_FALSE(pprof.is_empty());
+    ASSERT_EQ(pprof[0], 0x0A);// Profile.sample_type is the first field
+
+    profiler::reset();
+    ASSERT_EQ(profiler::get_sample_count(), 0);
+    profiler::unregister_thread();
+}
+
+TEST(kstd_Profiler, heap_sampling) {
+    constexpr usize block_count = 256;
+    constexpr usize block_size = 4096;
+
+    ASSERT_TRUE(profiler::heap::enable(16 * 1024));
+    ASSERT_TRUE(profiler::heap::is_enabled());
+    Allocator<u8> allocator {};
+    u8* blocks[block_count];
+    for(auto& block : blocks) {
+        block = allocator.allocate(block_size);
+    }
+    const auto live_bytes = profiler::heap::get_bytes(profiler::heap::ProfileKind::LIVE);
+    ASSERT_GT(live_bytes, 0);
+    ASSERT_GE(profiler::heap::get_bytes(profiler::heap::ProfileKind::ALLOCATED), live_bytes);
+
+    char folded_path[] = "/tmp/kstd_heap_XXXXXX";
+    const auto folded_fd = mkstemp(folded_path);
+    ASSERT_GE(folded_fd, 0);
+    close(folded_fd);
+    ASSERT_TRUE(profiler::heap::write_folded(folded_path, profiler::heap::ProfileKind::LIVE));
+    const auto folded = read_file(folded_path);
+    unlink(folded_path);
+    ASSERT_FALSE(folded.is_empty());
+
+    char pprof_path[] = "/tmp/kstd_heap_XXXXXX";
+    const auto pprof_fd = mkstemp(pprof_path);
+    ASSERT_GE(pprof_fd, 0);
+    close(pprof_fd);
+    ASSERT_TRUE(profiler::heap::write_pprof(pprof_path));
+    const auto pprof = read_file(pprof_path);
+    unlink(pprof_path);
+    ASSERT_FALSE(pprof.is_empty());
+
+    for(auto* block : blocks) {
+        allocator.free(block);
+    }
+    ASSERT_LT(profiler::heap::get_bytes(profiler::heap::ProfileKind::LIVE), live_bytes);
+    profiler::heap::disable();
+    ASSERT_FALSE(profiler::heap::is_enabled());
+}
+
+#endif//KSTD_PLATFORM_UNIX
\ No newline at end of file
@@ -0,0 +1,129 @@
+// Copyright 2024 Karma Krafts & associates
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <kstd/Array.hpp>
+#include <kstd/FixedArray.hpp>
+#include <kstd/Slice.hpp>
+#include <kstd/StridedSlice.hpp>
+
+TEST(kstd_Slice, split_at) {
+    using namespace kstd;
+
+    const auto values = fixed_array_of(1, 2, 3, 4, 5);
+    const Slice<i32> slice = values;
+    const auto [left, right] = slice.split_at(2);
+    ASSERT_EQ(left.size(), 2);
+    ASSERT_EQ(right.size(), 3);
+    ASSERT_EQ(left[1], 2);
+    ASSERT_EQ(right[0], 3);
+}
+
+TEST(kstd_Slice, chunks) {
+    using namespace kstd;
+
+    const auto values = fixed_array_of(1, 2, 3, 4, 5, 6, 7);
+    const Slice<i32> slice = values;
+    const auto chunks = slice.chunks(3);
+    ASSERT_EQ(chunks.size(), 3);
+
+    usize count = 0;
+    i32 expected = 1;
+    for(const auto chunk : chunks) {
+        ASSERT_EQ(chunk.size(), count < 2 ? 3 : 1);
+        for(const auto value : chunk) {
+            ASSERT_EQ(value, expected++);
+        }
+        ++count;
+    }
+    ASSERT_EQ(count, 3);
+}
+
+TEST(kstd_Slice, windows) {
+    using namespace kstd;
+
+    const auto values = fixed_array_of(1, 2, 3, 4, 5);
+    const Slice<i32> slice = values;
+
+    usize count = 0;
+    for(const auto window : slice.windows(3)) {
+        ASSERT_EQ(window.size(), 3);
+        ASSERT_EQ(window[0], static_cast<i32>(count) + 1);
+        ++count;
+    }
+    ASSERT_EQ(count, 3);
+    ASSERT_EQ(slice.windows(6).size(), 0);
+}
+
+TEST(kstd_Slice, split) {
+    using namespace kstd;
+
+    const auto values = fixed_array_of(1, 0, 2, 3, 0, 0, 4);
+    const Slice<i32> slice = values;
+
+    usize count = 0;
+    const usize expected_sizes[] = {1, 2, 0, 1};
+    for(const auto part : slice.split([](const i32 value) { return value == 0; })) {
+        ASSERT_EQ(part.size(), expected_sizes[count]);
+        ++count;
+    }
+    ASSERT_EQ(count, 4);
+}
+
+TEST(kstd_SliceMut, chunks) {
+    using namespace kstd;
+
+    auto values = array_of(0, 0, 0, 0, 0, 0);
+    SliceMut<i32> slice = values;
+    i32 index = 0;
+    for(const auto chunk : slice.chunks(2)) {
+        chunk.fill(index++);
+    }
+    ASSERT_EQ(values, array_of(0, 0, 1, 1, 2, 2));
+}
+
+TEST(kstd_SliceMut, split_at) {
+    using namespace kstd;
+
+    auto values = array_of(1, 2, 3, 4);
+    SliceMut<i32> slice = values;
+    auto [left, right] = slice.split_at(2);
+    left[0] = 10;
+    right[1] = 40;
+    ASSERT_EQ(values, array_of(10, 2, 3, 40));
+}
+
+TEST(kstd_StridedSlice, of_column) {
+    using namespace kstd;
+
+    // 3x3 row-major matrix
+    auto values = array_of(1, 2, 3, 4, 5, 6, 7, 8, 9);
+    const auto column = StridedSlice<i32>::of_column(values.data(), 3, 3, 1);
+    ASSERT_EQ(column.size(), 3);
+    ASSERT_EQ(column[0], 2);
+    ASSERT_EQ(column[1], 5);
+    ASSERT_EQ(column[2], 8);
+
+    i32 sum = 0;
+    for(const auto value : column) {
+        sum += value;
+    }
+    ASSERT_EQ(sum, 15);
+
+    column[2] = 0;
+    ASSERT_EQ(values[7], 0);
+
+    i32 gathered[3] {};
+    column.copy_to(gathered, 3);
+    ASSERT_EQ(gathered[1], 5);
+}
\ No newline at end of file
@@ -0,0 +1,103 @@
+// Copyright 2024 Karma Krafts & associates
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <kstd/SoAArray.hpp>
+
+using namespace kstd;
+
+static_assert(is_same<LeftTrimPack<2, u8, u16, u32, u64>, Pack<u32, u64>>);
+static_assert(is_same<LeftTrimPack<0, u8, u16>, Pack<u8, u16>>);
+static_assert(is_same<RightTrimPack<1, u8, u16, u32, u64>, Pack<u8, u16, u32>>);
+static_assert(is_same<RightTrimPack<2, u8, u16>, Pack<>>);
+static_assert(is_same<SlicePack<1, 3, u8, u16, u32, u64>, Pack<u16, u32>>);
+static_assert(is_same<SlicePack<2, 2, u8, u16, u32>, Pack<>>);
+
+TEST(kstd_SoAArray, push_back) {
+    SoAArray<f32, u8, f64> values {};
+    for(usize i = 0; i < 100; ++i) {
+        values.push_back(static_cast<f32>(i), static_cast<u8>(i), static_cast<f64>(i) * 2.0);
+    }
+    ASSERT_EQ(values.size(), 100);
+    ASSERT_GE(values.capacity(), 100);
+
+    for(usize i = 0; i < values.size(); ++i) {
+        const auto row = values[i];
+        ASSERT_EQ(row.get<0>(), static_cast<f32>(i));
+        ASSERT_EQ(row.get<1>(), static_cast<u8>(i));
+        ASSERT_EQ(row.get<2>(), static_cast<f64>(i) * 2.0);
+    }
+}
+
+TEST(kstd_SoAArray, column) {
+    SoAArray<u32, u64> values {};
+    values.push_back(1U, 10ULL);
+    values.push_back(2U, 20ULL);
+    values.push_back(3U, 30ULL);
+
+    const auto column = values.column<1>();
+    ASSERT_EQ(column.size(), 3);
+    u64 sum = 0;
+    for(const auto value : column) {
+        sum += value;
+    }
+    ASSERT_EQ(sum, 60);
+}
+
+TEST(kstd_SoAArray, column_alignment) {
+    SoAArray<u8, u32, f64> values(3);
+    values.push_back(u8 {1}, 2U, 3.0);
+    ASSERT_EQ(reinterpret_cast<usize>(values.get_column_data<0>()) % values.column_alignment, 0);
+    ASSERT_EQ(reinterpret_cast<usize>(values.get_column_data<1>()) % values.column_alignment, 0);
+    ASSERT_EQ(reinterpret_cast<usize>(values.get_column_data<2>()) % values.column_alignment, 0);
+}
+
+struct alignas(256) OverAligned final {
+    u32 value;
+};
+
+TEST(kstd_SoAArray, over_aligned_column) {
+    SoAArray<u8, OverAligned> values(5);
+    values.push_back(u8 {1}, OverAligned {2});
+    ASSERT_EQ(reinterpret_cast<usize>(values.get_column_data<0>()) % alignof(OverAligned), 0);
+    ASSERT_EQ(reinterpret_cast<usize>(values.get_column_data<1>()) % alignof(OverAligned), 0);
+    ASSERT_EQ(values.get_column_data<1>()[0].value, 2);
+}
+
+TEST(kstd_SoAArray, row_assign) {
+    SoAArray<i32, i32> values {};
+    values.push_back(1, 2);
+    values[0].get<1>() = 42;
+    ASSERT_EQ(values[0].get<0>(), 1);
+    ASSERT_EQ(values[0].get<1>(), 42);
+}
+
+TEST(kstd_SoAArray, copy) {
+    SoAArray<i32, f32> values {};
+    values.push_back(1, 1.0F);
+    values.push_back(2, 2.0F);
+
+    const auto copy = values;
+    ASSERT_EQ(copy.size(), 2);
+    ASSERT_EQ(copy[1].get<0>(), 2);
+    ASSERT_EQ(copy[1].get<1>(), 2.0F);
+}
+
+TEST(kstd_SoAArray, pop_back) {
+    SoAArray<i32, f32> values {};
+    values.push_back(1, 1.0F);
+    values.push_back(2, 2.0F);
+    values.pop_back();
+    ASSERT_EQ(values.size(), 1);
+    ASSERT_EQ(values[0].get<0>(), 1);
+}
\ No newline at end of file
@@ -0,0 +1,91 @@
+// Copyright 2024 Karma Krafts & associates
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <kstd/StableArray.hpp>
+
+TEST(kstd_StableArray, push_back) {
+    using namespace kstd;
+
+    StableArray<usize> values {};
+    for(usize i = 0; i < 1000; ++i) {
+        values.push_back(i);
+    }
+    ASSERT_EQ(values.size(), 1000);
+    for(usize i = 0; i < values.size(); ++i) {
+        ASSERT_EQ(values[i], i);
+    }
+}
+
+TEST(kstd_StableArray, stable_addresses) {
+    using namespace kstd;
+
+    StableArray<usize> values {};
+    const auto* first = &values.push_back(1337);
+    const auto* second = &values.push_back(1338);
+    for(usize i = 0; i < 10000; ++i) {
+        values.push_back(i);
+    }
+    ASSERT_EQ(first, &values[0]);
+    ASSERT_EQ(second, &values[1]);
+    ASSERT_EQ(*first, 1337);
+    ASSERT_EQ(*second, 1338);
+}
+
+TEST(kstd_StableArray, segments) {
+    using namespace kstd;
+
+    StableArray<usize> values {};
+    for(usize i = 0; i < 20; ++i) {
+        values.push_back(i);
+    }
+    ASSERT_EQ(values.get_segment_count(), 2);
+
+    const auto first = values.get_segment(0);
+    ASSERT_EQ(first.size(), values.first_segment_size);
+    const auto second = values.get_segment(1);
+    ASSERT_EQ(second.size(), 20 - values.first_segment_size);
+
+    usize expected = 0;
+    for(usize i = 0; i < values.get_segment_count(); ++i) {
+        for(const auto value : values.get_segment(i)) {
+            ASSERT_EQ(value, expected++);
+        }
+    }
+    ASSERT_EQ(expected, 20);
+}
+
+TEST(kstd_StableArray, iterate) {
+    using namespace kstd;
+
+    StableArray<usize> values {};
+    for(usize i = 0; i < 100; ++i) {
+        values.push_back(i);
+    }
+    usize expected = 0;
+    for(const auto value : values) {
+        ASSERT_EQ(value, expected++);
+    }
+    ASSERT_EQ(expected, 100);
+}
+
+TEST(kstd_StableArray, pop_back) {
+    using namespace kstd;
+
+    StableArray<usize> values {};
+    values.push_back(1);
+    values.push_back(2);
+    values.pop_back();
+    ASSERT_EQ(values.size(), 1);
+    ASSERT_EQ(values.back(), 1);
+}
\ No newline at end of file
@@ -13,8 +13,14 @@
 
 #include <gtest/gtest.h>
 #include <kstd/StackTrace.hpp>
+#include <kstd/SymbolCache.hpp>
 #include <istream>
 
+[[gnu::always_inline]] static inline auto get_inlined_trace() noexcept -> kstd::StackTrace {
+    return kstd::StackTrace::get_current();
+}
+static constexpr kstd::usize inlined_trace_line = __LINE__ - 2;
+
 TEST(kstd_StackTrace, get_current) {
     using namespace kstd;
 
@@ -23,11 +29,98 @@ TEST(kstd_StackTrace, get_current) {
         const auto& element = stack_trace[i];
 
         std::cout << std::hex << "Address: " << element.get_address() << '\n';
-        printf("Binary: %s\n", element.get_binary().c_str());
-        printf("File Name: %s\n", element.get_file_name().c_str());
-        printf("Function Name: %s\n", element.get_function_name().c_str());
+        printf("Binary: %.*s\n", static_cast<int>(element.get_binary().length()), element.get_binary().data());
+        printf("File Name: %.*s\n", static_cast<int>(element.get_file_name().length()), element.get_file_name().data());
+        printf("Function Name: %.*s\n", static_cast<int>(element.get_function_name().length()), element.get_function_name().data());
         printf("Line: %d\n", static_cast<int>(element.get_line()));
         printf("Column: %d\n", static_cast<int>(element.get_column()));
         printf("\n");
     }
+}
+
+TEST(kstd_StackTrace, source_location) {
+    using namespace kstd;
+#ifndef KSTD_TESTS_HAVE_DEBUG_INFO
+    GTEST_SKIP() << "The test binary is built without line information";
+#endif
+
+    const auto stack_trace = StackTrace::get_current();
+    const auto line = static_cast<usize>(__LINE__ - 1);
+    const auto& element = stack_trace[0];
+    ASSERT_TRUE(element.get_file_name().ends_with("TestStackTrace.cpp"_str));
+    ASSERT_EQ(element.get_line(), line);
+    ASSERT_FALSE(element.is_inlined());
+}
+
+TEST(kstd_StackTrace, inlined_frames) {
+    using namespace kstd;
+#ifndef KSTD_TESTS_HAVE_DEBUG_INFO
+    GTEST_SKIP() << "The test binary is built without line information";
+#endif
+
+    const auto stack_trace = get_inlined_trace();
+    const auto line = static_cast<usize>(__LINE__ - 1);
+    const auto elements = stack_trace.get_elements(0);
+    // The inlined helper comes first with its own line, the test function carries the call site
+    ASSERT_GE(elements.size(), 2);
+    ASSERT_TRUE(elements[0].is_inlined());
+    ASSERT_TRUE(elements[0].get_function_name().contains("get_inlined_trace"_str));
+    ASSERT_EQ(elements[0].get_line(), inlined_trace_line);
+    ASSERT_FALSE(elements[1].is_inlined());
+    ASSERT_TRUE(elements[1].get_file_name().ends_with("TestStackTrace.cpp"_str));
+    ASSERT_EQ(elements[1].get_line(), line);
+}
+
+TEST(kstd_StackTrace, lazy_symbolization) {
+    using namespace kstd;
+
+    const auto stack_trace = StackTrace::get_current();
+    ASSERT_GT(stack_trace.get_depth(), 0);
+    ASSERT_FALSE(stack_trace.is_symbolized());
+    ASSERT_NE(stack_trace.get_address(0), nullptr);
+
+    stack_trace.symbolize();
+    ASSERT_TRUE(stack_trace.is_symbolized());
+    for (usize i = 0; i < stack_trace.get_depth(); i++) {
+        const auto elements = stack_trace.get_elements(i);
+        ASSERT_GT(elements.size(), 0);
+        ASSERT_FALSE(elements[elements.size() - 1].is_inlined());
+        ASSERT_EQ(stack_trace[i].get_address(), stack_trace.get_address(i));
+    }
+}
+
+TEST(kstd_StackTrace, frame_pointer_unwinding) {
+    using namespace kstd;
+
+    StackTrace::set_unwind_mode(UnwindMode::FRAME_POINTER);
+    const auto stack_trace = StackTrace::get_current();
+    StackTrace::set_unwind_mode(UnwindMode::LIBUNWIND);
+    ASSERT_GT(stack_trace.get_depth(), 0);
+
+    const auto reference = StackTrace::get_current();
+    ASSERT_GT(reference.get_depth(), 0);
+    ASSERT_EQ(stack_trace[0].get_function_name(), reference[0].get_function_name());
+}
+
+TEST(kstd_StackTrace, symbol_cache) {
+    using namespace kstd;
+
+    const auto first = StackTrace::get_current();
+    void* addresses[StackTrace::max_depth];
+    for (usize i = 0; i < first.get_depth(); i++) {
+        addresses[i] = first.get_address(i);
+    }
+    const auto second = StackTrace::from_addresses(addresses, first.get_depth());
+    ASSERT_GT(second.get_depth(), 0);
+
+    first.symbolize();
+    Slice<StackTraceElement> cached_elements {};
+    ASSERT_TRUE(get_symbol_cache().find(first.get_address(0), cached_elements));
+    ASSERT_EQ(cached_elements.size(), first.get_elements(0).size());
+
+    // Cache hits share the interned names instead of copying them
+    for (usize i = 0; i < first.get_depth(); i++) {
+        ASSERT_EQ(second[i].get_function_name().data(), first[i].get_function_name().data());
+        ASSERT_EQ(second[i].get_binary().data(), first[i].get_binary().data());
+    }
 }
\ No newline at end of file
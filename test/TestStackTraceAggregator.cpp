@@ -0,0 +1,112 @@
+// Copyright 2024 Karma Krafts & associates
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <gtest/gtest.h>
+#include <kstd/StackTraceAggregator.hpp>
+
+// NOLINTBEGIN
+#include <thread>
+#include <vector>
+// NOLINTEND
+
+using namespace kstd;
+
+static auto make_stack(const usize id, const usize caller) -> FixedArray<void*, 3> {
+    FixedArray<void*, 3> stack {};
+    stack[0] = reinterpret_cast<void*>(0x1000 + id);
+    stack[1] = reinterpret_cast<void*>(0x2000 + id);
+    stack[2] = reinterpret_cast<void*>(0x3000 + caller);
+    return stack;
+}
+
+TEST(kstd_StackTraceAggregator, test_hash) {
+    const auto first = make_stack(1, 1);
+    const auto second = make_stack(1, 2);
+    ASSERT_EQ(StackTrace::hash_addresses(first.data(), 3), StackTrace::hash_addresses(first.data(), 3));
+    ASSERT_NE(StackTrace::hash_addresses(first.data(), 3), StackTrace::hash_addresses(second.data(), 3));
+    // Limiting the depth merges stacks which only differ in their callers
+    ASSERT_EQ(StackTrace::hash_addresses(first.data(), 2), StackTrace::hash_addresses(second.data(), 2));
+
+    const auto trace = StackTrace::from_addresses(first.data(), 3);
+    ASSERT_EQ(trace.get_hash(), StackTrace::hash_addresses(first.data(), 3));
+    ASSERT_EQ(trace.get_hash(1, 1), StackTrace::hash_addresses(first.data() + 1, 1));
+    ASSERT_EQ(trace.get_hash(5), StackTrace::hash_addresses(nullptr, 0));
+}
+
+TEST(kstd_StackTraceAggregator, test_count) {
+    StackTraceAggregator aggregator(16, 2);
+    for(usize i = 0; i < 4; ++i) {
+        for(usize j = 0; j <= i; ++j) {
+            aggregator.add(make_stack(i, j).data(), 3);
+        }
+    }
+    ASSERT_EQ(aggregator.get_total_count(), 10);
+    ASSERT_EQ(aggregator.get_eviction_count(), 0);
+
+    const auto counts = aggregator.get_counts();
+    ASSERT_EQ(counts.size(), 4);
+    for(usize i = 0; i < counts.size(); ++i) {
+        ASSERT_EQ(counts[i].count, 4 - i);
+        ASSERT_EQ(counts[i].error, 0);
+        ASSERT_EQ(counts[i].trace.get_depth(), 2);
+        ASSERT_EQ(counts[i].trace.get_address(0), make_stack(3 - i, 0)[0]);
+        ASSERT_TRUE(counts[i].trace.is_symbolized());
+    }
+    ASSERT_EQ(aggregator.get_counts(1).size(), 1);
+
+    aggregator.clear();
+    ASSERT_EQ(aggregator.get_counts().size(), 0);
+    ASSERT_EQ(aggregator.get_total_count(), 0);
+}
+
+TEST(kstd_StackTraceAggregator, test_eviction) {
+    StackTraceAggregator aggregator(StackTraceAggregator::shard_count);
+    const auto frequent = make_stack(0, 0);
+    for(usize i = 0; i < 1000; ++i) {
+        aggregator.add(frequent.data(), 3);
+        aggregator.add(make_stack(i + 1, 0).data(), 3);
+    }
+    ASSERT_GT(aggregator.get_eviction_count(), 0);
+
+    const auto counts = aggregator.get_counts();
+    ASSERT_LE(counts.size(), aggregator.get_capacity());
+    ASSERT_EQ(counts[0].trace.get_address(0), frequent[0]);
+    ASSERT_GE(counts[0].count, 1000);
+    ASSERT_LE(counts[0].count - counts[0].error, 1000);
+}
+
+TEST(kstd_StackTraceAggregator, test_concurrent) {
+    constexpr usize thread_count = 4;
+    constexpr usize iterations = 10000;
+
+    StackTraceAggregator aggregator {};
+    std::vector<std::thread> threads {};
+    for(usize i = 0; i < thread_count; ++i) {
+        threads.emplace_back([&aggregator] {
+            for(usize j = 0; j < iterations; ++j) {
+                aggregator.add(make_stack(j % 8, 0).data(), 3);
+            }
+        });
+    }
+    for(auto& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQ(aggregator.get_total_count(), thread_count * iterations);
+    const auto counts = aggregator.get_counts();
+    ASSERT_EQ(counts.size(), 8);
+    for(const auto& count : counts) {
+        ASSERT_EQ(count.count, thread_count * iterations / 8);
+    }
+}
\ No newline at end of file
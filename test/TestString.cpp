@@ -0,0 +1,152 @@
+// Copyright 2024 Karma Krafts & associates
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <gtest/gtest.h>
+#include <kstd/String.hpp>
+
+using namespace kstd;
+
+TEST(kstd_String, test_empty) {
+    String value {};
+    ASSERT_TRUE(value.is_empty());
+    ASSERT_EQ(value.size(), 0);
+    ASSERT_EQ(value.capacity(), String::inline_capacity);
+    ASSERT_EQ(value.c_str()[0], '\0');
+}
+
+TEST(kstd_String, test_inline) {
+    static_assert(sizeof(String) == sizeof(usize) * 3);
+    String value("Hello, World!");
+    ASSERT_EQ(value.size(), 13);
+    ASSERT_EQ(value.capacity(), String::inline_capacity);
+    ASSERT_EQ(value, "Hello, World!");
+    ASSERT_EQ(value.c_str()[13], '\0');
+}
+
+TEST(kstd_String, test_inline_boundary) {
+    String value(String::inline_capacity, 'a');
+    ASSERT_EQ(value.size(), String::inline_capacity);
+    ASSERT_EQ(value.capacity(), String::inline_capacity);
+    ASSERT_EQ(value.c_str()[String::inline_capacity], '\0');
+
+    value.push_back('b');
+    ASSERT_EQ(value.size(), String::inline_capacity + 1);
+    ASSERT_GT(value.capacity(), String::inline_capacity);
+    ASSERT_EQ(value[String::inline_capacity - 1], 'a');
+    ASSERT_EQ(value[String::inline_capacity], 'b');
+    ASSERT_EQ(value.c_str()[String::inline_capacity + 1], '\0');
+
+    value.pop_back();
+    ASSERT_EQ(value, String(String::inline_capacity, 'a'));
+}
+
+TEST(kstd_String, test_append) {
+    String value {};
+    for(usize i = 0; i < 100; ++i) {
+        value += static_cast<char>('a' + (i % 26));
+    }
+    ASSERT_EQ(value.size(), 100);
+    ASSERT_GE(value.capacity(), 100);
+    for(usize i = 0; i < 100; ++i) {
+        ASSERT_EQ(value[i], static_cast<char>('a' + (i % 26)));
+    }
+    ASSERT_EQ(value.c_str()[100], '\0');
+
+    String other("Hello");
+    other += ", ";
+    other.append("World"_str);
+    ASSERT_EQ(other, "Hello, World");
+    ASSERT_EQ(other + "!"_str, "Hello, World!");
+}
+
+TEST(kstd_String, test_append_self) {
+    String value("0123456789abcdefghij");
+    value += value;
+    ASSERT_EQ(value, "0123456789abcdefghij0123456789abcdefghij");
+    value += value.data();
+    ASSERT_EQ(value.size(), 80);
+    ASSERT_EQ(value, "0123456789abcdefghij0123456789abcdefghij0123456789abcdefghij0123456789abcdefghij");
+    value.append(value.data() + 10, 5);
+    ASSERT_EQ(value.size(), 85);
+    ASSERT_EQ(value.data()[80], 'a');
+    ASSERT_EQ(value.data()[84], 'e');
+}
+
+TEST(kstd_String, test_append_self_inline) {
+    String value("abc");
+    value += value;
+    ASSERT_EQ(value, "abcabc");
+}
+
+TEST(kstd_String, test_copy_move) {
+    String small("small");
+    String large("a string which is too long for the inline buffer");
+
+    String small_copy(small);
+    String large_copy(large);
+    ASSERT_EQ(small_copy, small);
+    ASSERT_EQ(large_copy, large);
+    ASSERT_NE(large_copy.data(), large.data());
+
+    const auto* large_data = large.data();
+    String large_moved(move(large));
+    ASSERT_EQ(large_moved.data(), large_data);
+    ASSERT_TRUE(large.is_empty());
+
+    small_copy = large_moved;
+    ASSERT_EQ(small_copy, large_moved);
+    large_copy = small;
+    ASSERT_EQ(large_copy, "small");
+}
+
+TEST(kstd_String, test_find_substr) {
+    String value("lib/libfoo.so!function_name");
+    const auto index = value.find('!');
+    ASSERT_EQ(index, 13);
+    ASSERT_EQ(value.substr(0, index), "lib/libfoo.so");
+    ASSERT_EQ(value.substr(index + 1), "function_name");
+    ASSERT_EQ(value.find('?'), String::npos);
+    ASSERT_EQ(value.find('o', 8), 8);
+}
+
+TEST(kstd_String, test_resize_reserve) {
+    String value("abc");
+    value.reserve(64);
+    ASSERT_GE(value.capacity(), 64);
+    ASSERT_EQ(value, "abc");
+    value.resize(5, 'x');
+    ASSERT_EQ(value, "abcxx");
+    value.resize(2);
+    ASSERT_EQ(value, "ab");
+    value.clear();
+    ASSERT_TRUE(value.is_empty());
+}
+
+TEST(kstd_String, test_resize_uninitialized) {
+    String value("abc");
+    value.resize_uninitialized(100);
+    ASSERT_EQ(value.size(), 100);
+    ASSERT_GE(value.capacity(), 100);
+    ASSERT_EQ(value.data()[100], '\0');
+    value.resize_uninitialized(3);
+    ASSERT_EQ(value, "abc");
+}
+
+TEST(kstd_String, test_view) {
+    String value("Hello");
+    StringView view = value;
+    ASSERT_EQ(view.length(), 5);
+    ASSERT_EQ(view.data(), value.data());
+    ASSERT_EQ(value, view);
+}
\ No newline at end of file
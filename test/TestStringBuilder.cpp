@@ -0,0 +1,156 @@
+// Copyright 2024 Karma Krafts & associates
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+#include <gtest/gtest.h>
+#include <kstd/Rope.hpp>
+#include <kstd/StringBuilder.hpp>
+
+using namespace kstd;
+
+TEST(kstd_StringBuilder, test_append) {
+    StringBuilder builder {};
+    ASSERT_TRUE(builder.is_empty());
+    builder << "Hello"_str << ',' << ' ' << "World! "_str << 42 << ' ' << -1337;
+    ASSERT_EQ(builder.length(), 22);
+    ASSERT_EQ(builder.get_segment_count(), 1);
+    ASSERT_EQ(builder.flatten(), "Hello, World! 42 -1337"_str);
+}
+
+TEST(kstd_StringBuilder, test_borrowed) {
+    StringBuilder builder {};
+    const auto borrowed = "borrowed"_str;
+    builder.append("copied "_str);
+    builder.append_borrowed(borrowed);
+    builder.append(" again"_str);
+    const auto segments = builder.get_segments();
+    ASSERT_EQ(segments.size(), 3);
+    ASSERT_EQ(segments[1].data(), borrowed.data());
+    ASSERT_EQ(builder.flatten(), "copied borrowed again"_str);
+}
+
+TEST(kstd_StringBuilder, test_chunks) {
+    StringBuilder builder {};
+    for(usize i = 0; i < 10000; ++i) {
+        builder.append(static_cast<char>('a' + i % 26));
+    }
+    ASSERT_EQ(builder.length(), 10000);
+    ASSERT_GT(builder.get_segment_count(), 1);
+    usize total = 0;
+    for(const auto& segment : builder.get_segments()) {
+        total += segment.size();
+    }
+    ASSERT_EQ(total, 10000);
+    const auto result = builder.flatten();
+    for(usize i = 0; i < 10000; ++i) {
+        ASSERT_EQ(result[i], static_cast<char>('a' + i % 26));
+    }
+}
+
+TEST(kstd_StringBuilder, test_clear) {
+    StringBuilder builder {};
+    builder << "Some text"_str;
+    builder.clear();
+    ASSERT_TRUE(builder.is_empty());
+    ASSERT_EQ(builder.get_segment_count(), 0);
+    builder << "Other"_str;
+    ASSERT_EQ(builder.flatten(), "Other"_str);
+}
+
+TEST(kstd_StringBuilder, test_move) {
+    StringBuilder builder {};
+    builder << "Moved"_str;
+    StringBuilder other(move(builder));
+    ASSERT_TRUE(builder.is_empty());// NOLINT
+    ASSERT_EQ(other.flatten(), "Moved"_str);
+}
+
+TEST(kstd_Rope, test_empty) {
+    Rope rope {};
+    ASSERT_TRUE(rope.is_empty());
+    ASSERT_EQ(rope.flatten(), ""_str);
+    ASSERT_TRUE(rope.substr(0, 10).is_empty());
+}
+
+TEST(kstd_Rope, test_concat) {
+    Rope left("Hello, "_str);
+    Rope right("World!"_str);
+    const auto rope = left + right;
+    ASSERT_EQ(rope.length(), 13);
+    ASSERT_TRUE(rope == "Hello, World!"_str);
+    ASSERT_EQ(rope.at(7), 'W');
+    ASSERT_TRUE(left == "Hello, "_str);
+}
+
+TEST(kstd_Rope, test_balanced) {
+    String expected {};
+    Rope rope {};
+    for(usize i = 0; i < 2000; ++i) {
+        String value {};
+        for(usize j = 0; j < 37; ++j) {
+            value.push_back(static_cast<char>('a' + (i + j) % 26));
+        }
+        expected.append(value);
+        rope = rope + Rope(value);
+    }
+    ASSERT_EQ(rope.length(), expected.size());
+    ASSERT_LE(rope.get_height(), 24);
+    ASSERT_EQ(rope.flatten(), expected);
+    for(usize i = 0; i < expected.size(); i += 97) {
+        ASSERT_EQ(rope[i], expected[i]);
+    }
+}
+
+TEST(kstd_Rope, test_substr) {
+    String expected {};
+    for(usize i = 0; i < 5000; ++i) {
+        expected.push_back(static_cast<char>('0' + i % 10));
+    }
+    const Rope rope(expected);
+    for(usize start = 0; start < expected.size(); start += 311) {
+        for(usize count = 0; count < 3000; count += 499) {
+            const auto sub = rope.substr(start, count);
+            const auto view = StringView(expected).substr(start, count);
+            ASSERT_EQ(sub.length(), view.length());
+            ASSERT_TRUE(sub == view);
+        }
+    }
+    ASSERT_TRUE(rope.substr(4990) == "0123456789"_str);
+}
+
+TEST(kstd_Rope, test_chunks) {
+    String expected {};
+    for(usize i = 0; i < 4096; ++i) {
+        expected.push_back(static_cast<char>('a' + i % 26));
+    }
+    const Rope rope(expected);
+    usize offset = 0;
+    usize count = 0;
+    for(const auto chunk : rope.chunks()) {
+        ASSERT_TRUE(chunk == StringView(expected).substr(offset, chunk.length()));
+        offset += chunk.length();
+        ++count;
+    }
+    ASSERT_EQ(offset, expected.size());
+    ASSERT_GT(count, 1);
+}
+
+TEST(kstd_StringBuilder, test_numbers) {
+    StringBuilder builder {};
+    builder << 0.1 << ' ' << 1e22 << ' ' << 2.5f << ' ' << static_cast<u8>(255) << ' ' << INT64_MIN;
+    ASSERT_EQ(builder.flatten(), "0.1 1e+22 2.5 255 -9223372036854775808"_str);
+    WStringBuilder wide_builder {};
+    wide_builder << -12 << 0.5;
+    ASSERT_EQ(wide_builder.flatten(), WString(L"-120.5"));
+}
\ No newline at end of file
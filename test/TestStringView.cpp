@@ -12,4 +12,142 @@
 // limitations under the License.
 
 #include <gtest/gtest.h>
-#include <kstd/StringView.hpp>
\ No newline at end of file
+#include <kstd/StringView.hpp>
+
+// NOLINTBEGIN
+#include <string>
+#include <vector>
+// NOLINTEND
+
+using namespace kstd;
+
+TEST(kstd_StringView, test_find_char) {
+    const auto value = "The quick brown fox jumps over the lazy dog, and keeps running!"_str;
+    ASSERT_EQ(value.find('T'), 0);
+    ASSERT_EQ(value.find('q'), 4);
+    ASSERT_EQ(value.find('!'), value.length() - 1);
+    ASSERT_EQ(value.find('#'), StringView::npos);
+    ASSERT_EQ(value.find('o', 13), 17);
+    ASSERT_EQ(value.find('o', value.length()), StringView::npos);
+    ASSERT_EQ(value.find_last('o'), 41);
+    ASSERT_EQ(u"wide string"_str.find(u's'), 5);
+}
+
+TEST(kstd_StringView, test_find_view) {
+    const auto value = "The quick brown fox jumps over the lazy dog, and keeps running!"_str;
+    ASSERT_EQ(value.find("The"_str), 0);
+    ASSERT_EQ(value.find("fox"_str), 16);
+    ASSERT_EQ(value.find("running!"_str), value.length() - 8);
+    ASSERT_EQ(value.find("cat"_str), StringView::npos);
+    ASSERT_EQ(value.find(""_str), 0);
+    ASSERT_EQ(value.find("o"_str, 13), 17);
+    ASSERT_EQ("ab"_str.find("abc"_str), StringView::npos);
+    ASSERT_TRUE(value.contains("lazy dog"_str));
+    ASSERT_EQ(U"needle in a haystack"_str.find(U"hay"_str), 12);
+}
+
+TEST(kstd_StringView, test_find_view_against_reference) {
+    // Periodic and repetitive needles exercise both branches of the two-way fallback
+    u64 state = 42;
+    std::string haystack(300, 'a');
+    for(usize round = 0; round < 3000; ++round) {
+        for(auto& value : haystack) {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            value = static_cast<char>('a' + ((state >> 60) & 1) + ((state >> 62) == 0 ? 2 : 0));
+        }
+        const auto start = static_cast<usize>(state >> 20) % haystack.size();
+        const auto length = 1 + static_cast<usize>(state >> 40) % 12;
+        auto needle = haystack.substr(start, length);
+        if((round & 1) != 0) {
+            needle.back() = 'd';
+        }
+        const auto view = StringView(haystack.data(), haystack.size());
+        const auto expected = haystack.find(needle);
+        const auto result = view.find(StringView(needle.data(), needle.size()));
+        ASSERT_EQ(result, expected == std::string::npos ? StringView::npos : expected) << needle;
+        // The scalar path directly, on the same input
+        const auto two_way = search::find_two_way(haystack.data(), haystack.size(), needle.data(), needle.size());
+        ASSERT_EQ(two_way, expected == std::string::npos ? search::npos : expected) << needle;
+    }
+}
+
+TEST(kstd_StringView, test_find_any_of) {
+    const auto value = "key=value; other_key = \"quoted value\"\r\n"_str;
+    ASSERT_EQ(value.find_any_of("=;"_str), 3);
+    ASSERT_EQ(value.find_any_of("=;"_str, 4), 9);
+    ASSERT_EQ(value.find_any_of("\"\r\n"_str), 23);
+    ASSERT_EQ(value.find_any_of("#@"_str), StringView::npos);
+
+    constexpr auto delimiters = " \t\r\n"_str;
+    const search::ByteSet set(delimiters.data(), delimiters.length());
+    ASSERT_TRUE(set.is_nibble_exact());
+    ASSERT_EQ(value.find_any_of(set), 10);
+
+    // More than 8 distinct high nibbles fall back to the bitmap
+    const u8 wide_set[] = {0x01, 0x11, 0x21, 0x31, 0x41, 0x51, 0x61, 0x71, 0x81, 0x91};
+    const search::ByteSet large(wide_set, sizeof(wide_set));
+    ASSERT_FALSE(large.is_nibble_exact());
+    const auto high_bytes = "\x80\x90\xA0\xB0\xC0\xD0\xE0\xF0\x90\x91"_str;
+    ASSERT_EQ(high_bytes.find_any_of(large), 9);
+
+    for(usize i = 0; i < 256; ++i) {
+        const auto byte = static_cast<char>(i);
+        const search::ByteSet single(&byte, 1);
+        char buffer[64] {};
+        buffer[40] = byte;
+        const auto found = StringView(buffer, sizeof(buffer)).find_any_of(single);
+        ASSERT_EQ(found, i == 0 ? 0 : 40);
+    }
+}
+
+TEST(kstd_StringView, test_starts_ends_with) {
+    const auto value = "prefix.body.suffix"_str;
+    ASSERT_TRUE(value.starts_with("prefix"_str));
+    ASSERT_TRUE(value.starts_with('p'));
+    ASSERT_FALSE(value.starts_with("body"_str));
+    ASSERT_TRUE(value.ends_with("suffix"_str));
+    ASSERT_TRUE(value.ends_with('x'));
+    ASSERT_FALSE(value.ends_with("prefix.body.suffix.longer"_str));
+    ASSERT_TRUE(""_str.starts_with(""_str));
+    ASSERT_FALSE(""_str.ends_with('x'));
+}
+
+TEST(kstd_StringView, test_split) {
+    std::vector<std::string> parts {};
+    for(const auto part : "a,b,,c"_str.split(',')) {
+        parts.emplace_back(part.data(), part.length());
+    }
+    ASSERT_EQ(parts, (std::vector<std::string> {"a", "b", "", "c"}));
+
+    parts.clear();
+    for(const auto part : "one::two::::three::"_str.split("::"_str)) {
+        parts.emplace_back(part.data(), part.length());
+    }
+    ASSERT_EQ(parts, (std::vector<std::string> {"one", "two", "", "three", ""}));
+
+    parts.clear();
+    for(const auto part : "no delimiter"_str.split(',')) {
+        parts.emplace_back(part.data(), part.length());
+    }
+    ASSERT_EQ(parts, (std::vector<std::string> {"no delimiter"}));
+}
+
+TEST(kstd_StringView, test_lines) {
+    std::vector<std::string> lines {};
+    for(const auto line : "first\nsecond\r\n\nlast"_str.lines()) {
+        lines.emplace_back(line.data(), line.length());
+    }
+    ASSERT_EQ(lines, (std::vector<std::string> {"first", "second", "", "last"}));
+
+    lines.clear();
+    for(const auto line : "trailing\n"_str.lines()) {
+        lines.emplace_back(line.data(), line.length());
+    }
+    ASSERT_EQ(lines, (std::vector<std::string> {"trailing"}));
+
+    usize count = 0;
+    for([[maybe_unused]] const auto line : ""_str.lines()) {
+        ++count;
+    }
+    ASSERT_EQ(count, 0);
+}
\ No newline at end of file
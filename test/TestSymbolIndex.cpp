@@ -0,0 +1,140 @@
+// Copyright 2024 Karma Krafts & associates
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+#ifdef KSTD_PLATFORM_UNIX
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <gtest/gtest.h>
+#include <kstd/StackTrace.hpp>
+#include <kstd/String.hpp>
+#include <kstd/StringView.hpp>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace kstd;
+
+// The build-id follows the magic, version and build-id size in the index header
+static constexpr off_t build_id_offset = 16;
+
+static auto find_index(const char* directory) -> String {
+    String result {};
+    auto* stream = opendir(directory);
+    if(stream == nullptr) {
+        return result;
+    }
+    while(const auto* entry = readdir(stream)) {
+        const StringView name(entry->d_name, strlen(entry->d_name));
+        if(name.length() > 4 && strcmp(entry->d_name + name.length() - 4, ".idx") == 0) {
+            result = String(directory);
+            result += '/';
+            result += name;
+            break;
+        }
+    }
+    closedir(stream);
+    return result;
+}
+
+static auto get_status(const String& path) -> struct stat {
+    struct stat status {};
+    stat(path.c_str(), &status);
+    return status;
+}
+
+static auto symbolize(void* const* addresses, const usize depth) -> StackTrace {
+    auto trace = StackTrace::from_addresses(addresses, depth);
+    trace.symbolize();
+    return trace;
+}
+
+static auto assert_same_elements(const StackTrace& expected, const StackTrace& actual) -> void {
+    ASSERT_EQ(actual.get_depth(), expected.get_depth());
+    for(usize i = 0; i < expected.get_depth(); ++i) {
+        const auto expected_elements = expected.get_elements(i);
+        const auto actual_elements = actual.get_elements(i);
+        ASSERT_EQ(actual_elements.size(), expected_elements.size());
+        for(usize j = 0; j < expected_elements.size(); ++j) {
+            ASSERT_EQ(actual_elements[j].get_function_name(), expected_elements[j].get_function_name());
+            ASSERT_EQ(actual_elements[j].get_file_name(), expected_elements[j].get_file_name());
+            ASSERT_EQ(actual_elements[j].get_line(), expected_elements[j].get_line());
+            ASSERT_EQ(actual_elements[j].get_column(), expected_elements[j].get_column());
+            ASSERT_EQ(actual_elements[j].is_inlined(), expected_elements[j].is_inlined());
+        }
+    }
+}
+
+TEST(kstd_SymbolIndex, write_and_map) {
+#ifndef KSTD_TESTS_HAVE_DEBUG_INFO
+    GTEST_SKIP() << "The test binary is built without debug information to index";
+#endif
+    const auto current = StackTrace::get_current();
+    void* addresses[StackTrace::max_depth];
+    for(usize i = 0; i < current.get_depth(); ++i) {
+        addresses[i] = current.get_address(i);
+    }
+    const auto depth = current.get_depth();
+
+    // Without an index directory, the elements come straight from the debug information
+    StackTrace::set_symbol_index_directory(StringView());
+    const auto reference = symbolize(addresses, depth);
+
+    char directory[] = "/tmp/kstd_symbols_XXXXXX";
+    ASSERT_NE(mkdtemp(directory), nullptr);
+    const StringView directory_view(directory, strlen(directory));
+    StackTrace::set_symbol_index_directory(directory_view);
+    assert_same_elements(reference, symbolize(addresses, depth));
+    const auto path = find_index(directory);
+    ASSERT_FALSE(path.is_empty());
+    const auto written = get_status(path);
+
+    // A fresh session maps the index instead of writing it again
+    StackTrace::set_symbol_index_directory(directory_view);
+    assert_same_elements(reference, symbolize(addresses, depth));
+    ASSERT_EQ(get_status(path).st_ino, written.st_ino);
+
+    // An index of a different build is rejected and replaced
+    auto fd = open(path.c_str(), O_RDWR);
+    ASSERT_GE(fd, 0);
+    u8 build_id_byte = 0;
+    ASSERT_EQ(pread(fd, &build_id_byte, 1, build_id_offset), 1);
+    const u8 wrong_byte = build_id_byte ^ 0xFF;
+    ASSERT_EQ(pwrite(fd, &wrong_byte, 1, build_id_offset), 1);
+    close(fd);
+    StackTrace::set_symbol_index_directory(directory_view);
+    assert_same_elements(reference, symbolize(addresses, depth));
+    const auto replaced = get_status(path);
+    ASSERT_NE(replaced.st_ino, written.st_ino);
+    fd = open(path.c_str(), O_RDONLY);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(pread(fd, &build_id_byte, 1, build_id_offset), 1);
+    close(fd);
+    ASSERT_NE(build_id_byte, wrong_byte);
+
+    // So is a truncated index
+    ASSERT_EQ(truncate(path.c_str(), written.st_size / 2), 0);
+    StackTrace::set_symbol_index_directory(directory_view);
+    assert_same_elements(reference, symbolize(addresses, depth));
+    const auto restored = get_status(path);
+    ASSERT_NE(restored.st_ino, replaced.st_ino);
+    ASSERT_EQ(restored.st_size, written.st_size);
+
+    unlink(path.c_str());
+    rmdir(directory);
+    StackTrace::set_symbol_index_directory(StringView());
+}
+
+#endif//KSTD_PLATFORM_UNIX
\ No newline at end of file
@@ -0,0 +1,148 @@
+// Copyright 2024 Karma Krafts & associates
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <gtest/gtest.h>
+#include <kstd/CPU.hpp>
+#include <kstd/System.hpp>
+
+// NOLINTBEGIN
+#ifdef KSTD_PLATFORM_UNIX
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+// NOLINTEND
+
+using namespace kstd;
+
+namespace {
+    template<typename T>
+    auto test_lengths() -> void {
+        alignas(64) T buffer[256];
+        for(usize offset = 0; offset < 40; ++offset) {
+            for(usize length = 0; length < 150; ++length) {
+                for(usize i = 0; i < 256; ++i) {
+                    buffer[i] = static_cast<T>(i < offset ? 0 : 'a' + (i % 26));
+                }
+                buffer[offset + length] = 0;
+                ASSERT_EQ(system::get_string_length(buffer + offset), length) << offset << " " << length;
+            }
+        }
+    }
+
+    template<typename T>
+    auto test_compare() -> void {
+        alignas(64) T lhs[128];
+        alignas(64) T rhs[128];
+        for(usize offset = 0; offset < 20; ++offset) {
+            for(usize length = 0; length < 90; ++length) {
+                for(usize i = 0; i < 128; ++i) {
+                    lhs[i] = static_cast<T>('a' + (i % 26));
+                    rhs[i] = lhs[i];
+                }
+                lhs[length] = 0;
+                rhs[length + offset] = 0;
+                const auto* a = lhs;
+                const auto* b = rhs + offset;
+                // Same content, rhs is shifted so the two pointers have different alignment
+                for(usize i = 0; i < length + 1; ++i) {
+                    rhs[offset + i] = lhs[i];
+                }
+                ASSERT_EQ(system::compare_string(a, b), 0);
+                if(length == 0) {
+                    continue;
+                }
+                rhs[offset + length - 1] = static_cast<T>(lhs[length - 1] + 1);
+                ASSERT_LT(system::compare_string(a, b), 0);
+                ASSERT_GT(system::compare_string(b, a), 0);
+                rhs[offset + length - 1] = lhs[length - 1];
+                rhs[offset + length] = static_cast<T>('z');
+                rhs[offset + length + 1] = 0;
+                ASSERT_LT(system::compare_string(a, b), 0);// Proper prefix orders first
+            }
+        }
+        // Units compare as unsigned values
+        const T high[] = {static_cast<T>(-1), 0};
+        const T low[] = {1, 0};
+        ASSERT_GT(system::compare_string(high, low), 0);
+    }
+}// namespace
+
+TEST(kstd_System, test_features) {
+#if defined(KSTD_CPU_X86_FAMILY) && defined(__SSE2__)
+    ASSERT_TRUE(cpu::get_features().has_sse2);
+#endif
+#if defined(KSTD_CPU_X86_FAMILY) && defined(__AVX2__)
+    ASSERT_TRUE(cpu::get_features().has_avx2);
+#endif
+}
+
+TEST(kstd_System, test_string_length) {
+    test_lengths<char>();
+    test_lengths<char8_t>();
+    test_lengths<char16_t>();
+    test_lengths<char32_t>();
+    test_lengths<wchar_t>();
+}
+
+TEST(kstd_System, test_compare_string) {
+    test_compare<char8_t>();
+    test_compare<char16_t>();
+    test_compare<char32_t>();
+}
+
+TEST(kstd_System, test_copy_concat_string) {
+    char16_t buffer[32] = {u'x', u'x', u'x', 0};
+    system::copy_string(buffer, u"Hello");
+    ASSERT_EQ(system::compare_string(buffer, u"Hello"), 0);
+    system::concat_string(buffer, u", World");
+    ASSERT_EQ(system::get_string_length(buffer), 12);
+    ASSERT_EQ(system::compare_string(buffer, u"Hello, World"), 0);
+
+    char32_t wide[4] = {U'a', U'b', U'c', U'd'};
+    system::copy_string(wide, U"");
+    ASSERT_EQ(system::get_string_length(wide), 0);
+}
+
+#ifdef KSTD_PLATFORM_UNIX
+TEST(kstd_System, test_page_boundary) {
+    // Strings which end right before an inaccessible page must not fault
+    const auto page_size = static_cast<usize>(::sysconf(_SC_PAGESIZE));
+    auto* memory = static_cast<u8*>(::mmap(nullptr, page_size * 2, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+    ASSERT_NE(memory, MAP_FAILED);
+    ASSERT_EQ(::mprotect(memory + page_size, page_size, PROT_NONE), 0);
+
+    auto* end16 = reinterpret_cast<char16_t*>(memory + page_size);
+    for(usize length = 0; length < 40; ++length) {
+        auto* start = end16 - length - 1;
+        for(usize i = 0; i < length; ++i) {
+            start[i] = u'a';
+        }
+        start[length] = 0;
+        ASSERT_EQ(system::get_string_length(start), length);
+        ASSERT_EQ(system::compare_string(start, start), 0);
+    }
+
+    auto* end32 = reinterpret_cast<char32_t*>(memory + page_size);
+    for(usize length = 0; length < 40; ++length) {
+        auto* start = end32 - length - 1;
+        for(usize i = 0; i < length; ++i) {
+            start[i] = U'a';
+        }
+        start[length] = 0;
+        ASSERT_EQ(system::get_string_length(start), length);
+        ASSERT_EQ(system::compare_string(start, start), 0);
+    }
+    ::munmap(memory, page_size * 2);
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,151 @@
+// Copyright 2024 Karma Krafts & associates
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <gtest/gtest.h>
+#include <kstd/Unicode.hpp>
+
+using namespace kstd;
+
+namespace {
+    auto is_valid(const char* value) noexcept -> bool {
+        return unicode::is_valid_utf8(value, strlen(value));
+    }
+
+    auto is_valid_at_every_offset(const char* value, const usize padding) noexcept -> bool {
+        // Shift the sequence across block boundaries by prefixing ASCII
+        char buffer[256] {};
+        for(usize i = 0; i < padding; ++i) {
+            buffer[i] = 'x';
+        }
+        strcpy(buffer + padding, value);
+        return unicode::is_valid_utf8(buffer, strlen(buffer));
+    }
+}// namespace
+
+TEST(kstd_Unicode, test_validate_valid) {
+    ASSERT_TRUE(is_valid(""));
+    ASSERT_TRUE(is_valid("Hello, World!"));
+    ASSERT_TRUE(is_valid("\xC3\xA4\xC3\xB6\xC3\xBC"));   // äöü
+    ASSERT_TRUE(is_valid("\xE2\x82\xAC"));               // €
+    ASSERT_TRUE(is_valid("\xF0\x9F\x98\x80"));           // 😀
+    ASSERT_TRUE(is_valid("\xF4\x8F\xBF\xBF"));           // U+10FFFF
+    ASSERT_TRUE(is_valid("\xED\x9F\xBF"));               // U+D7FF
+    ASSERT_TRUE(is_valid("\xEE\x80\x80"));               // U+E000
+}
+
+TEST(kstd_Unicode, test_validate_invalid) {
+    ASSERT_FALSE(is_valid("\x80"));            // Lone continuation
+    ASSERT_FALSE(is_valid("\xC3"));            // Truncated
+    ASSERT_FALSE(is_valid("\xC0\xAF"));        // Overlong 2
+    ASSERT_FALSE(is_valid("\xE0\x80\xAF"));    // Overlong 3
+    ASSERT_FALSE(is_valid("\xF0\x80\x80\xAF"));// Overlong 4
+    ASSERT_FALSE(is_valid("\xED\xA0\x80"));    // Surrogate
+    ASSERT_FALSE(is_valid("\xF4\x90\x80\x80"));// Above U+10FFFF
+    ASSERT_FALSE(is_valid("\xF8\x88\x80\x80\x80"));
+    ASSERT_FALSE(is_valid("\xE2\x82"));
+    ASSERT_FALSE(is_valid("\xE2\x82\xAC\xAC"));
+}
+
+TEST(kstd_Unicode, test_validate_block_boundaries) {
+    const char* valid[] = {"\xC3\xA4", "\xE2\x82\xAC", "\xF0\x9F\x98\x80"};
+    const char* invalid[] = {"\xC3", "\xE2\x82", "\xF0\x9F\x98", "\xED\xA0\x80", "\xC0\xAF", "\x80"};
+    for(usize padding = 0; padding < 70; ++padding) {
+        for(const auto* value : valid) {
+            ASSERT_TRUE(is_valid_at_every_offset(value, padding)) << padding;
+        }
+        for(const auto* value : invalid) {
+            ASSERT_FALSE(is_valid_at_every_offset(value, padding)) << padding;
+        }
+    }
+}
+
+TEST(kstd_Unicode, test_validate_against_scalar) {
+    // Compare the block validator against the scalar decoder on pseudo-random input
+    u64 state = 0x12345678;
+    u8 buffer[100];
+    for(usize round = 0; round < 20000; ++round) {
+        for(auto& byte : buffer) {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            const auto value = static_cast<u8>(state >> 56);
+            // Bias towards ASCII and lead bytes so valid sequences appear
+            byte = (value & 1) != 0 ? static_cast<u8>(value >> 1) : value;
+        }
+        const auto size = static_cast<usize>(state >> 33) % sizeof(buffer);
+        bool expected = true;
+        usize index = 0;
+        while(index < size) {
+            char32_t code_point = 0;
+            const auto length = unicode::decode_utf8(buffer + index, size - index, code_point);
+            if(length == 0) {
+                expected = false;
+                break;
+            }
+            index += length;
+        }
+        ASSERT_EQ(unicode::is_valid_utf8(buffer, size), expected);
+    }
+}
+
+TEST(kstd_Unicode, test_count_code_points) {
+    const auto value = StringViewUTF8(u8"aä€\U0001F600 and some more ascii text to fill a vector", 49);
+    ASSERT_EQ(unicode::count_code_points(value), 43);
+    const auto value16 = StringViewUTF16(u"aä€\U0001F600", 5);
+    ASSERT_EQ(unicode::count_code_points(value16), 4);
+}
+
+TEST(kstd_Unicode, test_transcode) {
+    const char8_t source[] = u8"Hello, this is a longer ASCII prefix! ä€\U0001F600 end";
+    const auto source_view = StringViewUTF8(source, sizeof(source) - 1);
+
+    Array<char16_t> utf16 {};
+    ASSERT_TRUE(unicode::transcode(source_view, utf16));
+    const char16_t expected16[] = u"Hello, this is a longer ASCII prefix! ä€\U0001F600 end";
+    ASSERT_EQ(utf16.size(), sizeof(expected16) / sizeof(char16_t) - 1);
+    ASSERT_EQ(memcmp(utf16.data(), expected16, utf16.size() * sizeof(char16_t)), 0);
+
+    Array<char32_t> utf32 {};
+    ASSERT_TRUE(unicode::transcode(StringViewUTF16(utf16.data(), utf16.size()), utf32));
+    const char32_t expected32[] = U"Hello, this is a longer ASCII prefix! ä€\U0001F600 end";
+    ASSERT_EQ(utf32.size(), sizeof(expected32) / sizeof(char32_t) - 1);
+    ASSERT_EQ(memcmp(utf32.data(), expected32, utf32.size() * sizeof(char32_t)), 0);
+
+    Array<char8_t> utf8 {};
+    ASSERT_TRUE(unicode::transcode(StringViewUTF32(utf32.data(), utf32.size()), utf8));
+    ASSERT_EQ(utf8.size(), source_view.length());
+    ASSERT_EQ(memcmp(utf8.data(), source, utf8.size()), 0);
+}
+
+TEST(kstd_Unicode, test_transcode_invalid) {
+    const char source[] = "abc\xC0\xAF";
+    char16_t buffer[8];
+    const auto result = unicode::transcode(source, sizeof(source) - 1, buffer, 8);
+    ASSERT_FALSE(result.is_valid);
+    ASSERT_EQ(result.read, 3);
+    ASSERT_EQ(result.written, 3);
+
+    const char16_t lone[] = {u'a', 0xD800, u'b'};
+    char8_t utf8[8];
+    const auto lone_result = unicode::transcode(lone, 3, utf8, 8);
+    ASSERT_FALSE(lone_result.is_valid);
+    ASSERT_EQ(lone_result.read, 1);
+}
+
+TEST(kstd_Unicode, test_transcode_capacity) {
+    const char32_t source[] = U"a\U0001F600";
+    char16_t buffer[2];
+    const auto result = unicode::transcode(source, 2, buffer, 2);
+    ASSERT_TRUE(result.is_valid);
+    ASSERT_EQ(result.read, 1);
+    ASSERT_EQ(result.written, 1);
+}
\ No newline at end of file